@@ -37,14 +37,14 @@ int main() {
 
     // Create some actors
     auto warrior = manager.createActor<Actor>("Warrior");
-    warrior->setPrimaryStat("strength", 20);
-    warrior->setPrimaryStat("vitality", 18);
-    warrior->setPrimaryStat("agility", 12);
+    warrior->setPrimaryStat(PrimaryStat::Strength, 20);
+    warrior->setPrimaryStat(PrimaryStat::Vitality, 18);
+    warrior->setPrimaryStat(PrimaryStat::Agility, 12);
 
     auto mage = manager.createActor<Actor>("Mage");
-    mage->setPrimaryStat("intelligence", 22);
-    mage->setPrimaryStat("wisdom", 18);
-    mage->setPrimaryStat("vitality", 8);
+    mage->setPrimaryStat(PrimaryStat::Intelligence, 22);
+    mage->setPrimaryStat(PrimaryStat::Wisdom, 18);
+    mage->setPrimaryStat(PrimaryStat::Vitality, 8);
 
     // Print initial stats
     printActorStats(*warrior);
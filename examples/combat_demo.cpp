@@ -2,6 +2,7 @@
 #include "actors/ActorManager.hpp"
 #include "combat/CombatSystem.hpp"
 #include "core/EventBus.hpp"
+#include "skills/SkillDatabase.hpp"
 #include <iostream>
 #include <iomanip>
 
@@ -66,24 +67,28 @@ int main() {
     EventBus events;
     CombatSystem combat(actors, events);
 
+    // Skill effects from the built-in skills
+    SkillDatabase::instance().loadDefaultSkills();
+    combat.getSkillExecutor().setEffects(CompiledSkillEffects::compile(SkillDatabase::instance()));
+
     // Create event logger
     CombatLogger logger(events, actors);
 
     // Create actors
     auto warrior = actors.createActor<Actor>("Warrior");
-    warrior->setPrimaryStat("strength", 25);
-    warrior->setPrimaryStat("vitality", 20);
-    warrior->setPrimaryStat("agility", 10);
+    warrior->setPrimaryStat(PrimaryStat::Strength, 25);
+    warrior->setPrimaryStat(PrimaryStat::Vitality, 20);
+    warrior->setPrimaryStat(PrimaryStat::Agility, 10);
 
     auto mage = actors.createActor<Actor>("Mage");
-    mage->setPrimaryStat("intelligence", 25);
-    mage->setPrimaryStat("wisdom", 20);
-    mage->setPrimaryStat("vitality", 8);
+    mage->setPrimaryStat(PrimaryStat::Intelligence, 25);
+    mage->setPrimaryStat(PrimaryStat::Wisdom, 20);
+    mage->setPrimaryStat(PrimaryStat::Vitality, 8);
 
     auto rogue = actors.createActor<Actor>("Rogue");
-    rogue->setPrimaryStat("agility", 25);
-    rogue->setPrimaryStat("luck", 20);
-    rogue->setPrimaryStat("strength", 15);
+    rogue->setPrimaryStat(PrimaryStat::Agility, 25);
+    rogue->setPrimaryStat(PrimaryStat::Luck, 20);
+    rogue->setPrimaryStat(PrimaryStat::Strength, 15);
 
     // Print initial stats
     std::cout << "\n--- Initial Status ---" << std::endl;
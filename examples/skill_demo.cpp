@@ -1,6 +1,6 @@
 #include "actors/Character.hpp"
 #include "actors/ActorManager.hpp"
-#include "skills/SkillTree.hpp"
+#include "skills/CompiledSkillTree.hpp"
 #include <iostream>
 #include <iomanip>
 
@@ -39,23 +39,8 @@ int main() {
     // Load default skills
     SkillDatabase::instance().loadDefaultSkills();
 
-    // Build skill tree
-    SkillTree tree;
-
-    // Tier 1 skills (no prerequisites)
-    tree.addNode({1, {}, {4}, 1, 0.0f, 0.0f});      // Slash -> unlocks Power Strike
-    tree.addNode({2, {}, {5}, 1, 1.0f, 0.0f});      // Fireball -> unlocks Flame Wave
-    tree.addNode({3, {}, {6}, 1, 2.0f, 0.0f});      // Heal -> unlocks Regeneration
-
-    // Tier 2 skills
-    tree.addNode({4, {1}, {7}, 2, 0.0f, 1.0f});     // Power Strike
-    tree.addNode({5, {2}, {8}, 2, 1.0f, 1.0f});     // Flame Wave
-    tree.addNode({6, {3}, {9}, 2, 2.0f, 1.0f});     // Regeneration
-
-    // Tier 3 skills (ultimate)
-    tree.addNode({7, {4}, {}, 3, 0.0f, 2.0f});      // Berserk
-    tree.addNode({8, {5}, {}, 3, 1.0f, 2.0f});      // Meteor
-    tree.addNode({9, {6}, {}, 3, 2.0f, 2.0f});      // Divine Shield
+    // The default skill tree comes with them
+    SkillTree tree = SkillDatabase::instance().buildTree();
 
     // Print all available skills
     std::cout << "\n--- Available Skills in Database ---" << std::endl;
@@ -70,9 +55,9 @@ int main() {
     // Create a character
     ActorManager actors;
     auto hero = actors.createActor<Character>("Hero");
-    hero->setSkillTree(tree);
-    hero->setPrimaryStat("strength", 18);
-    hero->setPrimaryStat("intelligence", 15);
+    hero->setSkillTree(CompiledSkillTree::compile(tree));
+    hero->setPrimaryStat(PrimaryStat::Strength, 18);
+    hero->setPrimaryStat(PrimaryStat::Intelligence, 15);
 
     std::cout << "\n--- Character Created ---" << std::endl;
     std::cout << "Name: " << hero->getName() << std::endl;
@@ -1,107 +1,167 @@
 #include "Actor.hpp"
+#include "../core/EventBus.hpp"
+#include "../core/Logger.hpp"
 #include <algorithm>
-#include <iostream>
 
 namespace mmorpg {
 
+namespace {
+thread_local Actor::Placement* currentPlacement = nullptr;
+}
+
+Actor::Placement::Placement(ActorComponents& store, ActorComponents::Row row, ActorId id)
+    : store_(store)
+    , row_(row)
+    , id_(id)
+    , previous_(currentPlacement) {
+    currentPlacement = this;
+}
+
+Actor::Placement::~Placement() {
+    currentPlacement = previous_;
+}
+
 Actor::Actor(ActorId id, std::string name)
     : id_(id)
     , name_(std::move(name)) {
+    if (currentPlacement && currentPlacement->id_ == id_) {
+        components_ = &currentPlacement->store_;
+        row_ = currentPlacement->row_;
+        currentPlacement->id_ = INVALID_ACTOR_ID;  // One actor per placement
+    } else {
+        ownComponents_ = std::make_unique<ActorComponents>();
+        components_ = ownComponents_.get();
+    }
+    components_->activate(row_, id_);
     recalculateDerivedStats();
     // Initialize runtime stats to max
-    runtimeStats_.currentHp = derivedStats_.maxHp;
-    runtimeStats_.currentMp = derivedStats_.maxMp;
+    setHp(getDerivedStats().maxHp);
+    setMp(getDerivedStats().maxMp);
+    // Spawning is not a change to replicate
+    components_->clearDirty(row_);
 }
 
-void Actor::setPrimaryStat(const std::string& stat, int32_t value) {
-    if (stat == "strength") primaryStats_.strength = value;
-    else if (stat == "agility") primaryStats_.agility = value;
-    else if (stat == "intelligence") primaryStats_.intelligence = value;
-    else if (stat == "vitality") primaryStats_.vitality = value;
-    else if (stat == "wisdom") primaryStats_.wisdom = value;
-    else if (stat == "luck") primaryStats_.luck = value;
+void Actor::detach() {
+    if (ownComponents_) return;
 
-    recalculateDerivedStats();
+    auto own = std::make_unique<ActorComponents>();
+    own->copyRow(0, *components_, row_);
+    components_->deactivate(row_);
+
+    ownComponents_ = std::move(own);
+    components_ = ownComponents_.get();
+    row_ = 0;
 }
 
-void Actor::modifyPrimaryStat(const std::string& stat, int32_t delta) {
-    if (stat == "strength") primaryStats_.strength += delta;
-    else if (stat == "agility") primaryStats_.agility += delta;
-    else if (stat == "intelligence") primaryStats_.intelligence += delta;
-    else if (stat == "vitality") primaryStats_.vitality += delta;
-    else if (stat == "wisdom") primaryStats_.wisdom += delta;
-    else if (stat == "luck") primaryStats_.luck += delta;
+void Actor::queueEvent(const GameEvent& event) {
+    if (isAttached()) {
+        components_->queueEvent(event);
+    } else if (EventBusPtr bus = eventBus_.lock()) {
+        bus->queue(event);
+    }
+}
 
-    recalculateDerivedStats();
+void Actor::setHp(int32_t hp) {
+    components_->setHp(row_, hp);
 }
 
-void Actor::recalculateDerivedStats() {
-    int32_t oldMaxHp = derivedStats_.maxHp;
-    int32_t oldMaxMp = derivedStats_.maxMp;
+void Actor::setMp(int32_t mp) {
+    components_->setMp(row_, mp);
+}
+
+void Actor::setPosition(Position position) {
+    components_->position(row_) = position;
+    components_->markDirty(row_);
+}
 
-    derivedStats_ = StatCalculator::calculate(primaryStats_, level_);
+void Actor::setRegen(int32_t hpPerTick, int32_t mpPerTick) {
+    components_->setRegen(row_, hpPerTick, mpPerTick);
+}
 
-    // Adjust current HP/MP proportionally if max changed
-    if (oldMaxHp > 0) {
-        float hpRatio = static_cast<float>(runtimeStats_.currentHp) / oldMaxHp;
-        runtimeStats_.currentHp = static_cast<int32_t>(hpRatio * derivedStats_.maxHp);
-    }
-    if (oldMaxMp > 0) {
-        float mpRatio = static_cast<float>(runtimeStats_.currentMp) / oldMaxMp;
-        runtimeStats_.currentMp = static_cast<int32_t>(mpRatio * derivedStats_.maxMp);
-    }
+void Actor::setPrimaryStat(PrimaryStat stat, int32_t value) {
+    components_->primary(row_)[stat] = value;
+    components_->markStatsDirty(row_, statBit(stat));
+}
+
+void Actor::modifyPrimaryStat(PrimaryStat stat, int32_t delta) {
+    components_->primary(row_)[stat] += delta;
+    components_->markStatsDirty(row_, statBit(stat));
+}
+
+void Actor::recalculateDerivedStats() {
+    // Current HP/MP are scaled to the new maximums when the row is derived
+    components_->markStatsDirty(row_);
 }
 
 int32_t Actor::takeDamage(int32_t amount) {
     if (amount <= 0 || !isAlive()) return 0;
 
-    int32_t actualDamage = std::min(amount, runtimeStats_.currentHp);
-    runtimeStats_.currentHp -= actualDamage;
+    int32_t currentHp = components_->hp(row_);
+    int32_t actualDamage = std::min(amount, currentHp);
+    setHp(currentHp - actualDamage);
 
-    if (runtimeStats_.currentHp <= 0) {
-        runtimeStats_.currentHp = 0;
+    if (!isAlive()) {
         onDeath();
     }
 
     return actualDamage;
 }
 
+int32_t Actor::takeDamage(int32_t amount, bool isPhysical) {
+    if (amount <= 0 || !isAlive()) return 0;
+    return takeDamage(components_->absorbDamage(row_, amount, isPhysical));
+}
+
+void Actor::revive() {
+    if (isAlive()) return;
+
+    const DerivedStats& derived = getDerivedStats();
+    setHp(derived.maxHp);
+    setMp(derived.maxMp);
+    LOG_INFO(name_ << " has been revived");
+}
+
 int32_t Actor::heal(int32_t amount) {
     if (amount <= 0 || !isAlive()) return 0;
 
-    int32_t missingHp = derivedStats_.maxHp - runtimeStats_.currentHp;
+    int32_t currentHp = components_->hp(row_);
+    int32_t missingHp = getDerivedStats().maxHp - currentHp;
     int32_t actualHeal = std::min(amount, missingHp);
-    runtimeStats_.currentHp += actualHeal;
+    setHp(currentHp + actualHeal);
 
     return actualHeal;
 }
 
 bool Actor::useMana(int32_t amount) {
     if (amount <= 0) return true;
-    if (runtimeStats_.currentMp < amount) return false;
+    int32_t currentMp = components_->mp(row_);
+    if (currentMp < amount) return false;
 
-    runtimeStats_.currentMp -= amount;
+    setMp(currentMp - amount);
     return true;
 }
 
 int32_t Actor::restoreMana(int32_t amount) {
     if (amount <= 0) return 0;
 
-    int32_t missingMp = derivedStats_.maxMp - runtimeStats_.currentMp;
+    int32_t currentMp = components_->mp(row_);
+    int32_t missingMp = getDerivedStats().maxMp - currentMp;
     int32_t actualRestore = std::min(amount, missingMp);
-    runtimeStats_.currentMp += actualRestore;
+    setMp(currentMp + actualRestore);
 
     return actualRestore;
 }
 
 float Actor::getHpPercent() const {
-    if (derivedStats_.maxHp == 0) return 0.0f;
-    return static_cast<float>(runtimeStats_.currentHp) / derivedStats_.maxHp;
+    int32_t maxHp = getDerivedStats().maxHp;
+    if (maxHp == 0) return 0.0f;
+    return static_cast<float>(components_->hp(row_)) / maxHp;
 }
 
 float Actor::getMpPercent() const {
-    if (derivedStats_.maxMp == 0) return 0.0f;
-    return static_cast<float>(runtimeStats_.currentMp) / derivedStats_.maxMp;
+    int32_t maxMp = getDerivedStats().maxMp;
+    if (maxMp == 0) return 0.0f;
+    return static_cast<float>(components_->mp(row_)) / maxMp;
 }
 
 void Actor::gainExperience(int64_t exp) {
@@ -112,8 +172,8 @@ void Actor::gainExperience(int64_t exp) {
 }
 
 void Actor::checkLevelUp() {
-    while (experience_ >= StatCalculator::experienceForLevel(level_ + 1)) {
-        level_++;
+    while (experience_ >= StatCalculator::experienceForLevel(getLevel() + 1)) {
+        components_->level(row_)++;
         onLevelUp();
     }
 }
@@ -121,19 +181,18 @@ void Actor::checkLevelUp() {
 void Actor::onLevelUp() {
     // Base implementation: recalculate stats and fully heal
     recalculateDerivedStats();
-    runtimeStats_.currentHp = derivedStats_.maxHp;
-    runtimeStats_.currentMp = derivedStats_.maxMp;
+    setHp(getDerivedStats().maxHp);
+    setMp(getDerivedStats().maxMp);
 
-    std::cout << name_ << " leveled up to " << level_ << "!" << std::endl;
+    LOG_INFO(name_ << " leveled up to " << getLevel() << "!");
 }
 
 void Actor::update(Tick /*currentTick*/) {
-    // Base implementation: natural HP/MP regen could go here
-    // For now, do nothing
+    // Regen and periodic effects run as ActorManager systems
 }
 
 void Actor::onDeath() {
-    std::cout << name_ << " has died!" << std::endl;
+    LOG_INFO(name_ << " has died!");
     // Subclasses can override for custom death behavior
 }
 
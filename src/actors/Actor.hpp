@@ -2,12 +2,19 @@
 
 #include "../core/Types.hpp"
 #include "Stats.hpp"
+#include "ActorComponents.hpp"
 #include <string>
 #include <memory>
 
 namespace mmorpg {
 
-// Base class for all game entities with stats
+// Base class for all game entities with stats.
+// HP/MP, derived stats, regen and position live in an ActorComponents
+// row; the Actor is a facade over it. A standalone actor owns a private
+// one-row store. ActorManager constructs its actors directly on a row of
+// its shared store, and moves the row out to a private store on removal
+// when the actor is still held elsewhere, so an Actor outliving its
+// manager entry keeps its state.
 class Actor : public std::enable_shared_from_this<Actor> {
 public:
     explicit Actor(ActorId id, std::string name);
@@ -22,27 +29,66 @@ public:
     // Accessors
     ActorId getId() const { return id_; }
     const std::string& getName() const { return name_; }
-    int32_t getLevel() const { return level_; }
+    int32_t getLevel() const { return components_->level(row_); }
     int64_t getExperience() const { return experience_; }
 
-    // Stats access
-    const PrimaryStats& getPrimaryStats() const { return primaryStats_; }
-    const DerivedStats& getDerivedStats() const { return derivedStats_; }
-    const RuntimeStats& getRuntimeStats() const { return runtimeStats_; }
-
-    // Stat modification
-    void setPrimaryStat(const std::string& stat, int32_t value);
-    void modifyPrimaryStat(const std::string& stat, int32_t delta);
-    void recalculateDerivedStats();
+    // Stats access (references are invalidated by the next spawn).
+    // Reading derived or runtime stats first applies any pending
+    // recalculation, so callers always see current values.
+    const PrimaryStats& getPrimaryStats() const { return components_->primary(row_); }  // Base values
+    PrimaryStats getEffectivePrimaryStats() const { return components_->effectivePrimary(row_); }
+    const DerivedStats& getDerivedStats() const {
+        components_->resolveStats(row_);
+        return components_->derived(row_);
+    }
+    RuntimeStats getRuntimeStats() const {
+        components_->resolveStats(row_);
+        return {components_->hp(row_), components_->mp(row_)};
+    }
+
+    // Position in the world
+    Position getPosition() const { return components_->position(row_); }
+    void setPosition(Position position);
+
+    // Per-tick regeneration, applied by ActorManager::updateAll while
+    // below the maximums
+    void setRegen(int32_t hpPerTick, int32_t mpPerTick);
+    int32_t getHpRegen() const { return components_->hpRegen(row_); }
+    int32_t getMpRegen() const { return components_->mpRegen(row_); }
+
+    // Repeating HP change on the manager's timers (needs a manager to tick)
+    void addPeriodicEffect(PeriodicEffect effect) { components_->addEffect(row_, effect); }
+
+    // Stat modification (base values)
+    void setPrimaryStat(PrimaryStat stat, int32_t value);
+    void modifyPrimaryStat(PrimaryStat stat, int32_t delta);
+    void recalculateDerivedStats();  // Deferred to the next read or tick
+
+    // Buffs/debuffs on top of the base values. Timed modifiers expire on
+    // the manager's timers, so they need a manager to end.
+    using ModifierId = StatModifierStack::ModifierId;
+    ModifierId addStatModifier(const StatModifier& modifier) { return components_->addModifier(row_, modifier); }
+    bool removeStatModifier(ModifierId id) { return components_->removeModifier(row_, id); }
+    bool removeStatModifiersFrom(uint32_t source) { return components_->removeModifiersFrom(row_, source); }
+    const StatModifierStack& getStatModifiers() const { return components_->modifiers(row_); }
+
+    // Damage shield, used up before HP by takeDamage(amount, isPhysical);
+    // replaces any current one
+    void setShield(const Shield& shield) { components_->setShield(row_, shield); }
+    int32_t getShield() const { return components_->shieldRemaining(row_); }
 
     // Health/Mana operations
     int32_t takeDamage(int32_t amount);  // Returns actual damage taken
+    int32_t takeDamage(int32_t amount, bool isPhysical);  // Shield first; returns HP lost
     int32_t heal(int32_t amount);         // Returns actual healing done
     bool useMana(int32_t amount);         // Returns true if enough mana
     int32_t restoreMana(int32_t amount);  // Returns actual mana restored
 
     // State queries
-    bool isAlive() const { return runtimeStats_.currentHp > 0; }
+    bool isAlive() const { return getRuntimeStats().currentHp > 0; }
+
+    // Back to full HP and MP (no-op while alive)
+    void revive();
     float getHpPercent() const;
     float getMpPercent() const;
 
@@ -50,27 +96,69 @@ public:
     void gainExperience(int64_t exp);
     virtual void onLevelUp();
 
-    // Update (called each game tick)
+    // Per-tick logic (AI, scripts, ...). Only actors in the manager's
+    // update set are called: those registered with setUpdating(true),
+    // and for one tick those woken by wakeAt(). Idle actors cost nothing.
+    // With a job system, actors update concurrently: update() may change
+    // this actor through its own methods and raise events with
+    // queueEvent(), but must not touch other actors or the manager.
     virtual void update(Tick currentTick);
+    void setUpdating(bool updating) { components_->setUpdating(row_, updating); }
+    bool isUpdating() const { return components_->isUpdating(row_); }
+    void wakeAt(Tick tick) { components_->wakeAt(row_, tick); }  // Replaces any earlier wake
 
     // Event bus injection
     void setEventBus(EventBusPtr bus) { eventBus_ = bus; }
 
+    // Queue an event on the bus. A managed actor's events go through the
+    // manager, which queues them on its bus at the end of updateAll in a
+    // fixed order, whichever threads raised them.
+    void queueEvent(const GameEvent& event);
+
+    // While a Placement is alive, the next Actor constructed on this
+    // thread with its id starts on the given row of a shared store
+    // instead of allocating a private one
+    class Placement {
+    public:
+        Placement(ActorComponents& store, ActorComponents::Row row, ActorId id);
+        ~Placement();
+
+        Placement(const Placement&) = delete;
+        Placement& operator=(const Placement&) = delete;
+
+    private:
+        friend class Actor;
+        ActorComponents& store_;
+        ActorComponents::Row row_;
+        ActorId id_;
+        Placement* previous_;
+    };
+
+    // Move this actor's components from a shared store to a private one
+    void detach();
+    bool isAttached() const { return !ownComponents_; }
+
 protected:
     ActorId id_;
     std::string name_;
-    int32_t level_ = 1;
     int64_t experience_ = 0;
 
-    PrimaryStats primaryStats_;
-    DerivedStats derivedStats_;
-    RuntimeStats runtimeStats_;
-
     EventBusWeakPtr eventBus_;
 
+    // Component row (in ownComponents_ unless placed in a shared store)
+    std::unique_ptr<ActorComponents> ownComponents_;
+    ActorComponents* components_ = nullptr;
+    ActorComponents::Row row_ = 0;
+
+    void setHp(int32_t hp);
+    void setMp(int32_t mp);
+
     // Hook for subclasses
     virtual void onDeath();
     void checkLevelUp();
+
+    // Effects ticked by the manager can kill
+    friend class ActorManager;
 };
 
 } // namespace mmorpg
@@ -0,0 +1,619 @@
+#include "ActorComponents.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace mmorpg {
+
+namespace {
+// Pieces per thread in each system pass
+constexpr size_t STATS_GRAIN = 512;
+constexpr size_t REGEN_GRAIN = 2048;
+} // namespace
+
+void ActorComponents::setJobs(JobSystem* jobs) {
+    jobs_ = jobs;
+    buffers_ = std::vector<ThreadBuffer>(jobs ? jobs->getThreadCount() : 0);
+}
+
+void ActorComponents::activate(Row row, ActorId id) {
+    if (row >= active_.size()) {
+        size_t size = row + 1;
+        active_.resize(size, 0);
+        ids_.resize(size, INVALID_ACTOR_ID);
+        primary_.resize(size);
+        level_.resize(size, 1);
+        hp_.resize(size, 0);
+        mp_.resize(size, 0);
+        derived_.resize(size);
+        position_.resize(size);
+        hpRegen_.resize(size, 0);
+        mpRegen_.resize(size, 0);
+        dirty_.resize(size, 0);
+        statsDirty_.resize(size, 0);
+        statsChanged_.resize(size, 0);
+        modifiers_.resize(size);
+        expiryTimer_.resize(size, TimingWheel::INVALID_TIMER);
+        cooldowns_.resize(size);
+        shield_.resize(size);
+        updateMode_.resize(size, 0);
+        wakeTick_.resize(size, 0);
+        wakeTimer_.resize(size, TimingWheel::INVALID_TIMER);
+        regenRows_.slot.resize(size, 0);
+        updateRows_.slot.resize(size, 0);
+    }
+
+    // Reactivating drops whatever the row held, timers included
+    deactivate(row);
+    activeCount_++;
+    active_[row] = 1;
+    ids_[row] = id;
+    primary_[row] = PrimaryStats{};
+    level_[row] = 1;
+    hp_[row] = 0;
+    mp_[row] = 0;
+    derived_[row] = DerivedStats{};
+    position_[row] = Position{};
+    hpRegen_[row] = 0;
+    mpRegen_[row] = 0;
+    dirty_[row] = 0;
+    statsDirty_[row] = STATS_CLEAN;
+    statsChanged_[row] = 0;
+    shield_[row] = Shield{};
+}
+
+void ActorComponents::copyRow(Row row, const ActorComponents& from, Row fromRow) {
+    activate(row, from.ids_[fromRow]);
+    primary_[row] = from.primary_[fromRow];
+    level_[row] = from.level_[fromRow];
+    hp_[row] = from.hp_[fromRow];
+    mp_[row] = from.mp_[fromRow];
+    derived_[row] = from.derived_[fromRow];
+    position_[row] = from.position_[fromRow];
+    hpRegen_[row] = from.hpRegen_[fromRow];
+    mpRegen_[row] = from.mpRegen_[fromRow];
+    wakeRegen(row);
+    modifiers_[row] = from.modifiers_[fromRow];
+    scheduleExpiry(row);
+    if (from.statsDirty_[fromRow] == STATS_PENDING) {
+        markStatsDirty(row, from.statsChanged_[fromRow]);
+    }
+
+    // Timed state restarts on this store's clock with what was left
+    for (const Cooldown& cooldown : from.cooldowns_[fromRow]) {
+        Tick remaining = from.cooldownRemaining(fromRow, cooldown.skill);
+        if (remaining > 0) {
+            startCooldown(row, cooldown.skill, remaining);
+        }
+    }
+    if (from.shieldRemaining(fromRow) > 0) {
+        Shield shield = from.shield_[fromRow];
+        if (shield.expiresAt != 0) {
+            shield.expiresAt = now() + (shield.expiresAt - from.now());
+        }
+        shield_[row] = shield;
+    }
+    for (const ActiveEffect& effect : from.effects_) {
+        if (effect.row == fromRow) {
+            addEffect(row, {effect.hpPerTick, effect.ticksLeft, effect.interval});
+        }
+    }
+    setUpdating(row, from.isUpdating(fromRow));
+    if (from.wakeTick_[fromRow] != 0) {
+        wakeAt(row, from.wakeTick_[fromRow]);
+    }
+}
+
+void ActorComponents::deactivate(Row row) {
+    if (!isActive(row)) return;
+
+    active_[row] = 0;
+    dirty_[row] = 0;
+    statsDirty_[row] = STATS_CLEAN;  // Its queue entry is skipped
+    statsChanged_[row] = 0;
+    modifiers_[row].clear();
+    cancelTimer(expiryTimer_[row]);
+    ids_[row] = INVALID_ACTOR_ID;
+    activeCount_--;
+
+    if (regenRows_.contains(row)) regenRows_.erase(row);
+    if (updateRows_.contains(row)) updateRows_.erase(row);
+    updateMode_[row] = 0;
+    wakeTick_[row] = 0;
+
+    // The row may be reused by the next spawn; its timed state ends here
+    cancelTimer(wakeTimer_[row]);
+    for (Cooldown& cooldown : cooldowns_[row]) {
+        cancelTimer(cooldown.timer);
+    }
+    cooldowns_[row].clear();
+    for (uint32_t slot = 0; slot < effects_.size(); slot++) {
+        if (effects_[slot].row == row) {
+            releaseEffect(slot);
+        }
+    }
+}
+
+void ActorComponents::addEffect(Row row, PeriodicEffect effect) {
+    if (!isActive(row) || effect.ticks == 0 || effect.hpPerTick == 0) return;
+    if (parallel_) {
+        defer(row, DeferredOp::Effect, INVALID_SKILL_ID, effect);
+        return;
+    }
+
+    uint32_t slot;
+    if (!freeEffects_.empty()) {
+        slot = freeEffects_.back();
+        freeEffects_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(effects_.size());
+        effects_.emplace_back();
+    }
+
+    uint32_t interval = effect.interval > 0 ? effect.interval : 1;
+    effects_[slot] = {row, effect.hpPerTick, effect.ticks, interval, TimingWheel::INVALID_TIMER};
+    if (timers_) {
+        effects_[slot].timer = timers_->schedule(interval, [this, slot] { tickEffect(slot); });
+    }
+    effectCount_++;
+}
+
+void ActorComponents::tickEffect(uint32_t slot) {
+    ActiveEffect& effect = effects_[slot];
+    Row row = effect.row;
+    int32_t before = hp_[row];
+    if (before > 0) {
+        int32_t hp = std::clamp(before + effect.hpPerTick, 0, derived_[row].maxHp);
+        hp_[row] = hp;
+        if (hp != before) markDirty(row);
+        if (hp == 0) {
+            killed_.push_back(row);
+        }
+        wakeRegen(row);
+    }
+
+    // Effects on the dead end with them
+    if (--effect.ticksLeft == 0 || hp_[row] == 0) {
+        effect.timer = TimingWheel::INVALID_TIMER;
+        releaseEffect(slot);
+        return;
+    }
+    effect.timer = timers_->schedule(effect.interval, [this, slot] { tickEffect(slot); });
+}
+
+void ActorComponents::releaseEffect(uint32_t slot) {
+    cancelTimer(effects_[slot].timer);
+    effects_[slot].row = NO_ROW;
+    freeEffects_.push_back(slot);
+    effectCount_--;
+}
+
+void ActorComponents::collectKilled(std::vector<Row>& out) {
+    out.insert(out.end(), killed_.begin(), killed_.end());
+    killed_.clear();
+}
+
+void ActorComponents::startCooldown(Row row, SkillId skill, Tick duration) {
+    std::vector<Cooldown>& cooldowns = cooldowns_[row];
+    auto it = std::find_if(cooldowns.begin(), cooldowns.end(),
+                           [skill](const Cooldown& cooldown) { return cooldown.skill == skill; });
+    if (it == cooldowns.end()) {
+        it = cooldowns.insert(cooldowns.end(), {skill, 0, TimingWheel::INVALID_TIMER});
+    }
+    it->readyAt = now() + duration;
+
+    if (parallel_) {
+        defer(row, DeferredOp::Cooldown, skill);
+    } else {
+        scheduleCooldown(row, skill);
+    }
+}
+
+void ActorComponents::scheduleCooldown(Row row, SkillId skill) {
+    for (Cooldown& cooldown : cooldowns_[row]) {
+        if (cooldown.skill == skill) {
+            cancelTimer(cooldown.timer);
+            if (timers_) {
+                cooldown.timer = timers_->scheduleAt(cooldown.readyAt, [this, row, skill] { endCooldown(row, skill); });
+            }
+            return;
+        }
+    }
+}
+
+Tick ActorComponents::cooldownRemaining(Row row, SkillId skill) const {
+    for (const Cooldown& cooldown : cooldowns_[row]) {
+        if (cooldown.skill == skill) {
+            return cooldown.readyAt > now() ? cooldown.readyAt - now() : 0;
+        }
+    }
+    return 0;
+}
+
+void ActorComponents::endCooldown(Row row, SkillId skill) {
+    std::vector<Cooldown>& cooldowns = cooldowns_[row];
+    for (size_t i = 0; i < cooldowns.size(); i++) {
+        if (cooldowns[i].skill == skill) {
+            cooldowns[i] = cooldowns.back();
+            cooldowns.pop_back();
+            return;
+        }
+    }
+}
+
+int32_t ActorComponents::shieldRemaining(Row row) const {
+    const Shield& shield = shield_[row];
+    if (shield.expiresAt != 0 && now() >= shield.expiresAt) return 0;
+    return shield.amount;
+}
+
+int32_t ActorComponents::absorbDamage(Row row, int32_t damage, bool isPhysical) {
+    Shield& shield = shield_[row];
+    if (!(isPhysical ? shield.absorbsPhysical : shield.absorbsMagical)) return damage;
+    int32_t absorbed = std::min(std::max(damage, 0), shieldRemaining(row));
+    shield.amount -= absorbed;
+    return damage - absorbed;
+}
+
+void ActorComponents::cancelTimer(TimerId& timer) {
+    if (timer != TimingWheel::INVALID_TIMER && timers_) {
+        timers_->cancel(timer);
+    }
+    timer = TimingWheel::INVALID_TIMER;
+}
+
+ActorComponents::ModifierId ActorComponents::addModifier(Row row, const StatModifier& modifier) {
+    ModifierId id = StatModifierStack::nextId();
+    modifiers_[row].add(id, modifier);
+    if (modifier.expiresAt != 0) {
+        scheduleExpiry(row);
+    }
+    markStatsDirty(row, statBit(modifier.stat));
+    return id;
+}
+
+bool ActorComponents::removeModifier(Row row, ModifierId id) {
+    uint32_t changed = modifiers_[row].remove(id);
+    if (changed == 0) return false;
+    markStatsDirty(row, changed);
+    return true;
+}
+
+bool ActorComponents::removeModifiersFrom(Row row, uint32_t source) {
+    uint32_t changed = modifiers_[row].removeBySource(source);
+    if (changed == 0) return false;
+    markStatsDirty(row, changed);
+    return true;
+}
+
+void ActorComponents::scheduleExpiry(Row row) {
+    if (!timers_) return;
+    if (parallel_) {
+        defer(row, DeferredOp::Expiry);
+        return;
+    }
+
+    Tick next = modifiers_[row].getNextExpiry();
+    TimerId& timer = expiryTimer_[row];
+    if (next == StatModifierStack::NEVER) {
+        cancelTimer(timer);
+        return;
+    }
+
+    // An earlier timer than needed just finds nothing to drop and moves on
+    Tick due = std::max(next, timers_->getCurrentTick() + 1);
+    if (timers_->isPending(timer) && timers_->getExpiry(timer) <= due) return;
+
+    cancelTimer(timer);
+    timer = timers_->scheduleAt(due, [this, row] { expireModifiers(row); });
+}
+
+void ActorComponents::expireModifiers(Row row) {
+    expiryTimer_[row] = TimingWheel::INVALID_TIMER;
+    uint32_t changed = modifiers_[row].expire(timers_->getCurrentTick());
+    if (changed != 0) {
+        markStatsDirty(row, changed);
+    }
+    scheduleExpiry(row);
+}
+
+void ActorComponents::markStatsDirty(Row row, uint32_t changed) {
+    if (statsDirty_[row] == STATS_CLEAN) {
+        if (parallel_) {
+            defer(row, DeferredOp::StatsQueue);
+        } else {
+            statsDirtyRows_.push_back(row);
+        }
+    }
+    if (statsDirty_[row] != STATS_PENDING) {
+        statsChanged_[row] = 0;
+    }
+    statsDirty_[row] = STATS_PENDING;
+    statsChanged_[row] |= changed;
+}
+
+void ActorComponents::recalculateRow(Row row) {
+    // Only the fields that read a changed stat
+    DerivedStats derived = derived_[row];
+    StatCalculator::calculateFields(effectivePrimary(row), level_[row],
+                                    StatCalculator::affectedFields(statsChanged_[row]), derived);
+    applyDerived(row, derived);
+    statsDirty_[row] = STATS_RESOLVED;
+    statsChanged_[row] = 0;
+}
+
+void ActorComponents::applyDerived(Row row, const DerivedStats& derived) {
+    int32_t oldMaxHp = derived_[row].maxHp;
+    int32_t oldMaxMp = derived_[row].maxMp;
+    derived_[row] = derived;
+
+    // Keep current HP/MP at the same fraction of the new maximums
+    int32_t hp = hp_[row];
+    int32_t mp = mp_[row];
+    if (oldMaxHp > 0) {
+        float hpRatio = static_cast<float>(hp) / oldMaxHp;
+        hp = static_cast<int32_t>(hpRatio * derived.maxHp);
+    }
+    if (oldMaxMp > 0) {
+        float mpRatio = static_cast<float>(mp) / oldMaxMp;
+        mp = static_cast<int32_t>(mpRatio * derived.maxMp);
+    }
+    if (hp != hp_[row] || mp != mp_[row]) markDirty(row);
+    hp_[row] = hp;
+    mp_[row] = mp;
+    wakeRegen(row);  // The maximums may have grown
+}
+
+void ActorComponents::recalculateStats() {
+    // Gather the rows still pending (resolved or removed ones are skipped)
+    batchPrimary_.clear();
+    batchLevels_.clear();
+    size_t pending = 0;
+    for (Row row : statsDirtyRows_) {
+        if (statsDirty_[row] == STATS_PENDING) {
+            statsDirtyRows_[pending++] = row;
+            batchPrimary_.push_back(effectivePrimary(row));
+            batchLevels_.push_back(level_[row]);
+        }
+        statsDirty_[row] = STATS_CLEAN;
+        statsChanged_[row] = 0;
+    }
+    statsDirtyRows_.resize(pending);
+
+    // Derive in SIMD batches per piece, then scale each row's HP/MP
+    batchDerived_.resize(pending);
+    auto derive = [this](size_t begin, size_t end) {
+        StatCalculator::calculateBatch(batchPrimary_.data() + begin, batchLevels_.data() + begin,
+                                       batchDerived_.data() + begin, end - begin);
+    };
+    if (jobs_) {
+        jobs_->parallelFor(0, pending, STATS_GRAIN, derive);
+    } else {
+        derive(0, pending);
+    }
+    forEachParallel(pending, STATS_GRAIN, [this](size_t i) {
+        applyDerived(statsDirtyRows_[i], batchDerived_[i]);
+    });
+    statsDirtyRows_.clear();
+}
+
+void ActorComponents::regenerate() {
+    // Rows are independent, so they regenerate in parallel; the set is
+    // compacted afterwards
+    const std::vector<Row>& rows = regenRows_.rows;
+    regenKeep_.resize(rows.size());
+    auto apply = [this, &rows](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            Row row = rows[i];
+            if (hp_[row] <= 0) {
+                regenKeep_[i] = 0;  // Died since it was queued
+                continue;
+            }
+
+            // Drains stop at zero; one that empties HP kills
+            int32_t hp = std::clamp(hp_[row] + hpRegen_[row], 0, derived_[row].maxHp);
+            int32_t mp = std::clamp(mp_[row] + mpRegen_[row], 0, derived_[row].maxMp);
+            uint8_t changed = hp != hp_[row] || mp != mp_[row] ? REGEN_CHANGED : 0;
+            hp_[row] = hp;
+            mp_[row] = mp;
+            regenKeep_[i] = changed | (hp == 0 ? REGEN_KILLED : 0) | (needsRegen(row) ? REGEN_KEEP : 0);
+        }
+    };
+    if (jobs_) {
+        jobs_->parallelFor(0, rows.size(), REGEN_GRAIN, apply);
+    } else {
+        apply(0, rows.size());
+    }
+
+    // Changed and killed rows are listed in set order, here rather than
+    // by the pieces, which run on other threads
+    for (size_t i = 0; i < rows.size(); i++) {
+        if (regenKeep_[i] & REGEN_CHANGED) markDirty(rows[i]);
+        if (regenKeep_[i] & REGEN_KILLED) killed_.push_back(rows[i]);
+    }
+
+    // Erasing moves the last row into position i; walking backwards,
+    // that row has already been kept
+    for (size_t i = rows.size(); i-- > 0;) {
+        if (!(regenKeep_[i] & REGEN_KEEP)) {
+            regenRows_.erase(rows[i]);
+        }
+    }
+}
+
+bool ActorComponents::needsRegen(Row row) const {
+    // Only the living; negative regen (a drain) applies until death
+    if (hp_[row] <= 0) return false;
+    return hpRegen_[row] < 0 || mpRegen_[row] < 0 ||
+           (hpRegen_[row] > 0 && hp_[row] < derived_[row].maxHp) ||
+           (mpRegen_[row] > 0 && mp_[row] < derived_[row].maxMp);
+}
+
+void ActorComponents::setHp(Row row, int32_t hp) {
+    if (hp_[row] == hp) return;
+    hp_[row] = hp;
+    markDirty(row);
+    wakeRegen(row);
+}
+
+void ActorComponents::setMp(Row row, int32_t mp) {
+    if (mp_[row] == mp) return;
+    mp_[row] = mp;
+    markDirty(row);
+    wakeRegen(row);
+}
+
+void ActorComponents::setRegen(Row row, int32_t hpPerTick, int32_t mpPerTick) {
+    hpRegen_[row] = hpPerTick;
+    mpRegen_[row] = mpPerTick;
+    // (Left for regenerate() to drop during a parallel pass)
+    if (!parallel_ && regenRows_.contains(row) && !needsRegen(row)) {
+        regenRows_.erase(row);
+    }
+    wakeRegen(row);
+}
+
+void ActorComponents::setUpdating(Row row, bool updating) {
+    uint8_t mode = updating ? (updateMode_[row] | UPDATE_ALWAYS)
+                            : (updateMode_[row] & ~UPDATE_ALWAYS);
+    updateMode_[row] = mode;
+    if ((mode != 0) == updateRows_.contains(row)) return;
+    if (parallel_) {
+        defer(row, DeferredOp::UpdateSet);
+    } else {
+        syncUpdateSet(row);
+    }
+}
+
+void ActorComponents::syncUpdateSet(Row row) {
+    if (updateMode_[row] != 0 && !updateRows_.contains(row)) {
+        updateRows_.insert(row);
+    } else if (updateMode_[row] == 0 && updateRows_.contains(row)) {
+        updateRows_.erase(row);
+    }
+}
+
+void ActorComponents::wakeAt(Row row, Tick tick) {
+    wakeTick_[row] = std::max<Tick>(tick, 1);  // 0 means no wake
+    if (parallel_) {
+        defer(row, DeferredOp::Wake);
+    } else {
+        scheduleWake(row);
+    }
+}
+
+void ActorComponents::scheduleWake(Row row) {
+    cancelTimer(wakeTimer_[row]);
+    if (timers_ && wakeTick_[row] != 0) {
+        wakeTimer_[row] = timers_->scheduleAt(wakeTick_[row], [this, row] { wake(row); });
+    }
+}
+
+void ActorComponents::wake(Row row) {
+    wakeTimer_[row] = TimingWheel::INVALID_TIMER;
+    wakeTick_[row] = 0;
+    updateMode_[row] |= UPDATE_WOKEN;
+    if (!updateRows_.contains(row)) {
+        updateRows_.insert(row);
+    }
+}
+
+void ActorComponents::endWakes() {
+    for (size_t i = 0; i < updateRows_.rows.size();) {
+        Row row = updateRows_.rows[i];
+        updateMode_[row] &= ~UPDATE_WOKEN;
+        if (updateMode_[row] == 0) {
+            updateRows_.erase(row);
+        } else {
+            i++;
+        }
+    }
+}
+
+void ActorComponents::queueEvent(const GameEvent& event) {
+    if (parallel_) {
+        ThreadBuffer& buffer = buffers_[jobs_->currentThread()];
+        buffer.events.emplace_back(buffer.item, event);
+    } else {
+        events_.push_back(event);
+    }
+}
+
+void ActorComponents::defer(Row row, DeferredOp op, SkillId skill, PeriodicEffect effect) {
+    ThreadBuffer& buffer = buffers_[jobs_->currentThread()];
+    buffer.ops.push_back({buffer.item, row, op, skill, effect});
+}
+
+void ActorComponents::endParallel() {
+    parallel_ = false;
+
+    // Each item ran on one thread, in order, so sorting by item (stably)
+    // restores the serial order whichever threads ran what
+    deferred_.clear();
+    deferredEvents_.clear();
+    for (ThreadBuffer& buffer : buffers_) {
+        deferred_.insert(deferred_.end(), buffer.ops.begin(), buffer.ops.end());
+        deferredEvents_.insert(deferredEvents_.end(), std::make_move_iterator(buffer.events.begin()),
+                               std::make_move_iterator(buffer.events.end()));
+        buffer.ops.clear();
+        buffer.events.clear();
+    }
+    auto byItem = [](const auto& a, const auto& b) { return a.item < b.item; };
+    std::stable_sort(deferred_.begin(), deferred_.end(), byItem);
+    std::stable_sort(deferredEvents_.begin(), deferredEvents_.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (const Deferred& deferred : deferred_) {
+        Row row = deferred.row;
+        switch (deferred.op) {
+            case DeferredOp::Regen: wakeRegen(row); break;
+            case DeferredOp::UpdateSet: syncUpdateSet(row); break;
+            case DeferredOp::StatsQueue: statsDirtyRows_.push_back(row); break;
+            case DeferredOp::Expiry: scheduleExpiry(row); break;
+            case DeferredOp::Cooldown: scheduleCooldown(row, deferred.skill); break;
+            case DeferredOp::Wake: scheduleWake(row); break;
+            case DeferredOp::Effect: addEffect(row, deferred.effect); break;
+            case DeferredOp::Dirty: dirtyRows_.push_back(row); break;
+        }
+    }
+    for (auto& [item, event] : deferredEvents_) {
+        events_.push_back(std::move(event));
+    }
+}
+
+void ActorComponents::RowSet::insert(Row row) {
+    rows.push_back(row);
+    slot[row] = static_cast<uint32_t>(rows.size());
+}
+
+void ActorComponents::RowSet::erase(Row row) {
+    uint32_t position = slot[row] - 1;
+    Row last = rows.back();
+    rows[position] = last;
+    slot[last] = position + 1;
+    rows.pop_back();
+    slot[row] = 0;
+}
+
+void ActorComponents::markDirty(Row row) {
+    if (dirty_[row]) return;
+    dirty_[row] = 1;
+    if (parallel_) {
+        defer(row, DeferredOp::Dirty);
+    } else {
+        dirtyRows_.push_back(row);
+    }
+}
+
+void ActorComponents::collectDirty(std::vector<Row>& out) {
+    // A row cleared and marked again is listed twice; its flag is only
+    // up for the first
+    for (Row row : dirtyRows_) {
+        if (dirty_[row]) {
+            out.push_back(row);
+            dirty_[row] = 0;
+        }
+    }
+    dirtyRows_.clear();
+}
+
+} // namespace mmorpg
@@ -0,0 +1,360 @@
+#pragma once
+
+#include "../core/Types.hpp"
+#include "../core/Event.hpp"
+#include "../core/JobSystem.hpp"
+#include "../core/TimingWheel.hpp"
+#include "Stats.hpp"
+#include "StatModifiers.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace mmorpg {
+
+struct Position {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+// HP change applied `ticks` times, every `interval` game ticks (DoT
+// when negative, HoT when positive)
+struct PeriodicEffect {
+    int32_t hpPerTick = 0;
+    uint32_t ticks = 0;
+    uint32_t interval = 1;
+};
+
+// Absorbs damage of the kinds it covers before HP does, until used up
+// or expiresAt (0 = no expiry)
+struct Shield {
+    int32_t amount = 0;
+    bool absorbsPhysical = true;
+    bool absorbsMagical = true;
+    Tick expiresAt = 0;
+};
+
+// Structure-of-arrays storage for the actor state systems touch every
+// tick. Each column is a contiguous array indexed by row; a row is the
+// slot number of the actor's id, so it is stable for the actor's life
+// and slots reused by the slot map keep the arrays compact.
+// Actor keeps its accessors and reads/writes its row here.
+//
+// Timed state (effect ticks, modifier expiry, skill cooldowns, wakeups)
+// runs on a TimingWheel: one timer per effect, stack, cooldown or wake,
+// so nothing is polled per actor. A store without a wheel (an unmanaged
+// actor's) keeps that state but its clock never moves.
+//
+// Per-tick work only visits the rows that have some: regen walks the
+// rows below their maximums, and the update set lists the rows whose
+// actor wants update() calls.
+//
+// With a JobSystem the systems (and the owner's forEachParallel passes)
+// run in pieces across threads. Each item only touches its own row;
+// changes to shared structures (the regen and update sets, the stats
+// queue, timers, the effect pool) and queued events are buffered per
+// thread and applied after the pass in item order, which is the order a
+// single thread would have made them in.
+class ActorComponents {
+public:
+    using Row = uint32_t;
+    using TimerId = TimingWheel::TimerId;
+
+    ActorComponents() = default;
+
+    // Non-copyable (timers capture the store)
+    ActorComponents(const ActorComponents&) = delete;
+    ActorComponents& operator=(const ActorComponents&) = delete;
+
+    // Set before any row is activated; must outlive the store's timers
+    void setTimers(TimingWheel* timers) { timers_ = timers; }
+    TimingWheel* getTimers() const { return timers_; }
+    Tick now() const { return timers_ ? timers_->getCurrentTick() : 0; }
+    uint32_t tickRate() const { return timers_ ? timers_->getTickRate() : TimingWheel::DEFAULT_TICK_RATE; }
+    Tick toTicks(float seconds) const { return TimingWheel::toTicks(seconds, tickRate()); }
+
+    // Threads for the systems (nullptr = the calling thread only); must
+    // outlive the store
+    void setJobs(JobSystem* jobs);
+    JobSystem* getJobs() const { return jobs_; }
+
+    // Call body(i) for every i in [0, count), split across the job
+    // system. body may change row state through this store for its own
+    // row only, and must not activate or deactivate rows.
+    template<typename Body>
+    void forEachParallel(size_t count, size_t grain, Body&& body) {
+        if (!jobs_ || jobs_->getWorkerCount() == 0 || count <= grain) {
+            for (size_t i = 0; i < count; i++) body(i);
+            return;
+        }
+        parallel_ = true;
+        jobs_->parallelFor(0, count, grain, [&](size_t begin, size_t end) {
+            ThreadBuffer& buffer = buffers_[jobs_->currentThread()];
+            for (size_t i = begin; i < end; i++) {
+                buffer.item = i;
+                body(i);
+            }
+        });
+        endParallel();
+    }
+
+    // Claim a row for an actor (grows every column as needed)
+    void activate(Row row, ActorId id);
+    void deactivate(Row row);
+
+    // Activate row with a copy of another store's row
+    void copyRow(Row row, const ActorComponents& from, Row fromRow);
+    bool isActive(Row row) const { return row < active_.size() && active_[row]; }
+
+    // One past the highest row ever used; systems scan [0, rowLimit)
+    size_t rowLimit() const { return active_.size(); }
+    size_t activeCount() const { return activeCount_; }
+    ActorId id(Row row) const { return ids_[row]; }
+
+    // Columns
+    PrimaryStats& primary(Row row) { return primary_[row]; }
+    int32_t& level(Row row) { return level_[row]; }
+    DerivedStats& derived(Row row) { return derived_[row]; }
+    Position& position(Row row) { return position_[row]; }
+    const PrimaryStats& primary(Row row) const { return primary_[row]; }
+    int32_t level(Row row) const { return level_[row]; }
+    int32_t hp(Row row) const { return hp_[row]; }
+    int32_t mp(Row row) const { return mp_[row]; }
+    const DerivedStats& derived(Row row) const { return derived_[row]; }
+    const Position& position(Row row) const { return position_[row]; }
+    int32_t hpRegen(Row row) const { return hpRegen_[row]; }
+    int32_t mpRegen(Row row) const { return mpRegen_[row]; }
+
+    // HP/MP writes mark the row dirty and keep the regen set current
+    void setHp(Row row, int32_t hp);
+    void setMp(Row row, int32_t mp);
+    void setRegen(Row row, int32_t hpPerTick, int32_t mpPerTick);
+    bool isRegenerating(Row row) const { return regenRows_.contains(row); }
+    size_t regeneratingCount() const { return regenRows_.size(); }
+
+    // Base primary stats with the row's modifiers applied
+    PrimaryStats effectivePrimary(Row row) const { return modifiers_[row].apply(primary_[row]); }
+
+    // Stat modifiers. Timed ones are dropped by a timer per row, due at
+    // the stack's next expiry.
+    using ModifierId = StatModifierStack::ModifierId;
+    ModifierId addModifier(Row row, const StatModifier& modifier);
+    bool removeModifier(Row row, ModifierId id);
+    bool removeModifiersFrom(Row row, uint32_t source);
+    const StatModifierStack& modifiers(Row row) const { return modifiers_[row]; }
+
+    // Derived stats are recomputed lazily: a primary stat, modifier or
+    // level change only queues the row with a change mask (statBit /
+    // LEVEL_CHANGED), and recalculateStats() derives every queued row in
+    // one batch. resolveStats() brings a single row up to date first when
+    // something reads it before then, recomputing only the derived fields
+    // that depend on what changed.
+    void markStatsDirty(Row row, uint32_t changed = ALL_STATS_CHANGED);
+    bool isStatsDirty(Row row) const { return statsDirty_[row] == STATS_PENDING; }
+    void resolveStats(Row row) {
+        if (statsDirty_[row] == STATS_PENDING) recalculateRow(row);
+    }
+    size_t pendingStatsCount() const { return statsDirtyRows_.size(); }  // Includes resolved rows
+
+    // Replication: rows whose HP, MP or position changed since the last
+    // collect. A row is listed when its flag goes up, so collecting costs
+    // the changed rows rather than every row.
+    void markDirty(Row row);
+    bool isDirty(Row row) const { return dirty_[row] != 0; }
+    void clearDirty(Row row) { dirty_[row] = 0; }
+
+    // Periodic effects, each ticked by its own timer. Rows they kill are
+    // collected for the owner to run death handling.
+    void addEffect(Row row, PeriodicEffect effect);
+    size_t effectCount() const { return effectCount_; }
+    void collectKilled(std::vector<Row>& out);
+
+    // Damage shield, one per row (a new one replaces it). Expiry is
+    // checked when damage arrives, so shields need no timer.
+    void setShield(Row row, const Shield& shield) { shield_[row] = shield; }
+    int32_t shieldRemaining(Row row) const;  // 0 once used up or expired
+
+    // Use up the shield on damage of a kind; returns the damage left over
+    int32_t absorbDamage(Row row, int32_t damage, bool isPhysical);
+
+    // Skill cooldowns; a timer removes each one when it runs out
+    void startCooldown(Row row, SkillId skill, Tick duration);
+    Tick cooldownRemaining(Row row, SkillId skill) const;  // 0 when ready
+    size_t cooldownCount(Row row) const { return cooldowns_[row].size(); }
+
+    // Update set: rows registered for update() every tick, plus rows
+    // woken by a timer for a single tick
+    void setUpdating(Row row, bool updating);
+    bool isUpdating(Row row) const { return (updateMode_[row] & UPDATE_ALWAYS) != 0; }
+    bool isDueForUpdate(Row row) const { return updateMode_[row] != 0; }
+    void wakeAt(Row row, Tick tick);  // Replaces any earlier request
+    const std::vector<Row>& updateRows() const { return updateRows_.rows; }
+    void endWakes();  // After the update pass: woken rows leave the set
+
+    // Events raised by actors, in the order a serial pass would raise
+    // them; the owner hands them to its EventBus
+    void queueEvent(const GameEvent& event);
+    const std::vector<GameEvent>& events() const { return events_; }
+    void clearEvents() { events_.clear(); }
+
+    // --- Systems (tight loops over the columns) ---
+
+    // Derive stats for every queued row (SIMD batch), scaling current
+    // HP/MP to the new maximums
+    void recalculateStats();
+
+    // Add regen to living actors below their maximums (capped there);
+    // rows leave the regen set once full or dead
+    void regenerate();
+
+    // Append dirty rows to out, in the order they were first marked, and
+    // clear their flags
+    void collectDirty(std::vector<Row>& out);
+
+private:
+    // statsDirty_ states. A resolved row stays in the queue (the next
+    // mark doesn't queue it twice) until recalculateStats() drops it.
+    static constexpr uint8_t STATS_CLEAN = 0;
+    static constexpr uint8_t STATS_PENDING = 1;
+    static constexpr uint8_t STATS_RESOLVED = 2;
+
+    // updateMode_ bits
+    static constexpr uint8_t UPDATE_ALWAYS = 1;
+    static constexpr uint8_t UPDATE_WOKEN = 2;
+
+    // Dense list of rows with O(1) insert/erase (swap with the last);
+    // slot holds each row's position + 1, 0 when absent
+    struct RowSet {
+        std::vector<Row> rows;
+        std::vector<uint32_t> slot;
+
+        bool contains(Row row) const { return slot[row] != 0; }
+        size_t size() const { return rows.size(); }
+        void insert(Row row);
+        void erase(Row row);
+    };
+
+    void recalculateRow(Row row);
+    void applyDerived(Row row, const DerivedStats& derived);
+    bool needsRegen(Row row) const;
+    void wakeRegen(Row row) {
+        if (regenRows_.contains(row) || !needsRegen(row)) return;
+        if (parallel_) {
+            defer(row, DeferredOp::Regen);
+        } else {
+            regenRows_.insert(row);
+        }
+    }
+    void syncUpdateSet(Row row);
+
+    // Timer callbacks
+    void scheduleExpiry(Row row);
+    void expireModifiers(Row row);
+    void tickEffect(uint32_t slot);
+    void endCooldown(Row row, SkillId skill);
+    void wake(Row row);
+
+    void scheduleCooldown(Row row, SkillId skill);
+    void scheduleWake(Row row);
+
+    void releaseEffect(uint32_t slot);
+    void cancelTimer(TimerId& timer);
+
+    // Shared-structure changes made during a parallel pass, replayed by
+    // endParallel() sorted by the pass item that made them
+    enum class DeferredOp : uint8_t {
+        Regen,       // wakeRegen
+        UpdateSet,   // syncUpdateSet
+        StatsQueue,  // Queue for recalculateStats
+        Expiry,      // scheduleExpiry
+        Cooldown,    // scheduleCooldown(skill)
+        Wake,        // scheduleWake
+        Effect,      // addEffect(effect)
+        Dirty,       // List for collectDirty
+    };
+    struct Deferred {
+        size_t item;
+        Row row;
+        DeferredOp op;
+        SkillId skill;
+        PeriodicEffect effect;
+    };
+    struct alignas(64) ThreadBuffer {
+        size_t item = 0;  // Pass item being run on this thread
+        std::vector<Deferred> ops;
+        std::vector<std::pair<size_t, GameEvent>> events;
+    };
+    void defer(Row row, DeferredOp op, SkillId skill = INVALID_SKILL_ID, PeriodicEffect effect = {});
+    void endParallel();
+
+    struct Cooldown {
+        SkillId skill;
+        Tick readyAt;
+        TimerId timer;
+    };
+
+    // A running periodic effect; free slots have row == NO_ROW
+    struct ActiveEffect {
+        Row row;
+        int32_t hpPerTick;
+        uint32_t ticksLeft;
+        uint32_t interval;
+        TimerId timer;
+    };
+    static constexpr Row NO_ROW = UINT32_MAX;
+
+    TimingWheel* timers_ = nullptr;
+    JobSystem* jobs_ = nullptr;
+    bool parallel_ = false;  // Inside forEachParallel
+    std::vector<ThreadBuffer> buffers_;  // One per job system thread
+    std::vector<Deferred> deferred_;     // Merge buffers for endParallel
+    std::vector<std::pair<size_t, GameEvent>> deferredEvents_;
+    std::vector<GameEvent> events_;
+
+    std::vector<uint8_t> active_;
+    std::vector<ActorId> ids_;
+    std::vector<PrimaryStats> primary_;
+    std::vector<int32_t> level_;
+    std::vector<int32_t> hp_;
+    std::vector<int32_t> mp_;
+    std::vector<DerivedStats> derived_;
+    std::vector<Position> position_;
+    std::vector<int32_t> hpRegen_;
+    std::vector<int32_t> mpRegen_;
+    std::vector<uint8_t> dirty_;
+    std::vector<uint8_t> statsDirty_;
+    std::vector<uint32_t> statsChanged_;  // Change mask while pending
+    std::vector<StatModifierStack> modifiers_;
+    std::vector<TimerId> expiryTimer_;  // Due at modifiers_[row].getNextExpiry()
+    std::vector<std::vector<Cooldown>> cooldowns_;
+    std::vector<Shield> shield_;
+    std::vector<uint8_t> updateMode_;
+    std::vector<Tick> wakeTick_;  // Requested wake, 0 = none
+    std::vector<TimerId> wakeTimer_;
+    size_t activeCount_ = 0;
+
+    RowSet regenRows_;
+    RowSet updateRows_;
+
+    // Rows queued for recalculateStats(), plus its gather buffers
+    std::vector<Row> statsDirtyRows_;
+    std::vector<PrimaryStats> batchPrimary_;
+    std::vector<int32_t> batchLevels_;
+    std::vector<DerivedStats> batchDerived_;
+    std::vector<uint8_t> regenKeep_;  // regenerate() scratch: REGEN_* bits
+    static constexpr uint8_t REGEN_KEEP = 1;
+    static constexpr uint8_t REGEN_CHANGED = 2;
+    static constexpr uint8_t REGEN_KILLED = 4;
+
+    // Rows whose dirty flag went up since the last collectDirty(); rows
+    // cleared since (removed, or spawned clean) are skipped there
+    std::vector<Row> dirtyRows_;
+
+    // Effect slots stay put while their timer is pending (the callback
+    // holds the slot number); freed slots are reused
+    std::vector<ActiveEffect> effects_;
+    std::vector<uint32_t> freeEffects_;
+    size_t effectCount_ = 0;
+    std::vector<Row> killed_;
+};
+
+} // namespace mmorpg
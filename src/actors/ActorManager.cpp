@@ -1,33 +1,40 @@
 #include "ActorManager.hpp"
+#include "../core/EventBus.hpp"
+#include "../core/Profiler.hpp"
 
 namespace mmorpg {
 
+ActorManager::ActorManager() {
+    components_.setTimers(&timers_);
+}
+
+ActorManager::~ActorManager() {
+    clear();
+}
+
 ActorPtr ActorManager::getActor(ActorId id) const {
-    auto it = actors_.find(id);
-    if (it == actors_.end()) return nullptr;
-    return it->second;
+    const ActorPtr* actor = actors_.get(id);
+    return actor ? *actor : nullptr;
 }
 
 bool ActorManager::removeActor(ActorId id) {
-    return actors_.erase(id) > 0;
+    ActorPtr* actor = actors_.get(id);
+    if (!actor) return false;
+    release(*actor);
+    return actors_.erase(id);
 }
 
 bool ActorManager::hasActor(ActorId id) const {
-    return actors_.find(id) != actors_.end();
+    return actors_.contains(id);
 }
 
 std::vector<ActorPtr> ActorManager::getAllActors() const {
-    std::vector<ActorPtr> result;
-    result.reserve(actors_.size());
-    for (const auto& [id, actor] : actors_) {
-        result.push_back(actor);
-    }
-    return result;
+    return actors_.values();
 }
 
 std::vector<ActorPtr> ActorManager::getActorsWhere(std::function<bool(const Actor&)> predicate) const {
     std::vector<ActorPtr> result;
-    for (const auto& [id, actor] : actors_) {
+    for (const auto& actor : actors_) {
         if (predicate(*actor)) {
             result.push_back(actor);
         }
@@ -40,13 +47,78 @@ std::vector<ActorPtr> ActorManager::getLivingActors() const {
 }
 
 void ActorManager::updateAll(Tick currentTick) {
-    for (auto& [id, actor] : actors_) {
-        actor->update(currentTick);
+    // Effect ticks, modifier expiry, cooldowns, wakeups, ... due by now
+    {
+        PROFILE_ZONE("actors.timers");
+        timers_.advance(currentTick);
+    }
+
+    EventBusPtr bus = eventBus_.lock();
+    handleDeaths(bus);
+
+    // Stat changes queued since the last tick, derived in one batch
+    {
+        PROFILE_ZONE("actors.stats");
+        components_.recalculateStats();
+    }
+
+    // Only actors with work this tick, from a snapshot of the set
+    {
+        PROFILE_ZONE("actors.update");
+        updating_.assign(components_.updateRows().begin(), components_.updateRows().end());
+        components_.forEachParallel(updating_.size(), UPDATE_GRAIN, [this, currentTick](size_t i) {
+            ActorComponents::Row row = updating_[i];
+            if (!components_.isDueForUpdate(row)) return;
+            if (Actor* actor = findActor(components_.id(row))) {
+                actor->update(currentTick);
+            }
+        });
+        components_.endWakes();
+    }
+
+    {
+        PROFILE_ZONE("actors.regen");
+        components_.regenerate();
+    }
+    handleDeaths(bus);  // Drains can kill
+
+    if (bus) {
+        for (const GameEvent& event : components_.events()) {
+            bus->queue(event);
+        }
+    }
+    components_.clearEvents();
+}
+
+void ActorManager::handleDeaths(const EventBusPtr& bus) {
+    killed_.clear();
+    components_.collectKilled(killed_);
+    for (ActorComponents::Row row : killed_) {
+        ActorId id = components_.id(row);
+        if (Actor* actor = findActor(id)) {
+            actor->onDeath();
+            if (bus) {
+                bus->queue(DeathEvent{id, INVALID_ACTOR_ID});
+            }
+        }
     }
 }
 
 void ActorManager::clear() {
+    for (const auto& actor : actors_) {
+        release(actor);
+    }
     actors_.clear();
 }
 
+void ActorManager::release(const ActorPtr& actor) {
+    // Anyone still holding the actor keeps a private copy of its state;
+    // otherwise it goes with its entry and the row is simply freed
+    if (actor.use_count() > 1) {
+        actor->detach();
+    } else {
+        components_.deactivate(rowOf(actor->getId()));
+    }
+}
+
 } // namespace mmorpg
@@ -1,41 +1,71 @@
 #pragma once
 
 #include "../core/Types.hpp"
+#include "../core/SlotMap.hpp"
 #include "Actor.hpp"
-#include <boost/container/flat_map.hpp>
 #include <vector>
 #include <memory>
 #include <functional>
 
 namespace mmorpg {
 
+// Owns every actor. Storage is a generational slot map: an ActorId is a
+// slot handle, so create/remove/lookup are O(1) and a stale id to a
+// reused slot finds nothing. updateAll() walks a dense array.
+//
+// Per-tick state (HP/MP, derived stats, regen, position) lives in an
+// ActorComponents store whose rows are the slot numbers of the ids;
+// regen and dirty tracking for replication run as loops over its
+// columns. Everything timed (effect ticks, buff expiry, cooldowns, and
+// whatever else callers schedule) runs on the manager's timing wheel.
+// A tick costs time in proportion to the actors with work to do: regen
+// visits only rows below their maximums and update() is only called on
+// the update set, so idle actors are never touched.
+//
+// Given a JobSystem, stat derivation, regen and the update pass run in
+// pieces across its threads; the outcome (state, timers, event order)
+// is the same as on one thread. Timer callbacks stay on the calling
+// thread.
 class ActorManager {
 public:
-    ActorManager() = default;
-    ~ActorManager() = default;
+    ActorManager();
+    ~ActorManager();
 
     // Non-copyable
     ActorManager(const ActorManager&) = delete;
     ActorManager& operator=(const ActorManager&) = delete;
 
     // Factory method to create and register actors
+    // (nullptr once MAX_ACTORS are alive)
     template<typename T, typename... Args>
     std::shared_ptr<T> createActor(Args&&... args) {
-        ActorId id = nextActorId_++;
-        auto actor = std::make_shared<T>(id, std::forward<Args>(args)...);
-        actors_[id] = actor;
+        ActorId id = actors_.nextHandle();
+        if (id == INVALID_ACTOR_ID) return nullptr;
+        std::shared_ptr<T> actor;
+        {
+            Actor::Placement placement(components_, rowOf(id), id);
+            actor = std::make_shared<T>(id, std::forward<Args>(args)...);
+        }
+        actors_.insert(actor);
         return actor;
     }
 
-    // Get actor by ID
+    static constexpr size_t MAX_ACTORS = SlotMap<ActorPtr, ActorId>::MAX_SLOTS;
+
+    // Get actor by ID (shares ownership)
     ActorPtr getActor(ActorId id) const;
 
+    // Non-owning lookup for hot paths; valid until the actor is removed
+    Actor* findActor(ActorId id) const {
+        const ActorPtr* actor = actors_.get(id);
+        return actor ? actor->get() : nullptr;
+    }
+
     // Get actor with type check
     template<typename T>
     std::shared_ptr<T> getActorAs(ActorId id) const {
-        auto it = actors_.find(id);
-        if (it == actors_.end()) return nullptr;
-        return std::dynamic_pointer_cast<T>(it->second);
+        const ActorPtr* actor = actors_.get(id);
+        return actor ? std::dynamic_pointer_cast<T>(*actor) : nullptr;
     }
 
     // Remove actor
@@ -44,7 +74,7 @@ public:
     // Check if actor exists
     bool hasActor(ActorId id) const;
 
-    // Get all actors
+    // Get all actors (in storage order, not by id)
     std::vector<ActorPtr> getAllActors() const;
 
     // Get actors matching a predicate
@@ -53,9 +83,28 @@ public:
     // Get all living actors
     std::vector<ActorPtr> getLivingActors() const;
 
-    // Update all actors
+    // Fire the timers due by currentTick, derive queued stat changes,
+    // update the actors in the update set, run the regen system, then
+    // queue the events actors raised on the bus
     void updateAll(Tick currentTick);
 
+    // Threads for updateAll (nullptr = the calling thread only); must
+    // outlive the manager or be reset first
+    void setJobSystem(JobSystem* jobs) { components_.setJobs(jobs); }
+
+    // Game-tick timers, advanced by updateAll. Callbacks run at the start
+    // of the tick, before actors update.
+    TimingWheel& getTimers() { return timers_; }
+
+    // Component store (read-only; go through Actor to modify)
+    const ActorComponents& getComponents() const { return components_; }
+    static ActorComponents::Row rowOf(ActorId id) {
+        return static_cast<ActorComponents::Row>(id & SlotMap<ActorPtr, ActorId>::INDEX_MASK);
+    }
+
+    // Rows changed since the last call, for replication (clears the flags)
+    void collectDirty(std::vector<ActorComponents::Row>& rows) { components_.collectDirty(rows); }
+
     // Get count
     size_t getActorCount() const { return actors_.size(); }
 
@@ -66,9 +115,21 @@ public:
     void setEventBus(EventBusPtr bus) { eventBus_ = bus; }
 
 private:
-    boost::container::flat_map<ActorId, ActorPtr> actors_;
-    ActorId nextActorId_ = 1;  // 0 is reserved for INVALID_ACTOR_ID
+    // Declared first so they outlive the actors attached to them
+    TimingWheel timers_;
+    ActorComponents components_;
+    SlotMap<ActorPtr, ActorId> actors_;  // Handle 0 is never issued (INVALID_ACTOR_ID)
     EventBusWeakPtr eventBus_;
+    std::vector<ActorComponents::Row> killed_;    // Scratch for updateAll
+    std::vector<ActorComponents::Row> updating_;  // Update set snapshot
+
+    static constexpr size_t UPDATE_GRAIN = 64;  // Actors per piece of the update pass
+
+    // onDeath and a DeathEvent for rows killed by effects or drains
+    void handleDeaths(const EventBusPtr& bus);
+
+    // Take a departing actor's row out of the shared store
+    void release(const ActorPtr& actor);
 };
 
 } // namespace mmorpg
@@ -1,5 +1,5 @@
 #include "Character.hpp"
-#include <iostream>
+#include "../core/Logger.hpp"
 
 namespace mmorpg {
 
@@ -9,23 +9,46 @@ Character::Character(ActorId id, std::string name)
     skillPoints_ = 3;
 }
 
+void Character::setSkillTree(SkillTreePtr tree) {
+    // Carry learned skills over to the new tree's indices
+    CompiledSkillTree::SkillLevels skills;
+    if (tree) {
+        forEachLearnedSkill([&](SkillId id, int32_t level) {
+            CompiledSkillTree::SkillIndex index = tree->indexOf(id);
+            if (index != CompiledSkillTree::NO_INDEX) {
+                skills.learned.set(index);
+                skills.level[index] = static_cast<uint8_t>(level);
+            }
+        });
+        tree->refresh(skills, getLevel());
+    }
+    skills_ = skills;
+    skillTree_ = std::move(tree);
+}
+
+CompiledSkillTree::SkillIndex Character::learnedIndex(SkillId skillId) const {
+    if (!skillTree_) return CompiledSkillTree::NO_INDEX;
+    CompiledSkillTree::SkillIndex index = skillTree_->indexOf(skillId);
+    if (index == CompiledSkillTree::NO_INDEX || !skills_.has(index)) return CompiledSkillTree::NO_INDEX;
+    return index;
+}
+
 bool Character::learnSkill(SkillId skillId) {
     if (!canLearnSkill(skillId)) {
         return false;
     }
 
     // Get skill from database
-    const auto* skill = SkillDatabase::instance().getSkill(skillId);
-    if (!skill) return false;
+    const SkillDatabase& db = SkillDatabase::instance();
+    if (!db.hasSkill(skillId)) return false;
 
     // Spend skill point
     skillPoints_--;
 
     // Learn the skill at level 1
-    learnedSkills_.insert(skillId);
-    skillLevels_[skillId] = 1;
+    skillTree_->learn(skills_, skillTree_->indexOf(skillId));
 
-    std::cout << name_ << " learned " << skill->getName() << "!" << std::endl;
+    LOG_DEBUG(name_ << " learned " << db.getName(skillId) << "!");
     return true;
 }
 
@@ -36,11 +59,12 @@ bool Character::upgradeSkill(SkillId skillId) {
 
     // Spend skill point
     skillPoints_--;
-    skillLevels_[skillId]++;
+    CompiledSkillTree::SkillIndex index = learnedIndex(skillId);
+    skillTree_->upgrade(skills_, index);
+    int32_t level = skills_.level[index];
 
-    const auto* skill = SkillDatabase::instance().getSkill(skillId);
-    std::cout << name_ << " upgraded " << (skill ? skill->getName() : "skill")
-              << " to level " << skillLevels_[skillId] << "!" << std::endl;
+    LOG_DEBUG(name_ << " upgraded " << SkillDatabase::instance().getName(skillId)
+           << " to level " << level << "!");
     return true;
 }
 
@@ -48,11 +72,9 @@ bool Character::canLearnSkill(SkillId skillId) const {
     // Check skill points
     if (skillPoints_ <= 0) return false;
 
-    // Check if already learned
-    if (hasSkill(skillId)) return false;
-
-    // Check skill tree prerequisites
-    return skillTree_.canLearn(skillId, learnedSkills_, skillLevels_, level_);
+    // Not learned and requirements met, kept current as skills and level change
+    if (!skillTree_) return false;
+    return skillTree_->canLearn(skillTree_->indexOf(skillId), skills_);
 }
 
 bool Character::canUpgradeSkill(SkillId skillId) const {
@@ -60,94 +82,90 @@ bool Character::canUpgradeSkill(SkillId skillId) const {
     if (skillPoints_ <= 0) return false;
 
     // Must have learned the skill
-    if (!hasSkill(skillId)) return false;
+    CompiledSkillTree::SkillIndex index = learnedIndex(skillId);
+    if (index == CompiledSkillTree::NO_INDEX) return false;
 
     // Check max level
-    const auto* skill = SkillDatabase::instance().getSkill(skillId);
+    const SkillRecord* skill = SkillDatabase::instance().getRecord(skillId);
     if (!skill) return false;
 
-    auto it = skillLevels_.find(skillId);
-    if (it == skillLevels_.end()) return false;
-
-    return it->second < skill->getMaxLevel();
+    return skills_.level[index] < skill->maxLevel;
 }
 
 int32_t Character::getSkillLevel(SkillId skillId) const {
-    auto it = skillLevels_.find(skillId);
-    if (it == skillLevels_.end()) return 0;
-    return it->second;
+    CompiledSkillTree::SkillIndex index = learnedIndex(skillId);
+    return index == CompiledSkillTree::NO_INDEX ? 0 : skills_.level[index];
 }
 
 bool Character::hasSkill(SkillId skillId) const {
-    return learnedSkills_.count(skillId) > 0;
+    return learnedIndex(skillId) != CompiledSkillTree::NO_INDEX;
+}
+
+std::vector<SkillId> Character::getLearnedSkills() const {
+    std::vector<SkillId> learned;
+    forEachLearnedSkill([&](SkillId id, int32_t) { learned.push_back(id); });
+    return learned;
 }
 
 std::vector<SkillId> Character::getAvailableSkills() const {
-    return skillTree_.getAvailableSkills(learnedSkills_, level_);
+    if (!skillTree_) return {};
+    return skillTree_->getAvailableSkills(skills_);
 }
 
 void Character::onLevelUp() {
     // Call parent implementation
     Actor::onLevelUp();
 
+    // Skills gated on character level may open up
+    if (skillTree_) {
+        skillTree_->setCharacterLevel(skills_, getLevel());
+    }
+
     // Grant skill points
     skillPoints_ += SKILL_POINTS_PER_LEVEL;
-    std::cout << name_ << " gained " << SKILL_POINTS_PER_LEVEL << " skill point(s)!" << std::endl;
+    LOG_DEBUG(name_ << " gained " << SKILL_POINTS_PER_LEVEL << " skill point(s)!");
 }
 
 bool Character::useSkill(SkillId skillId) {
     // Must have the skill
     if (!hasSkill(skillId)) {
-        std::cout << "You haven't learned this skill!" << std::endl;
+        LOG_DEBUG("You haven't learned this skill!");
         return false;
     }
 
-    // Get skill info
-    const auto* skillBase = SkillDatabase::instance().getSkill(skillId);
-    if (!skillBase) return false;
-
-    // Create a copy with our level
-    Skill skill = SkillDatabase::instance().getSkillCopy(skillId);
-    skill.setLevel(getSkillLevel(skillId));
+    // Costs at our level, precomputed by the database
+    const SkillDatabase& db = SkillDatabase::instance();
+    int32_t level = getSkillLevel(skillId);
+    const SkillLevelStats* stats = db.getLevelStats(skillId, level);
+    if (!stats) return false;
 
     // Check cooldown
-    auto cdIt = skillCooldowns_.find(skillId);
-    if (cdIt != skillCooldowns_.end()) {
-        Tick cdRemaining = cdIt->second;
-        if (cdRemaining > lastUpdateTick_) {
-            std::cout << "Skill is on cooldown!" << std::endl;
-            return false;
-        }
+    if (components_->cooldownRemaining(row_, skillId) > 0) {
+        LOG_DEBUG("Skill is on cooldown!");
+        return false;
     }
 
     // Check mana
-    int32_t manaCost = skill.getScaledManaCost();
-    if (!useMana(manaCost)) {
-        std::cout << "Not enough mana! (Need " << manaCost << ")" << std::endl;
+    if (!useMana(stats->manaCost)) {
+        LOG_DEBUG("Not enough mana! (Need " << stats->manaCost << ")");
         return false;
     }
 
-    // Set cooldown
-    Tick cooldownTicks = static_cast<Tick>(skill.getScaledCooldown() * 1000);
-    skillCooldowns_[skillId] = lastUpdateTick_ + cooldownTicks;
+    // Set cooldown (in game ticks; the table's are at the database's rate)
+    Tick cooldownTicks = db.getTickRate() == components_->tickRate() ? stats->cooldownTicks
+                                                                      : components_->toTicks(stats->cooldown);
+    if (cooldownTicks > 0) {
+        components_->startCooldown(row_, skillId, cooldownTicks);
+    }
 
-    std::cout << name_ << " uses " << skill.getName()
-              << " (Level " << skill.getLevel() << ")!" << std::endl;
+    LOG_DEBUG(name_ << " uses " << db.getName(skillId)
+           << " (Level " << level << ")!");
     return true;
 }
 
 float Character::getSkillCooldown(SkillId skillId) const {
-    auto it = skillCooldowns_.find(skillId);
-    if (it == skillCooldowns_.end()) return 0.0f;
-
-    if (it->second <= lastUpdateTick_) return 0.0f;
-
-    return static_cast<float>(it->second - lastUpdateTick_) / 1000.0f;
-}
-
-void Character::update(Tick currentTick) {
-    Actor::update(currentTick);
-    lastUpdateTick_ = currentTick;
+    Tick remaining = components_->cooldownRemaining(row_, skillId);
+    return static_cast<float>(remaining) / components_->tickRate();
 }
 
 } // namespace mmorpg
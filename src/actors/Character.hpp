@@ -1,20 +1,24 @@
 #pragma once
 
 #include "Actor.hpp"
-#include "../skills/SkillTree.hpp"
-#include <unordered_set>
-#include <unordered_map>
+#include "../skills/CompiledSkillTree.hpp"
+#include <vector>
 
 namespace mmorpg {
 
-// Player character with skill tree and progression
+// Player character with skill tree and progression.
+// The tree is shared (every character on it points at the same compiled
+// tree); the character only keeps which of its skills are learned, at
+// what level, and which are available to learn, indexed by the tree's
+// skill index. Availability is updated as skills and the character's
+// level change, so canLearnSkill() is a bit test.
 class Character : public Actor {
 public:
     Character(ActorId id, std::string name);
 
-    // Skill tree access
-    void setSkillTree(const SkillTree& tree) { skillTree_ = tree; }
-    const SkillTree& getSkillTree() const { return skillTree_; }
+    // Skill tree access. Learned skills missing from a new tree are dropped.
+    void setSkillTree(SkillTreePtr tree);
+    const SkillTreePtr& getSkillTree() const { return skillTree_; }
 
     // Skill points management
     int32_t getSkillPoints() const { return skillPoints_; }
@@ -36,8 +40,16 @@ public:
     // Check if skill is learned
     bool hasSkill(SkillId skillId) const;
 
-    // Get all learned skill IDs
-    const std::unordered_set<SkillId>& getLearnedSkills() const { return learnedSkills_; }
+    // Get all learned skill IDs (in tree index order)
+    std::vector<SkillId> getLearnedSkills() const;
+
+    // Call fn(skillId, level) for each learned skill, without allocating
+    template<typename Fn>
+    void forEachLearnedSkill(Fn&& fn) const {
+        skills_.learned.forEach([&](CompiledSkillTree::SkillIndex index) {
+            fn(skillTree_->skillId(index), static_cast<int32_t>(skills_.level[index]));
+        });
+    }
 
     // Get available skills to learn
     std::vector<SkillId> getAvailableSkills() const;
@@ -48,22 +60,17 @@ public:
     // Use a skill (checks cooldown, mana, etc.)
     bool useSkill(SkillId skillId);
 
-    // Get remaining cooldown for a skill
+    // Get remaining cooldown for a skill, in seconds. Cooldowns run on
+    // the manager's timers, so an unmanaged character's never end.
     float getSkillCooldown(SkillId skillId) const;
 
-    // Update cooldowns
-    void update(Tick currentTick) override;
-
 private:
-    SkillTree skillTree_;
-    int32_t skillPoints_ = 0;
+    // Index of a learned skill, NO_INDEX if not learned
+    CompiledSkillTree::SkillIndex learnedIndex(SkillId skillId) const;
 
-    std::unordered_set<SkillId> learnedSkills_;
-    std::unordered_map<SkillId, int32_t> skillLevels_;
-
-    // Cooldown tracking (skill ID -> last use tick)
-    std::unordered_map<SkillId, Tick> skillCooldowns_;
-    Tick lastUpdateTick_ = 0;
+    SkillTreePtr skillTree_;
+    int32_t skillPoints_ = 0;
+    CompiledSkillTree::SkillLevels skills_;
 
     static constexpr int32_t SKILL_POINTS_PER_LEVEL = 1;
 };
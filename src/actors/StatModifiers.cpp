@@ -0,0 +1,139 @@
+#include "StatModifiers.hpp"
+#include <atomic>
+
+namespace mmorpg {
+
+StatModifierStack::ModifierId StatModifierStack::nextId() {
+    static std::atomic<ModifierId> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StatModifierStack::add(ModifierId id, const StatModifier& modifier) {
+    entries_.push_back({id, modifier});
+    flat_[index(modifier.stat)] += modifier.flat;
+    percent_[index(modifier.stat)] += modifier.percent;
+    if (modifier.expiresAt != 0 && modifier.expiresAt < nextExpiry_) {
+        nextExpiry_ = modifier.expiresAt;
+    }
+}
+
+uint32_t StatModifierStack::remove(ModifierId id) {
+    for (size_t i = 0; i < entries_.size(); i++) {
+        if (entries_[i].id == id) {
+            PrimaryStat stat = entries_[i].modifier.stat;
+            bool hadPercent = entries_[i].modifier.percent != 0.0f;
+            removeAt(i);
+            if (hadPercent) {
+                resumPercent(stat);
+            }
+            return statBit(stat);
+        }
+    }
+    return 0;
+}
+
+uint32_t StatModifierStack::removeBySource(uint32_t source) {
+    uint32_t changed = 0;
+    for (size_t i = 0; i < entries_.size();) {
+        if (entries_[i].modifier.source == source) {
+            changed |= statBit(entries_[i].modifier.stat);
+            removeAt(i);
+        } else {
+            i++;
+        }
+    }
+    for (size_t s = 0; s < PRIMARY_STAT_COUNT; s++) {
+        if (changed & (1u << s)) {
+            resumPercent(static_cast<PrimaryStat>(s));
+        }
+    }
+    return changed;
+}
+
+void StatModifierStack::clear() {
+    entries_.clear();
+    flat_.fill(0);
+    percent_.fill(0.0f);
+    nextExpiry_ = NEVER;
+}
+
+uint32_t StatModifierStack::expire(Tick now) {
+    if (now < nextExpiry_) return 0;
+
+    // Compact in place, keeping the survivors in order
+    uint32_t changed = 0;
+    uint32_t percentChanged = 0;
+    Tick next = NEVER;
+    size_t kept = 0;
+    for (size_t i = 0; i < entries_.size(); i++) {
+        const StatModifier& modifier = entries_[i].modifier;
+        if (modifier.expiresAt != 0 && modifier.expiresAt <= now) {
+            changed |= statBit(modifier.stat);
+            if (modifier.percent != 0.0f) {
+                percentChanged |= statBit(modifier.stat);
+            }
+            flat_[index(modifier.stat)] -= modifier.flat;
+            continue;
+        }
+        if (modifier.expiresAt != 0 && modifier.expiresAt < next) {
+            next = modifier.expiresAt;
+        }
+        if (kept != i) {
+            entries_[kept] = entries_[i];
+        }
+        kept++;
+    }
+    entries_.resize(kept);
+    nextExpiry_ = next;
+
+    for (size_t s = 0; s < PRIMARY_STAT_COUNT; s++) {
+        if (percentChanged & (1u << s)) {
+            resumPercent(static_cast<PrimaryStat>(s));
+        }
+    }
+    return changed;
+}
+
+const StatModifier* StatModifierStack::find(ModifierId id) const {
+    for (const auto& entry : entries_) {
+        if (entry.id == id) return &entry.modifier;
+    }
+    return nullptr;
+}
+
+int32_t StatModifierStack::apply(PrimaryStat stat, int32_t base) const {
+    int32_t value = base + flat_[index(stat)];
+    float percent = percent_[index(stat)];
+    if (percent == 0.0f) return value;
+    return static_cast<int32_t>(value * (1.0f + percent));
+}
+
+PrimaryStats StatModifierStack::apply(const PrimaryStats& base) const {
+    if (entries_.empty()) return base;
+
+    PrimaryStats effective;
+    for (size_t s = 0; s < PRIMARY_STAT_COUNT; s++) {
+        auto stat = static_cast<PrimaryStat>(s);
+        effective[stat] = apply(stat, base[stat]);
+    }
+    return effective;
+}
+
+void StatModifierStack::removeAt(size_t position) {
+    const StatModifier& modifier = entries_[position].modifier;
+    flat_[index(modifier.stat)] -= modifier.flat;
+    entries_[position] = entries_.back();
+    entries_.pop_back();
+}
+
+void StatModifierStack::resumPercent(PrimaryStat stat) {
+    float total = 0.0f;
+    for (const auto& entry : entries_) {
+        if (entry.modifier.stat == stat) {
+            total += entry.modifier.percent;
+        }
+    }
+    percent_[index(stat)] = total;
+}
+
+} // namespace mmorpg
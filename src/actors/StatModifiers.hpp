@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../core/Types.hpp"
+#include "Stats.hpp"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mmorpg {
+
+// A change to one primary stat from a buff, debuff, item, ...
+struct StatModifier {
+    PrimaryStat stat = PrimaryStat::Strength;
+    int32_t flat = 0;        // Added to the base value
+    float percent = 0.0f;    // Then scaled by (1 + percent); 0.5 = +50%, -0.2 = -20%
+    uint32_t source = 0;     // Who applied it (skill id, item id, ...)
+    Tick expiresAt = 0;      // Tick it ends at; 0 = until removed
+};
+
+// The modifiers on one actor. Per-stat flat and percent totals are kept
+// current on add/remove, so effective stats cost one multiply-add per
+// stat however many modifiers are stacked.
+class StatModifierStack {
+public:
+    using ModifierId = uint32_t;
+    static constexpr Tick NEVER = std::numeric_limits<Tick>::max();
+
+    // Ids are unique process-wide, so a stale id never matches a newer
+    // modifier, even after an actor's row moves between stores
+    static ModifierId nextId();
+
+    void add(ModifierId id, const StatModifier& modifier);
+
+    // Returns the change mask (statBit) of what was removed, 0 if nothing
+    uint32_t remove(ModifierId id);
+    uint32_t removeBySource(uint32_t source);
+    void clear();
+
+    // Drop every timed modifier whose expiry tick has come, in one pass
+    // (returns the change mask). getNextExpiry() is never later than the
+    // earliest pending expiry, so callers can skip stacks until then.
+    uint32_t expire(Tick now);
+    Tick getNextExpiry() const { return nextExpiry_; }
+
+    const StatModifier* find(ModifierId id) const;
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    int32_t getFlatTotal(PrimaryStat stat) const { return flat_[index(stat)]; }
+    float getPercentTotal(PrimaryStat stat) const { return percent_[index(stat)]; }
+
+    // (base + flat) * (1 + percent), truncated toward zero
+    int32_t apply(PrimaryStat stat, int32_t base) const;
+    PrimaryStats apply(const PrimaryStats& base) const;
+
+    struct Entry {
+        ModifierId id;
+        StatModifier modifier;
+    };
+    const std::vector<Entry>& getEntries() const { return entries_; }
+
+private:
+    static size_t index(PrimaryStat stat) { return static_cast<size_t>(stat); }
+
+    // Re-sum one stat's percent total in entry order, so removal doesn't
+    // leave float residue behind
+    void resumPercent(PrimaryStat stat);
+    void removeAt(size_t position);
+
+    std::vector<Entry> entries_;
+    std::array<int32_t, PRIMARY_STAT_COUNT> flat_{};
+    std::array<float, PRIMARY_STAT_COUNT> percent_{};
+    Tick nextExpiry_ = NEVER;
+};
+
+} // namespace mmorpg
@@ -0,0 +1,282 @@
+#include "Stats.hpp"
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MMORPG_STATS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace mmorpg {
+
+// The vector kernels read PrimaryStats as six consecutive int32 fields
+static_assert(sizeof(PrimaryStats) == 6 * sizeof(int32_t), "PrimaryStats must be six packed int32 fields");
+static_assert(std::is_standard_layout<PrimaryStats>::value, "PrimaryStats must be standard layout");
+
+namespace {
+
+// Derived fields read by each primary stat, in PrimaryStat order
+constexpr uint32_t FIELDS_BY_STAT[PRIMARY_STAT_COUNT] = {
+    DerivedField::PhysicalAttack | DerivedField::PhysicalDefense,                  // strength
+    DerivedField::CriticalChance | DerivedField::DodgeChance |
+        DerivedField::AttackSpeed | DerivedField::MoveSpeed,                       // agility
+    DerivedField::MaxMp | DerivedField::MagicalAttack | DerivedField::MagicalDefense,  // intelligence
+    DerivedField::MaxHp | DerivedField::PhysicalDefense,                           // vitality
+    DerivedField::MaxMp | DerivedField::MagicalDefense,                            // wisdom
+    DerivedField::CriticalChance | DerivedField::CriticalMultiplier,               // luck
+};
+
+constexpr uint32_t FIELDS_BY_LEVEL = DerivedField::MaxHp | DerivedField::MaxMp |
+                                     DerivedField::PhysicalAttack | DerivedField::MagicalAttack;
+
+void calculateScalar(const PrimaryStats* primary, const int32_t* levels, DerivedStats* out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = StatCalculator::calculate(primary[i], levels[i]);
+    }
+}
+
+#ifdef MMORPG_STATS_X86
+
+// The kernels evaluate the formulas of StatCalculator::calculate() in the
+// same order and precision (float multiply, then add; no FMA), so every
+// lane matches the scalar result bit for bit. Integer halving truncates
+// toward zero like '/ 2': (x + sign bit) >> 1.
+
+// Lane values for LANES actors, written back as DerivedStats
+template<size_t LANES>
+struct Lanes {
+    alignas(32) int32_t maxHp[LANES];
+    alignas(32) int32_t maxMp[LANES];
+    alignas(32) int32_t physicalAttack[LANES];
+    alignas(32) int32_t magicalAttack[LANES];
+    alignas(32) int32_t physicalDefense[LANES];
+    alignas(32) int32_t magicalDefense[LANES];
+    alignas(32) float criticalChance[LANES];
+    alignas(32) float criticalMultiplier[LANES];
+    alignas(32) float dodgeChance[LANES];
+    alignas(32) float attackSpeed[LANES];
+    alignas(32) float moveSpeed[LANES];
+
+    void store(DerivedStats* out) const {
+        for (size_t lane = 0; lane < LANES; lane++) {
+            DerivedStats& derived = out[lane];
+            derived.maxHp = maxHp[lane];
+            derived.maxMp = maxMp[lane];
+            derived.physicalAttack = physicalAttack[lane];
+            derived.magicalAttack = magicalAttack[lane];
+            derived.physicalDefense = physicalDefense[lane];
+            derived.magicalDefense = magicalDefense[lane];
+            derived.criticalChance = criticalChance[lane];
+            derived.criticalMultiplier = criticalMultiplier[lane];
+            derived.dodgeChance = dodgeChance[lane];
+            derived.attackSpeed = attackSpeed[lane];
+            derived.moveSpeed = moveSpeed[lane];
+        }
+    }
+};
+
+__attribute__((target("sse4.1")))
+inline __m128i half(__m128i x) {
+    return _mm_srai_epi32(_mm_add_epi32(x, _mm_srli_epi32(x, 31)), 1);
+}
+
+__attribute__((target("sse4.1")))
+inline __m128i times(__m128i x, int32_t factor) {
+    return _mm_mullo_epi32(x, _mm_set1_epi32(factor));
+}
+
+__attribute__((target("sse4.1")))
+void calculateSse41(const PrimaryStats* primary, const int32_t* levels, DerivedStats* out, size_t count) {
+    const __m128 critBase = _mm_set1_ps(0.05f);
+    const __m128 critPerLuck = _mm_set1_ps(0.005f);
+    const __m128 critPerAgility = _mm_set1_ps(0.002f);
+    const __m128 critCap = _mm_set1_ps(0.75f);
+    const __m128 critMulBase = _mm_set1_ps(1.5f);
+    const __m128 critMulPerLuck = _mm_set1_ps(0.01f);
+    const __m128 dodgePerAgility = _mm_set1_ps(0.003f);
+    const __m128 dodgeCap = _mm_set1_ps(0.50f);
+    const __m128 speedBase = _mm_set1_ps(1.0f);
+    const __m128 speedPerAgility = _mm_set1_ps(0.01f);
+    const __m128 moveBase = _mm_set1_ps(5.0f);
+    const __m128 movePerAgility = _mm_set1_ps(0.05f);
+
+    Lanes<4> lanes;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const PrimaryStats* p = primary + i;
+        __m128i strength = _mm_setr_epi32(p[0].strength, p[1].strength, p[2].strength, p[3].strength);
+        __m128i agility = _mm_setr_epi32(p[0].agility, p[1].agility, p[2].agility, p[3].agility);
+        __m128i intelligence = _mm_setr_epi32(p[0].intelligence, p[1].intelligence, p[2].intelligence, p[3].intelligence);
+        __m128i vitality = _mm_setr_epi32(p[0].vitality, p[1].vitality, p[2].vitality, p[3].vitality);
+        __m128i wisdom = _mm_setr_epi32(p[0].wisdom, p[1].wisdom, p[2].wisdom, p[3].wisdom);
+        __m128i luck = _mm_setr_epi32(p[0].luck, p[1].luck, p[2].luck, p[3].luck);
+        __m128i level = _mm_loadu_si128(reinterpret_cast<const __m128i*>(levels + i));
+        __m128i halfLevel = half(level);
+
+        __m128i maxHp = _mm_add_epi32(_mm_add_epi32(_mm_set1_epi32(100), times(vitality, 10)), times(level, 5));
+        __m128i maxMp = _mm_add_epi32(_mm_add_epi32(_mm_add_epi32(_mm_set1_epi32(50), times(intelligence, 5)),
+                                                    times(wisdom, 3)), times(level, 2));
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.maxHp), maxHp);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.maxMp), maxMp);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.physicalAttack), _mm_add_epi32(times(strength, 2), halfLevel));
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.magicalAttack), _mm_add_epi32(times(intelligence, 2), halfLevel));
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.physicalDefense), _mm_add_epi32(vitality, half(strength)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.magicalDefense), _mm_add_epi32(wisdom, half(intelligence)));
+
+        __m128 agilityF = _mm_cvtepi32_ps(agility);
+        __m128 luckF = _mm_cvtepi32_ps(luck);
+        __m128 crit = _mm_add_ps(_mm_add_ps(critBase, _mm_mul_ps(luckF, critPerLuck)), _mm_mul_ps(agilityF, critPerAgility));
+        __m128 dodge = _mm_add_ps(critBase, _mm_mul_ps(agilityF, dodgePerAgility));
+        _mm_store_ps(lanes.criticalChance, _mm_min_ps(crit, critCap));
+        _mm_store_ps(lanes.criticalMultiplier, _mm_add_ps(critMulBase, _mm_mul_ps(luckF, critMulPerLuck)));
+        _mm_store_ps(lanes.dodgeChance, _mm_min_ps(dodge, dodgeCap));
+        _mm_store_ps(lanes.attackSpeed, _mm_add_ps(speedBase, _mm_mul_ps(agilityF, speedPerAgility)));
+        _mm_store_ps(lanes.moveSpeed, _mm_add_ps(moveBase, _mm_mul_ps(agilityF, movePerAgility)));
+
+        lanes.store(out + i);
+    }
+    calculateScalar(primary + i, levels + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+inline __m256i half(__m256i x) {
+    return _mm256_srai_epi32(_mm256_add_epi32(x, _mm256_srli_epi32(x, 31)), 1);
+}
+
+__attribute__((target("avx2")))
+inline __m256i times(__m256i x, int32_t factor) {
+    return _mm256_mullo_epi32(x, _mm256_set1_epi32(factor));
+}
+
+__attribute__((target("avx2")))
+void calculateAvx2(const PrimaryStats* primary, const int32_t* levels, DerivedStats* out, size_t count) {
+    const __m256 critBase = _mm256_set1_ps(0.05f);
+    const __m256 critPerLuck = _mm256_set1_ps(0.005f);
+    const __m256 critPerAgility = _mm256_set1_ps(0.002f);
+    const __m256 critCap = _mm256_set1_ps(0.75f);
+    const __m256 critMulBase = _mm256_set1_ps(1.5f);
+    const __m256 critMulPerLuck = _mm256_set1_ps(0.01f);
+    const __m256 dodgePerAgility = _mm256_set1_ps(0.003f);
+    const __m256 dodgeCap = _mm256_set1_ps(0.50f);
+    const __m256 speedBase = _mm256_set1_ps(1.0f);
+    const __m256 speedPerAgility = _mm256_set1_ps(0.01f);
+    const __m256 moveBase = _mm256_set1_ps(5.0f);
+    const __m256 movePerAgility = _mm256_set1_ps(0.05f);
+
+    // Offsets of eight consecutive PrimaryStats, in int32 units
+    const __m256i stride = _mm256_setr_epi32(0, 6, 12, 18, 24, 30, 36, 42);
+
+    Lanes<8> lanes;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const PrimaryStats* p = primary + i;
+        __m256i strength = _mm256_i32gather_epi32(&p->strength, stride, 4);
+        __m256i agility = _mm256_i32gather_epi32(&p->agility, stride, 4);
+        __m256i intelligence = _mm256_i32gather_epi32(&p->intelligence, stride, 4);
+        __m256i vitality = _mm256_i32gather_epi32(&p->vitality, stride, 4);
+        __m256i wisdom = _mm256_i32gather_epi32(&p->wisdom, stride, 4);
+        __m256i luck = _mm256_i32gather_epi32(&p->luck, stride, 4);
+        __m256i level = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(levels + i));
+        __m256i halfLevel = half(level);
+
+        __m256i maxHp = _mm256_add_epi32(_mm256_add_epi32(_mm256_set1_epi32(100), times(vitality, 10)), times(level, 5));
+        __m256i maxMp = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(_mm256_set1_epi32(50), times(intelligence, 5)),
+                                                          times(wisdom, 3)), times(level, 2));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.maxHp), maxHp);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.maxMp), maxMp);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.physicalAttack), _mm256_add_epi32(times(strength, 2), halfLevel));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.magicalAttack), _mm256_add_epi32(times(intelligence, 2), halfLevel));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.physicalDefense), _mm256_add_epi32(vitality, half(strength)));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.magicalDefense), _mm256_add_epi32(wisdom, half(intelligence)));
+
+        __m256 agilityF = _mm256_cvtepi32_ps(agility);
+        __m256 luckF = _mm256_cvtepi32_ps(luck);
+        __m256 crit = _mm256_add_ps(_mm256_add_ps(critBase, _mm256_mul_ps(luckF, critPerLuck)),
+                                    _mm256_mul_ps(agilityF, critPerAgility));
+        __m256 dodge = _mm256_add_ps(critBase, _mm256_mul_ps(agilityF, dodgePerAgility));
+        _mm256_store_ps(lanes.criticalChance, _mm256_min_ps(crit, critCap));
+        _mm256_store_ps(lanes.criticalMultiplier, _mm256_add_ps(critMulBase, _mm256_mul_ps(luckF, critMulPerLuck)));
+        _mm256_store_ps(lanes.dodgeChance, _mm256_min_ps(dodge, dodgeCap));
+        _mm256_store_ps(lanes.attackSpeed, _mm256_add_ps(speedBase, _mm256_mul_ps(agilityF, speedPerAgility)));
+        _mm256_store_ps(lanes.moveSpeed, _mm256_add_ps(moveBase, _mm256_mul_ps(agilityF, movePerAgility)));
+
+        lanes.store(out + i);
+    }
+    calculateScalar(primary + i, levels + i, out + i, count - i);
+}
+
+#endif // MMORPG_STATS_X86
+
+StatKernel detectKernel() {
+    if (StatCalculator::isKernelSupported(StatKernel::Avx2)) return StatKernel::Avx2;
+    if (StatCalculator::isKernelSupported(StatKernel::Sse41)) return StatKernel::Sse41;
+    return StatKernel::Scalar;
+}
+
+} // namespace
+
+uint32_t StatCalculator::affectedFields(uint32_t changed) {
+    uint32_t fields = (changed & LEVEL_CHANGED) ? FIELDS_BY_LEVEL : 0;
+    for (size_t i = 0; i < PRIMARY_STAT_COUNT; i++) {
+        if (changed & (1u << i)) {
+            fields |= FIELDS_BY_STAT[i];
+        }
+    }
+    return fields;
+}
+
+bool StatCalculator::isKernelSupported(StatKernel kernel) {
+    switch (kernel) {
+        case StatKernel::Scalar: return true;
+#ifdef MMORPG_STATS_X86
+        case StatKernel::Sse41: return __builtin_cpu_supports("sse4.1");
+        case StatKernel::Avx2:  return __builtin_cpu_supports("avx2");
+#else
+        case StatKernel::Sse41: return false;
+        case StatKernel::Avx2:  return false;
+#endif
+    }
+    return false;
+}
+
+StatKernel StatCalculator::getBatchKernel() {
+    static const StatKernel kernel = detectKernel();
+    return kernel;
+}
+
+const char* StatCalculator::kernelName(StatKernel kernel) {
+    switch (kernel) {
+        case StatKernel::Scalar: return "scalar";
+        case StatKernel::Sse41:  return "sse4.1";
+        case StatKernel::Avx2:   return "avx2";
+    }
+    return "?";
+}
+
+void StatCalculator::calculateBatch(const PrimaryStats* primary, const int32_t* levels,
+                                    DerivedStats* out, size_t count) {
+    calculateBatch(getBatchKernel(), primary, levels, out, count);
+}
+
+void StatCalculator::calculateBatch(StatKernel kernel, const PrimaryStats* primary,
+                                    const int32_t* levels, DerivedStats* out, size_t count) {
+    // An unsupported kernel falls back rather than faulting
+    if (!isKernelSupported(kernel)) {
+        kernel = StatKernel::Scalar;
+    }
+
+    switch (kernel) {
+#ifdef MMORPG_STATS_X86
+        case StatKernel::Avx2:
+            calculateAvx2(primary, levels, out, count);
+            return;
+        case StatKernel::Sse41:
+            calculateSse41(primary, levels, out, count);
+            return;
+#endif
+        default:
+            calculateScalar(primary, levels, out, count);
+            return;
+    }
+}
+
+} // namespace mmorpg
@@ -1,11 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <cmath>
+#include "../core/PrimaryStat.hpp"
 
 namespace mmorpg {
 
+// Change masks: one bit per primary stat, plus one for level
+constexpr uint32_t statBit(PrimaryStat stat) { return 1u << static_cast<uint32_t>(stat); }
+constexpr uint32_t LEVEL_CHANGED = 1u << PRIMARY_STAT_COUNT;
+constexpr uint32_t ALL_STATS_CHANGED = (LEVEL_CHANGED << 1) - 1;
+
 // Primary stats - base attributes that affect derived stats
 struct PrimaryStats {
     int32_t strength = 10;      // Physical damage, carry capacity
@@ -14,6 +23,20 @@ struct PrimaryStats {
     int32_t vitality = 10;      // HP pool, defense
     int32_t wisdom = 10;        // MP regen, magic defense
     int32_t luck = 10;          // Crit chance, drop rates
+
+    int32_t& operator[](PrimaryStat stat) {
+        switch (stat) {
+            case PrimaryStat::Strength:     return strength;
+            case PrimaryStat::Agility:      return agility;
+            case PrimaryStat::Intelligence: return intelligence;
+            case PrimaryStat::Vitality:     return vitality;
+            case PrimaryStat::Wisdom:       return wisdom;
+            default:                        return luck;
+        }
+    }
+    int32_t operator[](PrimaryStat stat) const {
+        return const_cast<PrimaryStats&>(*this)[stat];
+    }
 };
 
 // Derived/computed stats - calculated from primary stats and level
@@ -31,56 +54,121 @@ struct DerivedStats {
     float moveSpeed = 5.0f;          // Units per second
 };
 
+// Bits naming DerivedStats fields, for partial recalculation
+namespace DerivedField {
+constexpr uint32_t MaxHp              = 1u << 0;
+constexpr uint32_t MaxMp              = 1u << 1;
+constexpr uint32_t PhysicalAttack     = 1u << 2;
+constexpr uint32_t MagicalAttack      = 1u << 3;
+constexpr uint32_t PhysicalDefense    = 1u << 4;
+constexpr uint32_t MagicalDefense     = 1u << 5;
+constexpr uint32_t CriticalChance     = 1u << 6;
+constexpr uint32_t CriticalMultiplier = 1u << 7;
+constexpr uint32_t DodgeChance        = 1u << 8;
+constexpr uint32_t AttackSpeed        = 1u << 9;
+constexpr uint32_t MoveSpeed          = 1u << 10;
+constexpr uint32_t All                = (1u << 11) - 1;
+} // namespace DerivedField
+
 // Runtime stats - current values that change during gameplay
 struct RuntimeStats {
     int32_t currentHp = 100;
     int32_t currentMp = 50;
 };
 
+// Implementations of StatCalculator::calculateBatch
+enum class StatKernel {
+    Scalar,
+    Sse41,   // 4 actors per step
+    Avx2     // 8 actors per step
+};
+
 // Stat calculator - derives stats from primary + level
 class StatCalculator {
 public:
     static DerivedStats calculate(const PrimaryStats& primary, int32_t level) {
         DerivedStats derived;
+        calculateFields(primary, level, DerivedField::All, derived);
+        return derived;
+    }
 
+    // Recompute only the DerivedField bits in fields; the rest of derived
+    // is left as is
+    static void calculateFields(const PrimaryStats& primary, int32_t level, uint32_t fields,
+                                DerivedStats& derived) {
         // HP = base + (vitality * 10) + (level * 5)
-        derived.maxHp = 100 + (primary.vitality * 10) + (level * 5);
+        if (fields & DerivedField::MaxHp) {
+            derived.maxHp = 100 + (primary.vitality * 10) + (level * 5);
+        }
 
         // MP = base + (intelligence * 5) + (wisdom * 3) + (level * 2)
-        derived.maxMp = 50 + (primary.intelligence * 5) + (primary.wisdom * 3) + (level * 2);
+        if (fields & DerivedField::MaxMp) {
+            derived.maxMp = 50 + (primary.intelligence * 5) + (primary.wisdom * 3) + (level * 2);
+        }
 
         // Physical Attack = strength * 2 + (level / 2)
-        derived.physicalAttack = primary.strength * 2 + (level / 2);
+        if (fields & DerivedField::PhysicalAttack) {
+            derived.physicalAttack = primary.strength * 2 + (level / 2);
+        }
 
         // Magical Attack = intelligence * 2 + (level / 2)
-        derived.magicalAttack = primary.intelligence * 2 + (level / 2);
+        if (fields & DerivedField::MagicalAttack) {
+            derived.magicalAttack = primary.intelligence * 2 + (level / 2);
+        }
 
         // Physical Defense = vitality + (strength / 2)
-        derived.physicalDefense = primary.vitality + (primary.strength / 2);
+        if (fields & DerivedField::PhysicalDefense) {
+            derived.physicalDefense = primary.vitality + (primary.strength / 2);
+        }
 
         // Magical Defense = wisdom + (intelligence / 2)
-        derived.magicalDefense = primary.wisdom + (primary.intelligence / 2);
+        if (fields & DerivedField::MagicalDefense) {
+            derived.magicalDefense = primary.wisdom + (primary.intelligence / 2);
+        }
 
         // Critical Chance = 5% + (luck * 0.5%) + (agility * 0.2%)
-        derived.criticalChance = 0.05f + (primary.luck * 0.005f) + (primary.agility * 0.002f);
-        derived.criticalChance = std::min(derived.criticalChance, 0.75f); // Cap at 75%
+        if (fields & DerivedField::CriticalChance) {
+            derived.criticalChance = 0.05f + (primary.luck * 0.005f) + (primary.agility * 0.002f);
+            derived.criticalChance = std::min(derived.criticalChance, 0.75f); // Cap at 75%
+        }
 
         // Critical Multiplier = 1.5 + (luck * 0.01)
-        derived.criticalMultiplier = 1.5f + (primary.luck * 0.01f);
+        if (fields & DerivedField::CriticalMultiplier) {
+            derived.criticalMultiplier = 1.5f + (primary.luck * 0.01f);
+        }
 
         // Dodge Chance = 5% + (agility * 0.3%)
-        derived.dodgeChance = 0.05f + (primary.agility * 0.003f);
-        derived.dodgeChance = std::min(derived.dodgeChance, 0.50f); // Cap at 50%
+        if (fields & DerivedField::DodgeChance) {
+            derived.dodgeChance = 0.05f + (primary.agility * 0.003f);
+            derived.dodgeChance = std::min(derived.dodgeChance, 0.50f); // Cap at 50%
+        }
 
         // Attack Speed = 1.0 + (agility * 0.01)
-        derived.attackSpeed = 1.0f + (primary.agility * 0.01f);
+        if (fields & DerivedField::AttackSpeed) {
+            derived.attackSpeed = 1.0f + (primary.agility * 0.01f);
+        }
 
         // Move Speed = 5.0 + (agility * 0.05)
-        derived.moveSpeed = 5.0f + (primary.agility * 0.05f);
-
-        return derived;
+        if (fields & DerivedField::MoveSpeed) {
+            derived.moveSpeed = 5.0f + (primary.agility * 0.05f);
+        }
     }
 
+    // DerivedField bits that depend on the stats in a change mask
+    static uint32_t affectedFields(uint32_t changed);
+
+    // Derive stats for count actors: out[i] = calculate(primary[i], levels[i]).
+    // Uses the widest kernel the CPU supports (chosen once, at first use);
+    // every kernel gives results bit-identical to calculate().
+    static void calculateBatch(const PrimaryStats* primary, const int32_t* levels,
+                               DerivedStats* out, size_t count);
+    static void calculateBatch(StatKernel kernel, const PrimaryStats* primary,
+                               const int32_t* levels, DerivedStats* out, size_t count);
+
+    static StatKernel getBatchKernel();
+    static bool isKernelSupported(StatKernel kernel);
+    static const char* kernelName(StatKernel kernel);
+
     // Calculate experience required for next level
     static int64_t experienceForLevel(int32_t level) {
         // Exponential growth: 100 * level^2
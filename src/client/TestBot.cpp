@@ -8,7 +8,6 @@
 namespace mmorpg::client {
 
 TestBot::TestBot(const std::string& name) : name_(name) {
-    recvBuffer_.reserve(65536);
 }
 
 TestBot::~TestBot() {
@@ -52,21 +51,9 @@ bool TestBot::login(const std::string& password) {
 bool TestBot::sendPacket(proto::MessageType type, const google::protobuf::Message& message) {
     if (!connected_ || !socket_) return false;
 
-    proto::Packet packet;
-    packet.set_type(static_cast<uint32_t>(type));
-    packet.set_payload(message.SerializeAsString());
-
-    std::string data = packet.SerializeAsString();
-    uint32_t len = boost::endian::native_to_big(static_cast<uint32_t>(data.size()));
-
-    // Send length prefix
-    if (!socket_->send(reinterpret_cast<uint8_t*>(&len), 4)) {
-        connected_ = false;
-        return false;
-    }
-
-    // Send data
-    if (!socket_->send(reinterpret_cast<const uint8_t*>(data.data()), data.size())) {
+    // Length prefix and body in a single send
+    auto frame = net::Frame::encode(type, message, frameFormat_);
+    if (!socket_->send(frame->data(), frame->size())) {
         connected_ = false;
         return false;
     }
@@ -94,8 +81,8 @@ bool TestBot::poll(int timeoutMs) {
 }
 
 bool TestBot::receiveAndProcess() {
-    uint8_t buffer[4096];
-    int received = socket_->receiveInto(buffer, sizeof(buffer));
+    recvBuffer_.prepare(4096);
+    int received = socket_->receiveInto(recvBuffer_.writePtr(), recvBuffer_.writable());
 
     if (received < 0) {
         // For non-blocking, no data is not an error
@@ -107,13 +94,14 @@ bool TestBot::receiveAndProcess() {
         return false;
     }
 
-    recvBuffer_.insert(recvBuffer_.end(), buffer, buffer + received);
+    recvBuffer_.commit(static_cast<size_t>(received));
 
-    // Parse packets
-    while (recvBuffer_.size() >= 4) {
-        uint32_t packetLen;
-        memcpy(&packetLen, recvBuffer_.data(), 4);
-        packetLen = boost::endian::big_to_native(packetLen);
+    // Parse packets in place
+    while (recvBuffer_.readable() >= 4) {
+        uint32_t word;
+        memcpy(&word, recvBuffer_.readPtr(), 4);
+        word = boost::endian::big_to_native(word);
+        uint32_t packetLen = word & ~net::Frame::TYPED_FRAME_FLAG;
 
         if (packetLen > 1024 * 1024) {
             std::cerr << "[" << name_ << "] Packet too large" << std::endl;
@@ -121,17 +109,25 @@ bool TestBot::receiveAndProcess() {
             return false;
         }
 
-        if (recvBuffer_.size() < 4 + packetLen) {
+        if (recvBuffer_.readable() < 4 + packetLen) {
+            // Make sure the rest of this packet fits
+            recvBuffer_.prepare(4 + packetLen - recvBuffer_.readable());
             break;
         }
 
-        proto::Packet packet;
-        if (packet.ParseFromArray(recvBuffer_.data() + 4, packetLen)) {
+        // Accept either framing, whatever we send
+        auto format = (word & net::Frame::TYPED_FRAME_FLAG) ? net::FrameFormat::Typed
+                                                            : net::FrameFormat::Envelope;
+        net::PacketView view;
+        if (net::Frame::decode(format, {recvBuffer_.readPtr() + 4, packetLen}, view)) {
+            proto::Packet packet;
+            packet.set_type(view.type);
+            packet.set_payload(view.data, view.size);
             handlePacket(packet);
             receivedPackets_.push_back(packet);
         }
 
-        recvBuffer_.erase(recvBuffer_.begin(), recvBuffer_.begin() + 4 + packetLen);
+        recvBuffer_.consume(4 + packetLen);
     }
 
     return true;
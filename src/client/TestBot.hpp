@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../network/Socket.hpp"
+#include "../network/Frame.hpp"
 #include "../proto/messages.pb.h"
 #include <boost/asio.hpp>
 #include <string>
@@ -43,6 +44,9 @@ public:
 
     // Network operations
     bool sendPacket(proto::MessageType type, const google::protobuf::Message& message);
+
+    // Framing used for outgoing packets (the server replies in kind)
+    void setFrameFormat(net::FrameFormat format) { frameFormat_ = format; }
     bool poll(int timeoutMs = 100);
 
     // Game actions
@@ -88,9 +92,10 @@ private:
     std::unique_ptr<net::Socket> socket_;
     bool connected_ = false;
     uint32_t actorId_ = 0;
+    net::FrameFormat frameFormat_ = net::FrameFormat::Envelope;
 
     // Receive buffer
-    std::vector<uint8_t> recvBuffer_;
+    net::RecvBuffer recvBuffer_{65536};
 
     // State
     proto::ActorInfo actorInfo_;
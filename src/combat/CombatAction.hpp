@@ -17,6 +17,7 @@ struct SkillAttack {
     ActorId caster;
     ActorId target;
     SkillId skill;
+    int32_t level = 1;  // Skill level the effects run at
 };
 
 // Area of effect skill
@@ -26,12 +27,14 @@ struct AreaSkill {
     float centerY;
     float radius;
     SkillId skill;
+    int32_t level = 1;
 };
 
 // Self-targeted skill (buff, heal, etc.)
 struct SelfSkill {
     ActorId caster;
     SkillId skill;
+    int32_t level = 1;
 };
 
 // Unified combat action type
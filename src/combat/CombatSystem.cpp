@@ -1,11 +1,13 @@
 #include "CombatSystem.hpp"
+#include "../core/Profiler.hpp"
 #include <iostream>
 
 namespace mmorpg {
 
 CombatSystem::CombatSystem(ActorManager& actors, EventBus& events)
     : actors_(actors)
-    , events_(events) {
+    , events_(events)
+    , skills_(actors, events, damageCalc_) {
 }
 
 void CombatSystem::processAction(const CombatAction& action) {
@@ -28,8 +30,9 @@ void CombatSystem::processAction(const CombatAction& action) {
 }
 
 DamageResult CombatSystem::handleBasicAttack(const BasicAttack& attack) {
-    auto attacker = actors_.getActor(attack.attacker);
-    auto target = actors_.getActor(attack.target);
+    PROFILE_ZONE("combat");
+    Actor* attacker = actors_.findActor(attack.attacker);
+    Actor* target = actors_.findActor(attack.target);
 
     if (!attacker || !target) {
         return {};
@@ -38,22 +41,26 @@ DamageResult CombatSystem::handleBasicAttack(const BasicAttack& attack) {
     // Calculate damage
     auto result = damageCalc_.calculateBasicAttack(*attacker, *target, attack.isPhysical);
 
-    // Apply damage if not dodged
+    // Apply damage if not dodged; a shield may take some or all of it
     if (!result.isDodged) {
-        target->takeDamage(result.finalDamage);
+        result.finalDamage = target->takeDamage(result.finalDamage, result.isPhysical);
+        // Read before publishing: a subscriber may remove the target
+        bool killed = !target->isAlive();
 
         // Publish damage event
-        DamageEvent event{
-            attack.attacker,
-            attack.target,
-            result.finalDamage,
-            result.isCritical,
-            result.isPhysical
-        };
-        events_.publish(event);
+        if (result.finalDamage > 0) {
+            DamageEvent event{
+                attack.attacker,
+                attack.target,
+                result.finalDamage,
+                result.isCritical,
+                result.isPhysical
+            };
+            events_.publish(event);
+        }
 
         // Check for death
-        if (!target->isAlive()) {
+        if (killed) {
             DeathEvent deathEvent{attack.target, attack.attacker};
             events_.publish(deathEvent);
         }
@@ -62,57 +69,38 @@ DamageResult CombatSystem::handleBasicAttack(const BasicAttack& attack) {
     return result;
 }
 
-void CombatSystem::handleSkillAttack(const SkillAttack& attack) {
-    auto caster = actors_.getActor(attack.caster);
-    auto target = actors_.getActor(attack.target);
-
-    if (!caster || !target) {
-        return;
-    }
-
-    // For now, treat skill attacks as enhanced basic attacks
-    // Full skill system will be implemented in Phase 3
-    int32_t skillBonus = 20;  // Placeholder bonus damage
-
-    auto result = damageCalc_.calculateSkillDamage(*caster, *target, skillBonus, true);
-
-    if (!result.isDodged) {
-        target->takeDamage(result.finalDamage);
-
-        // Publish events
-        SkillUsedEvent skillEvent{attack.caster, attack.skill, attack.target};
-        events_.publish(skillEvent);
-
-        DamageEvent damageEvent{
-            attack.caster,
-            attack.target,
-            result.finalDamage,
-            result.isCritical,
-            result.isPhysical
-        };
-        events_.publish(damageEvent);
-
-        if (!target->isAlive()) {
-            DeathEvent deathEvent{attack.target, attack.caster};
-            events_.publish(deathEvent);
-        }
-    }
+CastResult CombatSystem::handleSkillAttack(const SkillAttack& attack) {
+    PROFILE_ZONE("combat");
+    SkillCast skillCast;
+    skillCast.caster = attack.caster;
+    skillCast.skill = attack.skill;
+    skillCast.level = attack.level;
+    skillCast.target = attack.target;
+    return cast(skillCast);
 }
 
-void CombatSystem::handleAreaSkill(const AreaSkill& attack) {
-    // Placeholder for area skill handling
-    // Would need position system to find actors in radius
-    SkillUsedEvent event{attack.caster, attack.skill, INVALID_ACTOR_ID};
-    events_.publish(event);
+CastResult CombatSystem::handleAreaSkill(const AreaSkill& attack) {
+    PROFILE_ZONE("combat");
+    SkillCast skillCast;
+    skillCast.caster = attack.caster;
+    skillCast.skill = attack.skill;
+    skillCast.level = attack.level;
+    skillCast.center = {attack.centerX, attack.centerY};
+    skillCast.radius = attack.radius;
+    return cast(skillCast);
 }
 
-void CombatSystem::handleSelfSkill(const SelfSkill& action) {
-    auto caster = actors_.getActor(action.caster);
-    if (!caster) return;
+CastResult CombatSystem::handleSelfSkill(const SelfSkill& action) {
+    PROFILE_ZONE("combat");
+    SkillCast skillCast;
+    skillCast.caster = action.caster;
+    skillCast.skill = action.skill;
+    skillCast.level = action.level;
+    return cast(skillCast);
+}
 
-    // Placeholder: self skills will be properly implemented with skill system
-    SkillUsedEvent event{action.caster, action.skill, action.caster};
-    events_.publish(event);
+CastResult CombatSystem::cast(const SkillCast& skillCast) {
+    return skills_.resolve(skillCast);
 }
 
 bool CombatSystem::canPerformAction(const CombatAction& action) const {
@@ -133,12 +121,12 @@ bool CombatSystem::canPerformAction(const CombatAction& action) const {
 }
 
 bool CombatSystem::validateAttacker(ActorId id) const {
-    auto actor = actors_.getActor(id);
+    const Actor* actor = actors_.findActor(id);
     return actor && actor->isAlive();
 }
 
 bool CombatSystem::validateTarget(ActorId id) const {
-    auto actor = actors_.getActor(id);
+    const Actor* actor = actors_.findActor(id);
     return actor && actor->isAlive();
 }
 
@@ -2,6 +2,7 @@
 
 #include "CombatAction.hpp"
 #include "DamageCalculator.hpp"
+#include "SkillExecutor.hpp"
 #include "../actors/ActorManager.hpp"
 #include "../core/EventBus.hpp"
 #include <memory>
@@ -15,11 +16,13 @@ public:
     // Process a combat action
     void processAction(const CombatAction& action);
 
-    // Individual action handlers (public for testing)
+    // Individual action handlers (public for testing). Skill actions are
+    // resolved by the skill executor at once; casts queued on it wait for
+    // their own execute().
     DamageResult handleBasicAttack(const BasicAttack& attack);
-    void handleSkillAttack(const SkillAttack& attack);
-    void handleAreaSkill(const AreaSkill& attack);
-    void handleSelfSkill(const SelfSkill& action);
+    CastResult handleSkillAttack(const SkillAttack& attack);
+    CastResult handleAreaSkill(const AreaSkill& attack);
+    CastResult handleSelfSkill(const SelfSkill& action);
 
     // Check if attack is valid (both actors alive, etc.)
     bool canPerformAction(const CombatAction& action) const;
@@ -27,10 +30,17 @@ public:
     // Get damage calculator for configuration
     DamageCalculator& getDamageCalculator() { return damageCalc_; }
 
+    // Skill effects; set its compiled effects before casting, and queue
+    // casts on it to resolve them in one batch
+    SkillExecutor& getSkillExecutor() { return skills_; }
+
 private:
     ActorManager& actors_;
     EventBus& events_;
     DamageCalculator damageCalc_;
+    SkillExecutor skills_;
+
+    CastResult cast(const SkillCast& cast);
 
     // Validate actors exist and are alive
     bool validateAttacker(ActorId id) const;
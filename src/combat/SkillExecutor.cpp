@@ -0,0 +1,195 @@
+#include "SkillExecutor.hpp"
+#include "../core/Profiler.hpp"
+
+namespace mmorpg {
+
+SkillExecutor::SkillExecutor(ActorManager& actors, EventBus& events, DamageCalculator& damage)
+    : actors_(actors)
+    , events_(events)
+    , damage_(damage) {
+}
+
+size_t SkillExecutor::queue(const SkillCast& cast) {
+    casts_.push_back(cast);
+    return casts_.size() - 1;
+}
+
+const std::vector<CastResult>& SkillExecutor::execute() {
+    PROFILE_ZONE("combat.skills");
+    results_.assign(casts_.size(), CastResult{});
+    casters_.clear();
+    runs_.clear();
+    targets_.clear();
+
+    // Targets for every cast, before any of them changes anything
+    for (const SkillCast& cast : casts_) {
+        Actor* caster = actors_.findActor(cast.caster);
+        if (!caster || !caster->isAlive() || !effects_ || !effects_->hasSkill(cast.skill)) {
+            caster = nullptr;
+        }
+        casters_.push_back(caster);
+
+        uint32_t first = static_cast<uint32_t>(targets_.size());
+        if (caster) {
+            gatherTargets(cast, *caster, [this](Actor& target) { targets_.push_back(&target); });
+        }
+        runs_.push_back({first, static_cast<uint32_t>(targets_.size()) - first});
+    }
+
+    for (size_t i = 0; i < casts_.size(); i++) {
+        if (!casters_[i]) continue;
+        uint32_t first = runs_[i].first;
+        apply(casts_[i], *casters_[i], runs_[i].count,
+              [this, first](uint32_t t) -> Actor& { return *targets_[first + t]; },
+              [this](const GameEvent& event) { pendingEvents_.push_back(event); },
+              results_[i]);
+    }
+    casts_.clear();
+
+    // Subscribers may remove actors; nothing above is touched after this
+    for (const GameEvent& event : pendingEvents_) {
+        events_.publish(event);
+    }
+    pendingEvents_.clear();
+    return results_;
+}
+
+CastResult SkillExecutor::resolve(const SkillCast& cast) {
+    PROFILE_ZONE("combat.skills");
+    CastResult result;
+    ActorPtr caster = actors_.getActor(cast.caster);
+    if (!caster || !caster->isAlive() || !effects_ || !effects_->hasSkill(cast.skill)) {
+        return result;
+    }
+
+    // A subscriber may remove any of these, or resolve a cast of its own
+    // (which appends past ours and trims back), so go by index
+    size_t first = held_.size();
+    gatherTargets(cast, *caster, [this](Actor& target) { held_.push_back(target.shared_from_this()); });
+    apply(cast, *caster, static_cast<uint32_t>(held_.size() - first),
+          [this, first](uint32_t t) -> Actor& { return *held_[first + t]; },
+          [this](const GameEvent& event) { events_.publish(event); },
+          result);
+    held_.resize(first);
+    return result;
+}
+
+template<typename AddTarget>
+void SkillExecutor::gatherTargets(const SkillCast& cast, Actor& caster, AddTarget&& add) {
+    TargetType targetType = effects_->getTargetType(cast.skill);
+    switch (targetType) {
+        case TargetType::Self:
+            add(caster);
+            return;
+        case TargetType::SingleEnemy:
+        case TargetType::SingleAlly: {
+            ActorId id = cast.target;
+            if (id == INVALID_ACTOR_ID && targetType == TargetType::SingleAlly) {
+                id = caster.getId();
+            }
+            if (Actor* target = actors_.findActor(id)) {
+                if (target->isAlive()) add(*target);
+            }
+            return;
+        }
+        case TargetType::AreaEnemy:
+        case TargetType::AreaAlly:
+        case TargetType::AreaAll:
+            break;
+    }
+
+    // Area: one pass over the position column
+    bool includeCaster = targetType != TargetType::AreaEnemy;
+    float radius = cast.radius > 0.0f ? cast.radius : effects_->getRange(cast.skill);
+    float radiusSquared = radius * radius;
+    const ActorComponents& components = actors_.getComponents();
+    for (ActorComponents::Row row = 0; row < components.rowLimit(); row++) {
+        if (!components.isActive(row) || components.hp(row) <= 0) continue;
+        const Position& position = components.position(row);
+        float dx = position.x - cast.center.x;
+        float dy = position.y - cast.center.y;
+        if (dx * dx + dy * dy > radiusSquared) continue;
+
+        ActorId id = components.id(row);
+        if (id == caster.getId() && !includeCaster) continue;
+        if (Actor* target = actors_.findActor(id)) {
+            add(*target);
+        }
+    }
+}
+
+template<typename TargetAt, typename Emit>
+void SkillExecutor::apply(const SkillCast& cast, Actor& caster, uint32_t count, TargetAt&& targetAt, Emit&& emit,
+                          CastResult& result) {
+    CompiledSkillEffects::Ops ops = effects_->getOps(cast.skill, cast.level);
+    result.resolved = true;
+    result.targets = count;
+
+    TargetType targetType = effects_->getTargetType(cast.skill);
+    bool single = targetType == TargetType::SingleEnemy || targetType == TargetType::SingleAlly;
+    ActorId usedOn = single && count > 0 ? targetAt(0).getId() : INVALID_ACTOR_ID;
+    emit(SkillUsedEvent{caster.getId(), cast.skill, usedOn});
+
+    // What the ops read from the caster, once per cast
+    const DerivedStats casterStats = caster.getDerivedStats();
+    const int32_t casterWisdom = caster.getEffectivePrimaryStats().wisdom;
+    const Tick now = actors_.getTimers().getCurrentTick();
+
+    for (uint32_t t = 0; t < count; t++) {
+        Actor& target = targetAt(t);
+        bool modifiersCleared = false;
+
+        for (const EffectOp* op = ops.begin; op != ops.end && target.isAlive(); ++op) {
+            switch (op->code) {
+                case EffectOp::Code::Damage: {
+                    bool physical = (op->flags & EFFECT_PHYSICAL) != 0;
+                    int32_t attack = physical ? casterStats.physicalAttack : casterStats.magicalAttack;
+                    int32_t bonus = op->amount + static_cast<int32_t>((op->scaling - 1.0f) * attack);
+                    DamageResult hit = damage_.calculateSkillDamage(caster, target, bonus, physical);
+                    if (hit.isDodged) break;
+
+                    // What got past any shield
+                    int32_t dealt = target.takeDamage(hit.finalDamage, physical);
+                    if (dealt == 0) break;
+                    result.damage += dealt;
+                    emit(DamageEvent{caster.getId(), target.getId(), dealt, hit.isCritical, hit.isPhysical});
+                    if (!target.isAlive()) {
+                        emit(DeathEvent{target.getId(), caster.getId()});
+                    }
+                    break;
+                }
+                case EffectOp::Code::Heal: {
+                    int32_t amount = op->amount + static_cast<int32_t>(op->scaling * casterStats.magicalAttack);
+                    int32_t healed = target.heal(amount);
+                    result.healing += healed;
+                    if (healed > 0) {
+                        emit(HealEvent{caster.getId(), target.getId(), healed});
+                    }
+                    break;
+                }
+                case EffectOp::Code::Modifier:
+                    // Casting again refreshes the skill's modifiers rather than stacking them
+                    if (!modifiersCleared) {
+                        target.removeStatModifiersFrom(cast.skill);
+                        modifiersCleared = true;
+                    }
+                    target.addStatModifier({op->stat, op->amount, op->scaling, cast.skill,
+                                            op->duration != 0 ? now + op->duration : 0});
+                    break;
+                case EffectOp::Code::Periodic:
+                    target.addPeriodicEffect({op->amount, static_cast<uint32_t>(op->duration), op->interval});
+                    break;
+                case EffectOp::Code::ManaRestore:
+                    target.restoreMana(op->amount + static_cast<int32_t>(op->scaling * casterWisdom));
+                    break;
+                case EffectOp::Code::Shield:
+                    target.setShield({op->amount, (op->flags & EFFECT_ABSORBS_PHYSICAL) != 0,
+                                      (op->flags & EFFECT_ABSORBS_MAGICAL) != 0,
+                                      op->duration != 0 ? now + op->duration : 0});
+                    break;
+            }
+        }
+    }
+}
+
+} // namespace mmorpg
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "DamageCalculator.hpp"
+#include "../actors/ActorManager.hpp"
+#include "../core/EventBus.hpp"
+#include "../skills/CompiledSkillEffects.hpp"
+#include <vector>
+
+namespace mmorpg {
+
+// One use of a skill, to be resolved by SkillExecutor
+struct SkillCast {
+    ActorId caster = INVALID_ACTOR_ID;
+    SkillId skill = INVALID_SKILL_ID;
+    int32_t level = 1;
+    ActorId target = INVALID_ACTOR_ID;  // Single-target skills
+    Position center;                    // Area skills
+    float radius = 0.0f;                // Area skills; 0 = the skill's range
+};
+
+// What a cast did
+struct CastResult {
+    bool resolved = false;  // False if the caster was gone or dead, or the skill unknown
+    uint32_t targets = 0;
+    int32_t damage = 0;     // Total of the hits that landed
+    int32_t healing = 0;    // HP restored
+};
+
+// Applies skills through a CompiledSkillEffects table. Casts are queued
+// as they arrive and resolved together by execute(): every cast's
+// targets are gathered first (area skills scan the position column),
+// then each target goes once through all of the skill's ops. Events are
+// held until the whole batch is applied, so subscribers that remove
+// actors cannot pull them out from under the pass. That costs a copy
+// of each event; resolve() skips it for a cast that can't wait.
+//
+// Targets by TargetType: the caster (Self); the cast's target (single
+// enemy; a single ally defaults to the caster); living actors within
+// the radius of the center (areas - there are no factions yet, so
+// AreaEnemy is everyone but the caster and AreaAlly is AreaAll).
+// Range checks, mana and cooldowns are the caller's.
+class SkillExecutor {
+public:
+    SkillExecutor(ActorManager& actors, EventBus& events, DamageCalculator& damage);
+
+    // Compiled effects to run (nullptr = casts resolve to nothing)
+    void setEffects(SkillEffectsPtr effects) { effects_ = std::move(effects); }
+    const SkillEffectsPtr& getEffects() const { return effects_; }
+
+    // Queue a cast for the next execute(); returns its index in the results
+    size_t queue(const SkillCast& cast);
+    size_t pendingCount() const { return casts_.size(); }
+
+    // Resolve the queued casts in queue order, then publish their events
+    // (SkillUsedEvent, then damage and deaths, per cast). Results are by
+    // queue index and valid until the next execute().
+    const std::vector<CastResult>& execute();
+
+    // Resolve one cast now, leaving the queue and the last results alone.
+    // Its caster and targets are held for the cast, so events go out as
+    // the ops apply them.
+    CastResult resolve(const SkillCast& cast);
+
+private:
+    // A cast's targets are targets_[first, first + count)
+    struct TargetRun {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    // Calls add(Actor&) for each target of the cast
+    template<typename AddTarget>
+    void gatherTargets(const SkillCast& cast, Actor& caster, AddTarget&& add);
+
+    // Runs the ops over targetAt(0 .. count - 1); events go to emit
+    template<typename TargetAt, typename Emit>
+    void apply(const SkillCast& cast, Actor& caster, uint32_t count, TargetAt&& targetAt, Emit&& emit,
+               CastResult& result);
+
+    ActorManager& actors_;
+    EventBus& events_;
+    DamageCalculator& damage_;
+    SkillEffectsPtr effects_;
+
+    std::vector<SkillCast> casts_;
+    std::vector<CastResult> results_;
+    std::vector<Actor*> casters_;    // Per cast; nullptr if it doesn't resolve
+    std::vector<TargetRun> runs_;
+    std::vector<Actor*> targets_;
+    std::vector<GameEvent> pendingEvents_;  // Published after the pass
+    std::vector<ActorPtr> held_;            // resolve()'s targets; nested calls append
+};
+
+} // namespace mmorpg
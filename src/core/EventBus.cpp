@@ -1,64 +1,76 @@
 #include "EventBus.hpp"
+#include "Profiler.hpp"
 #include <algorithm>
 
 namespace mmorpg {
 
 EventBus::HandlerId EventBus::subscribe(EventHandler handler) {
+    return add(ALL_EVENTS, std::move(handler));
+}
+
+EventBus::HandlerId EventBus::add(size_t list, EventHandler handler) {
     HandlerId id = nextId_++;
-    handlers_.push_back({id, std::move(handler), true});
+    handlers_[list].push_back({id, std::move(handler), true});
     return id;
 }
 
 void EventBus::unsubscribe(HandlerId id) {
-    if (isPublishing_) {
+    if (publishDepth_ > 0) {
         // Defer removal if we're currently publishing
         pendingRemovals_.push_back(id);
         // Mark as inactive immediately to prevent further calls
-        for (auto& entry : handlers_) {
-            if (entry.id == id) {
-                entry.active = false;
-                break;
+        for (auto& list : handlers_) {
+            for (auto& entry : list) {
+                if (entry.id == id) entry.active = false;
             }
         }
     } else {
         // Remove immediately
-        handlers_.erase(
-            std::remove_if(handlers_.begin(), handlers_.end(),
+        remove(id);
+    }
+}
+
+void EventBus::remove(HandlerId id) {
+    for (auto& list : handlers_) {
+        list.erase(
+            std::remove_if(list.begin(), list.end(),
                 [id](const HandlerEntry& entry) { return entry.id == id; }),
-            handlers_.end()
+            list.end()
         );
     }
 }
 
 void EventBus::publish(const GameEvent& event) {
-    isPublishing_ = true;
-
-    for (const auto& entry : handlers_) {
-        if (entry.active) {
-            entry.handler(event);
-        }
-    }
-
-    isPublishing_ = false;
+    publishDepth_++;
+    dispatch(event.index(), event);
+    dispatch(ALL_EVENTS, event);
+    publishDepth_--;
 
     // Process any deferred removals
-    if (!pendingRemovals_.empty()) {
+    if (publishDepth_ == 0 && !pendingRemovals_.empty()) {
         for (HandlerId id : pendingRemovals_) {
-            handlers_.erase(
-                std::remove_if(handlers_.begin(), handlers_.end(),
-                    [id](const HandlerEntry& entry) { return entry.id == id; }),
-                handlers_.end()
-            );
+            remove(id);
         }
         pendingRemovals_.clear();
     }
 }
 
+void EventBus::dispatch(size_t list, const GameEvent& event) {
+    // By index, so handlers subscribed meanwhile wait for the next event
+    const std::vector<HandlerEntry>& entries = handlers_[list];
+    for (size_t i = 0, count = entries.size(); i < count; i++) {
+        if (entries[i].active) {
+            entries[i].handler(event);
+        }
+    }
+}
+
 void EventBus::queue(const GameEvent& event) {
     eventQueue_.push(event);
 }
 
 void EventBus::processQueue() {
+    PROFILE_ZONE("events.drain");
     while (!eventQueue_.empty()) {
         GameEvent event = std::move(eventQueue_.front());
         eventQueue_.pop();
@@ -66,8 +78,18 @@ void EventBus::processQueue() {
     }
 }
 
+size_t EventBus::getSubscriberCount() const {
+    size_t count = 0;
+    for (const auto& list : handlers_) {
+        count += list.size();
+    }
+    return count;
+}
+
 void EventBus::clearSubscribers() {
-    handlers_.clear();
+    for (auto& list : handlers_) {
+        list.clear();
+    }
     pendingRemovals_.clear();
 }
 
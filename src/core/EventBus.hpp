@@ -1,13 +1,22 @@
 #pragma once
 
 #include "Event.hpp"
+#include <array>
 #include <vector>
 #include <functional>
 #include <queue>
 #include <mutex>
+#include <type_traits>
+#include <utility>
+#include <variant>
 
 namespace mmorpg {
 
+// Handlers subscribe to one event type (subscribe<DamageEvent>) or to
+// every event. Typed handlers are kept in a list per GameEvent
+// alternative, so publishing an event calls only the handlers of its
+// type and the catch-all ones: publish cost follows the subscribers
+// that care, not the total.
 class EventBus {
 public:
     using EventHandler = std::function<void(const GameEvent&)>;
@@ -23,10 +32,19 @@ public:
     // Subscribe to all events
     HandlerId subscribe(EventHandler handler);
 
+    // Subscribe to one event type; handler takes const Event&
+    template<typename Event, typename Handler>
+    HandlerId subscribe(Handler handler) {
+        return add(typeIndex<Event>(), [handler = std::move(handler)](const GameEvent& event) {
+            handler(*std::get_if<Event>(&event));
+        });
+    }
+
     // Unsubscribe by handler ID
     void unsubscribe(HandlerId id);
 
-    // Publish an event immediately to all subscribers
+    // Publish an event immediately: its type's handlers, then the
+    // catch-all ones, each in subscription order
     void publish(const GameEvent& event);
 
     // Queue an event for deferred processing
@@ -35,8 +53,10 @@ public:
     // Process all queued events
     void processQueue();
 
-    // Get number of subscribers
-    size_t getSubscriberCount() const { return handlers_.size(); }
+    // Get number of subscribers (of all kinds, or to one event type)
+    size_t getSubscriberCount() const;
+    template<typename Event>
+    size_t getSubscriberCount() const { return handlers_[typeIndex<Event>()].size(); }
 
     // Get number of queued events
     size_t getQueueSize() const { return eventQueue_.size(); }
@@ -54,12 +74,31 @@ private:
         bool active = true;
     };
 
-    std::vector<HandlerEntry> handlers_;
+    // Handler lists: one per GameEvent alternative, then the catch-all list
+    static constexpr size_t TYPE_COUNT = std::variant_size_v<GameEvent>;
+    static constexpr size_t ALL_EVENTS = TYPE_COUNT;
+
+    // Variant index of an event type
+    template<typename Event, size_t I = 0>
+    static constexpr size_t typeIndex() {
+        static_assert(I < TYPE_COUNT, "not a GameEvent type");
+        if constexpr (std::is_same_v<Event, std::variant_alternative_t<I, GameEvent>>) {
+            return I;
+        } else {
+            return typeIndex<Event, I + 1>();
+        }
+    }
+
+    HandlerId add(size_t list, EventHandler handler);
+    void dispatch(size_t list, const GameEvent& event);
+    void remove(HandlerId id);
+
+    std::array<std::vector<HandlerEntry>, TYPE_COUNT + 1> handlers_;
     std::queue<GameEvent> eventQueue_;
     HandlerId nextId_ = 1;
 
-    // For deferred removal during iteration
-    bool isPublishing_ = false;
+    // For deferred removal during iteration (publish may nest)
+    int publishDepth_ = 0;
     std::vector<HandlerId> pendingRemovals_;
 };
 
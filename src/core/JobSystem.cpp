@@ -0,0 +1,127 @@
+#include "JobSystem.hpp"
+#include <chrono>
+
+namespace mmorpg {
+
+namespace {
+// Which pool the current thread works for, and its number there
+thread_local const JobSystem* t_pool = nullptr;
+thread_local size_t t_index = 0;
+} // namespace
+
+JobSystem::JobSystem(size_t workers) {
+    for (size_t i = 0; i <= workers; i++) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(workers);
+    for (size_t i = 1; i <= workers; i++) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t JobSystem::currentThread() const {
+    return t_pool == this ? t_index : 0;
+}
+
+void JobSystem::run(size_t begin, size_t end, size_t grain, RunFn fn, void* body) {
+    Group group;
+    group.pending.store(1, std::memory_order_relaxed);
+    size_t self = currentThread();
+    execute({fn, body, begin, end, grain > 0 ? grain : 1, &group}, self);
+
+    // Help with whatever is queued (ours or anyone's) until our pieces
+    // are done; a stolen piece may still be running elsewhere
+    Job job;
+    while (group.pending.load(std::memory_order_acquire) != 0) {
+        if (findJob(self, job)) {
+            execute(job, self);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::execute(Job job, size_t self) {
+    // Split off right halves for others to steal, run the leftmost piece
+    while (job.end - job.begin > job.grain) {
+        size_t mid = job.begin + (job.end - job.begin) / 2;
+        job.group->pending.fetch_add(1, std::memory_order_relaxed);
+        push(self, {job.run, job.body, mid, job.end, job.grain, job.group});
+        job.end = mid;
+    }
+    job.run(job.body, job.begin, job.end);
+    job.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::push(size_t self, const Job& job) {
+    {
+        std::lock_guard<std::mutex> lock(queues_[self]->mutex);
+        queues_[self]->jobs.push_back(job);
+    }
+    queued_.fetch_add(1);
+
+    // A worker about to sleep re-checks queued_ under the mutex, so it
+    // either sees this job or is already waiting for the notify
+    if (sleeping_.load() != 0) {
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        wake_.notify_one();
+    }
+}
+
+bool JobSystem::pop(size_t self, Job& job) {
+    Queue& queue = *queues_[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+    job = queue.jobs.back();
+    queue.jobs.pop_back();
+    queued_.fetch_sub(1);
+    return true;
+}
+
+bool JobSystem::steal(size_t self, Job& job) {
+    if (queued_.load() == 0) return false;
+    for (size_t i = 1; i < queues_.size(); i++) {
+        Queue& queue = *queues_[(self + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) continue;
+        job = queue.jobs.front();
+        queue.jobs.pop_front();
+        queued_.fetch_sub(1);
+        steals_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::workerLoop(size_t self) {
+    t_pool = this;
+    t_index = self;
+
+    Job job;
+    while (!stopping_.load()) {
+        if (findJob(self, job)) {
+            execute(job, self);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleeping_.fetch_add(1);
+        while (!stopping_.load() && queued_.load() == 0) {
+            wake_.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        sleeping_.fetch_sub(1);
+    }
+}
+
+} // namespace mmorpg
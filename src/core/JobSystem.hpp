@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mmorpg {
+
+// Fork/join thread pool for data-parallel passes over the simulation.
+// parallelFor() splits a range in halves down to the grain size: each
+// split pushes the right half onto the splitting thread's own deque and
+// carries on with the left, so a thread works through neighbouring
+// pieces while idle threads steal the biggest pending halves from the
+// other end. The calling thread runs pieces too until the whole range is
+// done, so nothing is handed off when the workers are busy or absent.
+//
+// Threads are numbered: 0 is any thread outside the pool (the tick
+// thread), 1..getWorkerCount() the workers. currentThread() lets a pass
+// keep per-thread scratch without locking.
+//
+// Bodies must not throw. parallelFor() may be nested inside a body; only
+// one thread outside the pool should call it at a time.
+class JobSystem {
+public:
+    // Threads besides the caller; 0 runs every range on the caller
+    explicit JobSystem(size_t workers);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    size_t getWorkerCount() const { return workers_.size(); }
+    size_t getThreadCount() const { return workers_.size() + 1; }  // Including the caller
+    size_t currentThread() const;
+
+    // Pieces taken from another thread's deque since construction
+    uint64_t getStealCount() const { return steals_.load(std::memory_order_relaxed); }
+
+    // Call body(pieceBegin, pieceEnd) over [begin, end) in pieces of at
+    // most grain indices (at least 1), or as one piece without workers;
+    // returns once every piece has run
+    template<typename Body>
+    void parallelFor(size_t begin, size_t end, size_t grain, Body&& body) {
+        if (begin >= end) return;
+        if (workers_.empty() || end - begin <= grain) {
+            body(begin, end);
+            return;
+        }
+        using B = std::remove_reference_t<Body>;
+        run(begin, end, grain,
+            [](void* b, size_t first, size_t last) { (*static_cast<B*>(b))(first, last); },
+            const_cast<void*>(static_cast<const void*>(std::addressof(body))));
+    }
+
+private:
+    using RunFn = void (*)(void* body, size_t begin, size_t end);
+
+    struct Group {
+        std::atomic<size_t> pending{0};  // Pieces not yet finished
+    };
+
+    struct Job {
+        RunFn run;
+        void* body;
+        size_t begin;
+        size_t end;
+        size_t grain;
+        Group* group;
+    };
+
+    // Owner pushes/pops at the back, thieves take from the front
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void run(size_t begin, size_t end, size_t grain, RunFn fn, void* body);
+    void execute(Job job, size_t self);
+    void push(size_t self, const Job& job);
+    bool pop(size_t self, Job& job);
+    bool steal(size_t self, Job& job);
+    bool findJob(size_t self, Job& job) { return pop(self, job) || steal(self, job); }
+    void workerLoop(size_t self);
+
+    std::vector<std::unique_ptr<Queue>> queues_;  // One per thread, caller's first
+    std::vector<std::thread> workers_;
+
+    // Sleeping workers wait for queued_ to become non-zero
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> sleeping_{0};
+    std::atomic<bool> stopping_{false};
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+
+    std::atomic<uint64_t> steals_{0};
+};
+
+} // namespace mmorpg
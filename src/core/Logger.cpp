@@ -0,0 +1,211 @@
+#include "Logger.hpp"
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <ctime>
+#include <unistd.h>
+
+namespace mmorpg {
+
+LogRecord& LogRecord::operator<<(double value) {
+    char text[32];
+    int n = std::snprintf(text, sizeof(text), "%g", value);
+    return *this << std::string_view(text, n > 0 ? static_cast<size_t>(n) : 0);
+}
+
+LogRecord& LogRecord::appendInteger(bool negative, uint64_t magnitude) {
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* p = end;
+    do {
+        *--p = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (negative) {
+        *--p = '-';
+    }
+    return *this << std::string_view(p, static_cast<size_t>(end - p));
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() {
+    writer_ = std::thread([this] { writerLoop(); });
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
+Logger::RingHandle::~RingHandle() {
+    if (ring) {
+        ring->closed.store(true, std::memory_order_release);
+    }
+}
+
+const char* Logger::levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info:  return "INFO";
+        case LogLevel::Warn:  return "WARN";
+        case LogLevel::Error: return "ERROR";
+        case LogLevel::Off:   return "OFF";
+    }
+    return "?";
+}
+
+bool Logger::parseLevel(std::string_view name, LogLevel& level) {
+    for (auto candidate : {LogLevel::Trace, LogLevel::Debug, LogLevel::Info,
+                           LogLevel::Warn, LogLevel::Error, LogLevel::Off}) {
+        std::string_view expected = levelName(candidate);
+        if (name.size() == expected.size() &&
+            std::equal(name.begin(), name.end(), expected.begin(),
+                       [](char a, char b) { return std::toupper(static_cast<unsigned char>(a)) == b; })) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Logger::setOutput(int fd) {
+    flush();
+    outputFd_.store(fd, std::memory_order_relaxed);
+}
+
+Logger::ThreadRing& Logger::localRing() {
+    thread_local RingHandle handle;
+    if (!handle.ring) {
+        handle.ring = std::make_shared<ThreadRing>();
+        std::lock_guard<std::mutex> lock(mutex_);
+        rings_.push_back(handle.ring);
+    }
+    return *handle.ring;
+}
+
+void Logger::submit(const LogRecord& record) {
+    // The writer polls the rings, so the hot path makes no syscalls
+    if (!localRing().records.tryPush(record)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Logger::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopping_) return;
+    uint64_t ticket = ++flushRequested_;
+    wake_.notify_one();
+    flushed_.wait_for(lock, FLUSH_TIMEOUT, [&] { return flushCompleted_ >= ticket || stopping_; });
+}
+
+void Logger::writerLoop() {
+    std::string out;
+    std::string err;
+    out.reserve(64 * 1024);
+    err.reserve(16 * 1024);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        uint64_t ticket = flushRequested_;
+        bool stopping = stopping_;
+        lock.unlock();
+
+        // Keep draining until a pass comes up empty, so a flush also
+        // covers records pushed while the previous batch was written
+        while (drain(out, err) > 0) {
+            writeAll(STDOUT_FILENO, out);
+            writeAll(STDERR_FILENO, err);
+        }
+
+        lock.lock();
+        flushCompleted_ = ticket;
+        flushed_.notify_all();
+        if (stopping) break;
+        wake_.wait_for(lock, std::chrono::milliseconds(10), [&] {
+            return stopping_ || flushRequested_ != ticket;
+        });
+    }
+}
+
+size_t Logger::drain(std::string& out, std::string& err) {
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Forget threads that have exited once their last records are out
+        rings_.erase(std::remove_if(rings_.begin(), rings_.end(), [](const auto& ring) {
+            return ring->closed.load(std::memory_order_acquire) && ring->records.empty();
+        }), rings_.end());
+        rings = rings_;
+    }
+
+    int fd = outputFd_.load(std::memory_order_relaxed);
+    auto format = [&](const LogRecord& record) {
+        std::string& batch = fd < 0 && record.getLevel() < LogLevel::Warn ? out : err;
+
+        auto time = record.getTime();
+        std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+            time.time_since_epoch()).count() % 1000;
+        std::tm local{};
+        localtime_r(&seconds, &local);
+        char prefix[48];
+        std::strftime(prefix, sizeof(prefix), "%Y-%m-%d %H:%M:%S", &local);
+        char suffix[24];
+        std::snprintf(suffix, sizeof(suffix), ".%03d %-5s ", static_cast<int>(millis), levelName(record.getLevel()));
+
+        batch += prefix;
+        batch += suffix;
+        batch += record.getMessage();
+        batch += '\n';
+    };
+
+    size_t count = 0;
+    LogRecord record;
+    for (auto& ring : rings) {
+        while (ring->records.tryPop(record)) {
+            format(record);
+            count++;
+        }
+    }
+
+    uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != droppedReported_) {
+        LogRecord notice(LogLevel::Warn);
+        notice << "Logger dropped " << (dropped - droppedReported_) << " records (rings full)";
+        format(notice);
+        droppedReported_ = dropped;
+        count++;
+    }
+    return count;
+}
+
+void Logger::writeAll(int fd, std::string& batch) {
+    int target = outputFd_.load(std::memory_order_relaxed);
+    if (target >= 0) {
+        fd = target;
+    }
+
+    size_t written = 0;
+    while (written < batch.size()) {
+        ssize_t n = ::write(fd, batch.data() + written, batch.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;  // Nowhere left to report it
+        }
+        written += static_cast<size_t>(n);
+    }
+    batch.clear();
+}
+
+} // namespace mmorpg
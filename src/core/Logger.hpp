@@ -0,0 +1,184 @@
+#pragma once
+
+#include "SpscQueue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mmorpg {
+
+enum class LogLevel : uint8_t {
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off
+};
+
+// One formatted log line. Built on the caller's stack with operator<<,
+// like an ostream, but into a fixed buffer: no allocation, no locale,
+// and overlong messages are truncated.
+class LogRecord {
+public:
+    static constexpr size_t MAX_MESSAGE = 240;
+
+    LogRecord() = default;
+    explicit LogRecord(LogLevel level)
+        : level_(level)
+        , time_(std::chrono::system_clock::now()) {
+    }
+
+    LogRecord& operator<<(std::string_view text) {
+        size_t n = std::min(text.size(), MAX_MESSAGE - length_);
+        std::memcpy(text_ + length_, text.data(), n);
+        length_ += static_cast<uint16_t>(n);
+        return *this;
+    }
+    LogRecord& operator<<(const char* text) { return *this << std::string_view(text ? text : "(null)"); }
+    LogRecord& operator<<(const std::string& text) { return *this << std::string_view(text); }
+    LogRecord& operator<<(char c) { return *this << std::string_view(&c, 1); }
+    LogRecord& operator<<(bool value) { return *this << (value ? "true" : "false"); }
+    LogRecord& operator<<(double value);
+
+    template<typename T, typename = std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>>
+    LogRecord& operator<<(T value) {
+        if constexpr (std::is_enum_v<T>) {
+            return *this << static_cast<std::underlying_type_t<T>>(value);
+        } else if constexpr (std::is_signed_v<T>) {
+            return appendInteger(static_cast<int64_t>(value) < 0, absolute(static_cast<int64_t>(value)));
+        } else {
+            return appendInteger(false, static_cast<uint64_t>(value));
+        }
+    }
+
+    LogLevel getLevel() const { return level_; }
+    std::chrono::system_clock::time_point getTime() const { return time_; }
+    std::string_view getMessage() const { return {text_, length_}; }
+
+private:
+    static uint64_t absolute(int64_t value) {
+        return value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    }
+
+    LogRecord& appendInteger(bool negative, uint64_t magnitude);
+
+    LogLevel level_ = LogLevel::Info;
+    uint16_t length_ = 0;
+    std::chrono::system_clock::time_point time_{};
+    char text_[MAX_MESSAGE];
+};
+
+// Asynchronous logger.
+// Each logging thread pushes finished records into its own lock-free
+// ring; a background thread formats them and writes each batch with a
+// single write(). Logging never blocks the caller: when a ring is full
+// the record is dropped and counted, and the writer reports the count.
+// Records below MMORPG_LOG_LEVEL are compiled out; the runtime level
+// filters the rest.
+class Logger {
+public:
+    // Records buffered per thread before new ones are dropped
+    static constexpr size_t RING_CAPACITY = 1024;
+
+    static Logger& instance();
+
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void setLevel(LogLevel level) { level_.store(level, std::memory_order_relaxed); }
+    LogLevel getLevel() const { return level_.load(std::memory_order_relaxed); }
+    bool shouldLog(LogLevel level) const { return level >= getLevel(); }
+
+    // Send everything to one file descriptor. By default (-1) Warn and
+    // Error go to stderr and the rest to stdout.
+    void setOutput(int fd);
+
+    // Queue a record from any thread; never blocks
+    void submit(const LogRecord& record);
+
+    // Block until everything submitted before the call has been written,
+    // or FLUSH_TIMEOUT passes (the output may be a stuck pipe)
+    static constexpr std::chrono::seconds FLUSH_TIMEOUT{5};
+    void flush();
+
+    // Records lost to full rings
+    uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+    static const char* levelName(LogLevel level);
+
+    // "trace" ... "off", case-insensitive; false if unrecognised
+    static bool parseLevel(std::string_view name, LogLevel& level);
+
+private:
+    struct ThreadRing {
+        SpscQueue<LogRecord> records{RING_CAPACITY};
+        std::atomic<bool> closed{false};  // Owning thread has exited
+    };
+
+    // Registers the calling thread's ring; closes it when the thread exits
+    struct RingHandle {
+        std::shared_ptr<ThreadRing> ring;
+        ~RingHandle();
+    };
+
+    Logger();
+
+    ThreadRing& localRing();
+    void writerLoop();
+
+    // Format everything currently queued into the batches; returns the record count
+    size_t drain(std::string& out, std::string& err);
+    void writeAll(int fd, std::string& batch);
+
+    std::atomic<LogLevel> level_{LogLevel::Info};
+    std::atomic<int> outputFd_{-1};
+    std::atomic<uint64_t> dropped_{0};
+    uint64_t droppedReported_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    std::vector<std::shared_ptr<ThreadRing>> rings_;
+    uint64_t flushRequested_ = 0;
+    uint64_t flushCompleted_ = 0;
+    bool stopping_ = false;
+
+    std::thread writer_;
+};
+
+} // namespace mmorpg
+
+// Lowest level compiled in (0 = Trace ... 5 = Off)
+#ifndef MMORPG_LOG_LEVEL
+#define MMORPG_LOG_LEVEL 1
+#endif
+
+#define MMORPG_LOG(level, expr)                                                        \
+    do {                                                                               \
+        if constexpr (static_cast<int>(level) >= MMORPG_LOG_LEVEL) {                   \
+            if (::mmorpg::Logger::instance().shouldLog(level)) {                       \
+                ::mmorpg::LogRecord logRecord_(level);                                 \
+                logRecord_ << expr;                                                    \
+                ::mmorpg::Logger::instance().submit(logRecord_);                       \
+            }                                                                          \
+        }                                                                              \
+    } while (0)
+
+#define LOG_TRACE(expr) MMORPG_LOG(::mmorpg::LogLevel::Trace, expr)
+#define LOG_DEBUG(expr) MMORPG_LOG(::mmorpg::LogLevel::Debug, expr)
+#define LOG_INFO(expr) MMORPG_LOG(::mmorpg::LogLevel::Info, expr)
+#define LOG_WARN(expr) MMORPG_LOG(::mmorpg::LogLevel::Warn, expr)
+#define LOG_ERROR(expr) MMORPG_LOG(::mmorpg::LogLevel::Error, expr)
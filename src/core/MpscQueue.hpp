@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace mmorpg {
+
+// Bounded lock-free multi-producer/single-consumer queue.
+// Array of sequenced cells (Vyukov): producers claim a slot with a CAS on the
+// tail, the single consumer reads in order without contention.
+// Capacity is rounded up to a power of two.
+template<typename T>
+class MpscQueue {
+public:
+    explicit MpscQueue(size_t capacity)
+        : capacity_(roundUp(capacity))
+        , mask_(capacity_ - 1)
+        , cells_(std::make_unique<Cell[]>(capacity_)) {
+        for (size_t i = 0; i < capacity_; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any thread. Returns false if the queue is full.
+    bool tryPush(T value) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only. Returns false if the queue is empty (or the next
+    // producer has claimed its slot but not finished writing it).
+    bool tryPop(T& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[head & mask_];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (seq != head + 1) {
+            return false;
+        }
+
+        out = std::move(cell.value);
+        cell.value = T{};  // Release held resources now, not on reuse
+        cell.sequence.store(head + capacity_, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Approximate when called concurrently
+    size_t size() const {
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t head = head_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    static size_t roundUp(size_t n) {
+        size_t cap = 2;
+        while (cap < n) cap <<= 1;
+        return cap;
+    }
+
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(CACHE_LINE) std::atomic<size_t> tail_{0};
+    alignas(CACHE_LINE) std::atomic<size_t> head_{0};  // Written by the consumer only
+};
+
+} // namespace mmorpg
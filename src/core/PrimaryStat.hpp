@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace mmorpg {
+
+// Primary stat identifiers, usable as array indices. Shared by actors
+// (PrimaryStats) and skills (buff targets in data files and snapshots).
+enum class PrimaryStat : uint8_t {
+    Strength,
+    Agility,
+    Intelligence,
+    Vitality,
+    Wisdom,
+    Luck,
+    Count
+};
+
+constexpr size_t PRIMARY_STAT_COUNT = static_cast<size_t>(PrimaryStat::Count);
+
+// Names used by data files and tools, in PrimaryStat order
+constexpr const char* PRIMARY_STAT_NAMES[PRIMARY_STAT_COUNT] = {
+    "strength", "agility", "intelligence", "vitality", "wisdom", "luck"
+};
+
+constexpr const char* primaryStatName(PrimaryStat stat) {
+    size_t index = static_cast<size_t>(stat);
+    return index < PRIMARY_STAT_COUNT ? PRIMARY_STAT_NAMES[index] : "?";
+}
+
+constexpr bool parsePrimaryStat(std::string_view name, PrimaryStat& stat) {
+    for (size_t i = 0; i < PRIMARY_STAT_COUNT; i++) {
+        if (name == PRIMARY_STAT_NAMES[i]) {
+            stat = static_cast<PrimaryStat>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace mmorpg
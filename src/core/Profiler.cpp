@@ -0,0 +1,153 @@
+#include "Profiler.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <tuple>
+
+namespace mmorpg {
+
+namespace {
+
+void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// Chrome traces use microseconds
+void writeMicros(std::ostream& out, uint64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03llu",
+                  static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    out << text;
+}
+
+} // namespace
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : epoch_(Clock::now()) {
+}
+
+Profiler::ThreadBuffer& Profiler::localBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer->tid = static_cast<uint32_t>(buffers_.size() + 1);
+        buffers_.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void Profiler::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer& buffer = localBuffer();
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    Zone& zone = buffer.zones[head & (RING_CAPACITY - 1)];
+    zone.name.store(name, std::memory_order_relaxed);
+    zone.start.store(startNs, std::memory_order_relaxed);
+    zone.end.store(endNs, std::memory_order_relaxed);
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(std::string name) {
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer.name = std::move(name);
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        LOG_ERROR("Cannot write trace to " << path);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    size_t zones = 0;
+
+    for (const auto& buffer : buffers_) {
+        if (!buffer->name.empty()) {
+            out << (first ? "" : ",") << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+                << buffer->tid << ",\"args\":{\"name\":";
+            writeJsonString(out, buffer->name);
+            out << "}}";
+            first = false;
+        }
+
+        // The owning thread keeps recording while we read; anything it
+        // overwrote during the copy is dropped rather than reported torn
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+        std::vector<std::tuple<const char*, uint64_t, uint64_t>> copied;
+        copied.reserve(static_cast<size_t>(head - begin));
+        for (uint64_t i = begin; i < head; i++) {
+            const Zone& zone = buffer->zones[i & (RING_CAPACITY - 1)];
+            copied.emplace_back(zone.name.load(std::memory_order_relaxed),
+                                zone.start.load(std::memory_order_relaxed),
+                                zone.end.load(std::memory_order_relaxed));
+        }
+        uint64_t after = buffer->head.load(std::memory_order_acquire);
+        uint64_t valid = after >= RING_CAPACITY ? after - RING_CAPACITY + 1 : 0;
+
+        for (uint64_t i = std::max(begin, valid); i < head; i++) {
+            auto [name, start, end] = copied[static_cast<size_t>(i - begin)];
+            out << (first ? "" : ",") << "\n{\"ph\":\"X\",\"name\":";
+            writeJsonString(out, name ? name : "?");
+            out << ",\"pid\":1,\"tid\":" << buffer->tid << ",\"ts\":";
+            writeMicros(out, start);
+            out << ",\"dur\":";
+            writeMicros(out, end - start);
+            out << "}";
+            first = false;
+            zones++;
+        }
+    }
+
+    out << "\n]}\n";
+    if (!out) {
+        LOG_ERROR("Failed writing trace to " << path);
+        return false;
+    }
+
+    LOG_INFO("Wrote " << zones << " profiler zones to " << path);
+    return true;
+}
+
+size_t Profiler::getZoneCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t zones = 0;
+    for (const auto& buffer : buffers_) {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        zones += static_cast<size_t>(std::min<uint64_t>(head, RING_CAPACITY));
+    }
+    return zones;
+}
+
+void Profiler::clear() {
+    // Only meaningful while no other thread is recording
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& buffer : buffers_) {
+        buffer->head.store(0, std::memory_order_release);
+    }
+}
+
+} // namespace mmorpg
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mmorpg {
+
+// Scoped-zone profiler for the game loop.
+// PROFILE_ZONE("name") records the enclosing scope's start and duration
+// in nanoseconds into a ring buffer owned by the calling thread, so
+// recording takes no locks. writeChromeTrace() snapshots every thread's
+// ring into a Chrome trace_event JSON file (chrome://tracing, Perfetto).
+// Zone names must be string literals (only the pointer is stored).
+// Configure with -DMMORPG_PROFILER=OFF to compile every zone out.
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Zones kept per thread; older ones are overwritten
+    static constexpr size_t RING_CAPACITY = 1 << 16;
+
+    static Profiler& instance();
+
+    // Recording can also be paused at runtime (on by default)
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // Nanoseconds since the profiler was created
+    uint64_t now() const {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - epoch_).count());
+    }
+
+    // Append a finished zone to the calling thread's ring
+    void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Label the calling thread in traces
+    void setThreadName(std::string name);
+
+    // Write the buffered zones of all threads; false if the file can't be written
+    bool writeChromeTrace(const std::string& path) const;
+
+    // Async-signal-safe: ask the game loop to dump a trace at its next
+    // opportunity (see takeDumpRequest)
+    void requestDump() { dumpRequested_.store(true, std::memory_order_relaxed); }
+    bool takeDumpRequest() { return dumpRequested_.exchange(false, std::memory_order_relaxed); }
+
+    // Zones currently buffered across all threads
+    size_t getZoneCount() const;
+
+    // Drop everything recorded so far
+    void clear();
+
+private:
+    // Written only by the owning thread; fields are atomic so a concurrent
+    // dump reads whole values (relaxed stores are plain moves)
+    struct Zone {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> start{0};
+        std::atomic<uint64_t> end{0};
+    };
+
+    struct ThreadBuffer {
+        uint32_t tid = 0;
+        std::string name;
+        std::atomic<uint64_t> head{0};  // Zones ever recorded
+        std::unique_ptr<Zone[]> zones = std::make_unique<Zone[]>(RING_CAPACITY);
+    };
+
+    Profiler();
+
+    ThreadBuffer& localBuffer();
+
+    Clock::time_point epoch_;
+    std::atomic<bool> enabled_{true};
+    std::atomic<bool> dumpRequested_{false};
+
+    // Buffers outlive their threads so late dumps still see their zones
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+// Records one zone for the lifetime of the object
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name)
+        : name_(name)
+        , active_(Profiler::instance().isEnabled())
+        , start_(active_ ? Profiler::instance().now() : 0) {
+    }
+
+    ~ProfileZone() {
+        if (active_) {
+            Profiler::instance().record(name_, start_, Profiler::instance().now());
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name_;
+    bool active_;
+    uint64_t start_;
+};
+
+} // namespace mmorpg
+
+#define MMORPG_PROFILE_CONCAT_(a, b) a##b
+#define MMORPG_PROFILE_CONCAT(a, b) MMORPG_PROFILE_CONCAT_(a, b)
+
+#if MMORPG_PROFILER
+#define PROFILE_ZONE(name) ::mmorpg::ProfileZone MMORPG_PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
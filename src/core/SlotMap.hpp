@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace mmorpg {
+
+// Generational slot map.
+// Values live in a dense array (iteration is a linear scan); a handle
+// names a slot, and the slot points at the value's dense position.
+// Insert, erase and lookup are O(1): erase moves the last value into the
+// hole. Each slot carries a generation that is bumped when its value is
+// erased, so a stale handle to a reused slot fails the lookup instead of
+// finding the new occupant.
+//
+// A handle packs the slot number in its low INDEX_BITS and the generation
+// above it. Slot 0 is never used, so handle 0 is always invalid and fresh
+// slots hand out 1, 2, 3, ... until the first reuse.
+template<typename T, typename Handle = uint32_t>
+class SlotMap {
+public:
+    static constexpr unsigned INDEX_BITS = 18;
+    static constexpr Handle INDEX_MASK = (Handle{1} << INDEX_BITS) - 1;
+    static constexpr size_t MAX_SLOTS = size_t{INDEX_MASK};  // Slot 0 reserved
+    static constexpr Handle GENERATION_MASK = static_cast<Handle>(~Handle{0}) >> INDEX_BITS;
+
+    SlotMap() {
+        slots_.push_back({});  // Reserved slot 0
+    }
+
+    // Handle the next insert will return (0 if full)
+    Handle nextHandle() const {
+        if (freeHead_ != 0) {
+            return makeHandle(freeHead_, slots_[freeHead_].generation);
+        }
+        if (slots_.size() > MAX_SLOTS) return 0;
+        return makeHandle(static_cast<Handle>(slots_.size()), 0);
+    }
+
+    // Returns 0 when every slot is in use
+    Handle insert(T value) {
+        Handle handle = nextHandle();
+        if (handle == 0) return 0;
+
+        Handle index = handle & INDEX_MASK;
+        if (index == slots_.size()) {
+            slots_.push_back({});
+        } else {
+            freeHead_ = slots_[index].next;
+        }
+
+        Slot& slot = slots_[index];
+        slot.dense = static_cast<uint32_t>(values_.size());
+        slot.occupied = true;
+        values_.push_back(std::move(value));
+        handles_.push_back(handle);
+        return handle;
+    }
+
+    bool erase(Handle handle) {
+        Handle index = indexOf(handle);
+        if (index == 0) return false;
+
+        // Move the last value into the hole
+        Slot& slot = slots_[index];
+        uint32_t hole = slot.dense;
+        uint32_t last = static_cast<uint32_t>(values_.size() - 1);
+        if (hole != last) {
+            values_[hole] = std::move(values_[last]);
+            handles_[hole] = handles_[last];
+            slots_[handles_[hole] & INDEX_MASK].dense = hole;
+        }
+        values_.pop_back();
+        handles_.pop_back();
+
+        slot.occupied = false;
+        slot.generation = (slot.generation + 1) & GENERATION_MASK;
+        slot.next = freeHead_;
+        freeHead_ = index;
+        return true;
+    }
+
+    // nullptr for unknown or stale handles
+    T* get(Handle handle) {
+        Handle index = indexOf(handle);
+        return index ? &values_[slots_[index].dense] : nullptr;
+    }
+    const T* get(Handle handle) const {
+        Handle index = indexOf(handle);
+        return index ? &values_[slots_[index].dense] : nullptr;
+    }
+
+    bool contains(Handle handle) const { return get(handle) != nullptr; }
+
+    size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+
+    void reserve(size_t count) {
+        values_.reserve(count);
+        handles_.reserve(count);
+        slots_.reserve(count + 1);
+    }
+
+    // Drops every value. Generations survive, so old handles stay invalid.
+    void clear() {
+        while (!handles_.empty()) {
+            erase(handles_.back());
+        }
+    }
+
+    // Dense storage, in no particular order; handles() is parallel to values()
+    std::vector<T>& values() { return values_; }
+    const std::vector<T>& values() const { return values_; }
+    const std::vector<Handle>& handles() const { return handles_; }
+
+    auto begin() { return values_.begin(); }
+    auto end() { return values_.end(); }
+    auto begin() const { return values_.begin(); }
+    auto end() const { return values_.end(); }
+
+private:
+    struct Slot {
+        uint32_t dense = 0;       // Position in values_ while occupied
+        Handle next = 0;          // Next free slot while vacant
+        Handle generation = 0;
+        bool occupied = false;
+    };
+
+    static Handle makeHandle(Handle index, Handle generation) {
+        return static_cast<Handle>((generation << INDEX_BITS) | index);
+    }
+
+    // Slot of a live handle, 0 if unknown or stale
+    Handle indexOf(Handle handle) const {
+        Handle index = handle & INDEX_MASK;
+        if (index == 0 || index >= slots_.size()) return 0;
+        const Slot& slot = slots_[index];
+        if (!slot.occupied || slot.generation != (handle >> INDEX_BITS)) return 0;
+        return index;
+    }
+
+    std::vector<Slot> slots_;
+    std::vector<T> values_;
+    std::vector<Handle> handles_;
+    Handle freeHead_ = 0;  // Head of the vacant-slot list (0 = none)
+};
+
+} // namespace mmorpg
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace mmorpg {
+
+// Bounded lock-free single-producer/single-consumer ring.
+// Capacity is rounded up to a power of two. tryPush() must only be called
+// from one thread and tryPop() from one (other) thread.
+template<typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+        : capacity_(roundUp(capacity))
+        , mask_(capacity_ - 1)
+        , slots_(std::make_unique<T[]>(capacity_)) {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side. Returns false if the queue is full.
+    bool tryPush(T value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == capacity_) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == capacity_) {
+                return false;
+            }
+        }
+
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false if the queue is empty.
+    bool tryPop(T& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) {
+                return false;
+            }
+        }
+
+        out = std::move(slots_[head & mask_]);
+        slots_[head & mask_] = T{};  // Release held resources now, not on reuse
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called concurrently
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    static size_t roundUp(size_t n) {
+        size_t cap = 2;
+        while (cap < n) cap <<= 1;
+        return cap;
+    }
+
+    static constexpr size_t CACHE_LINE = 64;
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+
+    // Producer and consumer indices live on separate cache lines, each next
+    // to the side's cached copy of the other index
+    alignas(CACHE_LINE) std::atomic<size_t> tail_{0};
+    size_t headCache_ = 0;
+    alignas(CACHE_LINE) std::atomic<size_t> head_{0};
+    size_t tailCache_ = 0;
+};
+
+} // namespace mmorpg
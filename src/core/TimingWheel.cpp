@@ -0,0 +1,192 @@
+#include "TimingWheel.hpp"
+#include <cmath>
+
+namespace mmorpg {
+
+TimingWheel::TimingWheel(uint32_t tickRate) {
+    heads_.fill(NIL);
+    setTickRate(tickRate);
+}
+
+TimingWheel::TimerId TimingWheel::schedule(Tick delay, Callback callback) {
+    return scheduleAt(currentTick_ + (delay > 0 ? delay : 1), std::move(callback));
+}
+
+TimingWheel::TimerId TimingWheel::scheduleAt(Tick when, Callback callback) {
+    uint32_t index;
+    if (freeHead_ != NIL) {
+        index = freeHead_;
+        freeHead_ = nodes_[index].next;
+    } else {
+        index = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+
+    Node& node = nodes_[index];
+    node.expires = when > currentTick_ ? when : currentTick_ + 1;
+    node.callback = std::move(callback);
+    place(index);
+    size_++;
+    return makeId(index, node.generation);
+}
+
+const TimingWheel::Node* TimingWheel::findNode(TimerId id) const {
+    if (id == INVALID_TIMER) return nullptr;
+    uint64_t index = (id & 0xFFFFFFFFu) - 1;
+    if (index >= nodes_.size()) return nullptr;
+    const Node& node = nodes_[index];
+    if (node.generation != static_cast<uint32_t>(id >> 32) || node.slot == NIL) return nullptr;
+    return &node;
+}
+
+bool TimingWheel::cancel(TimerId id) {
+    if (!findNode(id)) return false;
+    uint32_t index = static_cast<uint32_t>((id & 0xFFFFFFFFu) - 1);
+    unlink(index);
+    nodes_[index].callback = nullptr;
+    release(index);
+    size_--;
+    return true;
+}
+
+bool TimingWheel::isPending(TimerId id) const {
+    return findNode(id) != nullptr;
+}
+
+Tick TimingWheel::getExpiry(TimerId id) const {
+    const Node* node = findNode(id);
+    return node ? node->expires : 0;
+}
+
+size_t TimingWheel::advance(Tick now) {
+    size_t fired = 0;
+    while (currentTick_ < now) {
+        // Nothing scheduled: jump straight there
+        if (size_ == 0) {
+            currentTick_ = now;
+            break;
+        }
+
+        currentTick_++;
+
+        // Crossing into a new span of a higher level pulls that level's
+        // slot down, from the top so a timer can fall several levels
+        size_t top = 0;
+        while (top + 1 < LEVELS && ((currentTick_ >> (LEVEL_BITS * (top + 1))) << (LEVEL_BITS * (top + 1))) == currentTick_) {
+            top++;
+        }
+        for (size_t level = top; level > 0; level--) {
+            cascade(level);
+        }
+
+        fired += fireCurrentSlot();
+    }
+    return fired;
+}
+
+void TimingWheel::clear() {
+    for (uint32_t& head : heads_) {
+        while (head != NIL) {
+            uint32_t index = head;
+            head = nodes_[index].next;
+            nodes_[index].slot = NIL;
+            nodes_[index].callback = nullptr;
+            release(index);
+        }
+    }
+    size_ = 0;
+}
+
+Tick TimingWheel::toTicks(float seconds, uint32_t tickRate) {
+    if (seconds <= 0.0f) return 0;
+    // The slack keeps float error (0.1f * 20 = 2.0000000298) from adding a tick
+    auto ticks = static_cast<Tick>(std::ceil(static_cast<double>(seconds) * tickRate - 1e-4));
+    return ticks > 0 ? ticks : 1;
+}
+
+void TimingWheel::place(uint32_t index) {
+    // The lowest level whose span still reaches the expiry. Within that
+    // level the slot is never the current one, so it comes around (and
+    // cascades) exactly at the start of the expiry's span.
+    Tick expires = nodes_[index].expires;
+    for (size_t level = 0; level < LEVELS; level++) {
+        unsigned shift = static_cast<unsigned>(LEVEL_BITS * level);
+        Tick distance = (expires >> shift) - (currentTick_ >> shift);
+        if (distance < SLOTS) {
+            link(index, static_cast<uint32_t>(level * SLOTS + ((expires >> shift) & (SLOTS - 1))));
+            return;
+        }
+    }
+
+    // Beyond the horizon: the farthest top-level slot, re-placed when it cascades
+    unsigned shift = static_cast<unsigned>(LEVEL_BITS * (LEVELS - 1));
+    Tick farthest = (currentTick_ >> shift) + (SLOTS - 1);
+    link(index, static_cast<uint32_t>((LEVELS - 1) * SLOTS + (farthest & (SLOTS - 1))));
+}
+
+void TimingWheel::link(uint32_t index, uint32_t slot) {
+    Node& node = nodes_[index];
+    node.slot = slot;
+    node.prev = NIL;
+    node.next = heads_[slot];
+    if (node.next != NIL) {
+        nodes_[node.next].prev = index;
+    }
+    heads_[slot] = index;
+}
+
+void TimingWheel::unlink(uint32_t index) {
+    Node& node = nodes_[index];
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[node.slot] = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    }
+    node.slot = NIL;
+}
+
+void TimingWheel::release(uint32_t index) {
+    Node& node = nodes_[index];
+    node.generation++;  // Outstanding ids stop matching
+    node.prev = NIL;
+    node.next = freeHead_;
+    freeHead_ = index;
+}
+
+void TimingWheel::cascade(size_t level) {
+    unsigned shift = static_cast<unsigned>(LEVEL_BITS * level);
+    uint32_t slot = static_cast<uint32_t>(level * SLOTS + ((currentTick_ >> shift) & (SLOTS - 1)));
+
+    uint32_t index = heads_[slot];
+    heads_[slot] = NIL;
+    while (index != NIL) {
+        uint32_t next = nodes_[index].next;
+        place(index);
+        index = next;
+    }
+}
+
+size_t TimingWheel::fireCurrentSlot() {
+    // Everything due this tick is in one level-0 slot. Each timer is
+    // unlinked and freed before its callback runs, so callbacks may
+    // schedule (always into a later slot) or cancel timers still waiting
+    // in this batch.
+    uint32_t slot = static_cast<uint32_t>(currentTick_ & (SLOTS - 1));
+    size_t fired = 0;
+    while (heads_[slot] != NIL) {
+        uint32_t index = heads_[slot];
+        unlink(index);
+        Callback callback = std::move(nodes_[index].callback);
+        nodes_[index].callback = nullptr;
+        release(index);
+        size_--;
+        callback();
+        fired++;
+    }
+    return fired;
+}
+
+} // namespace mmorpg
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Types.hpp"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace mmorpg {
+
+// Hierarchical timing wheel at game-tick granularity.
+// Four levels of 256 slots cover 2^32 ticks; a timer sits in the level
+// whose slot span matches its distance and drops a level each time that
+// slot comes around ("cascade"), reaching level 0 on its expiry tick.
+// Schedule and cancel are O(1) (intrusive lists over a node pool), and
+// advance() fires the timers due at a tick as one batch: a single slot
+// drained in no particular order. Callbacks may schedule and cancel
+// freely, but must not advance the wheel they run on.
+//
+// Timers further than 2^32 ticks out park in the top level and are
+// re-placed each time around.
+class TimingWheel {
+public:
+    using Callback = std::function<void()>;
+    using TimerId = uint64_t;
+    static constexpr TimerId INVALID_TIMER = 0;
+
+    static constexpr unsigned LEVEL_BITS = 8;
+    static constexpr size_t SLOTS = size_t{1} << LEVEL_BITS;
+    static constexpr size_t LEVELS = 4;
+    static constexpr uint32_t DEFAULT_TICK_RATE = 20;
+
+    explicit TimingWheel(uint32_t tickRate = DEFAULT_TICK_RATE);
+
+    // Non-copyable (callbacks usually capture their owner)
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    // Fire delay ticks from now; a delay of 0 fires at the next tick
+    TimerId schedule(Tick delay, Callback callback);
+    // Fire at an absolute tick; past ticks fire at the next tick
+    TimerId scheduleAt(Tick when, Callback callback);
+
+    // False if the timer already fired or was cancelled
+    bool cancel(TimerId id);
+    bool isPending(TimerId id) const;
+    Tick getExpiry(TimerId id) const;  // 0 unless pending
+
+    // Move the clock to now, firing everything due on the way.
+    // Returns the number of callbacks run.
+    size_t advance(Tick now);
+
+    Tick getCurrentTick() const { return currentTick_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Cancel every timer (the clock keeps its position)
+    void clear();
+
+    // Game-time conversion for callers that think in seconds
+    void setTickRate(uint32_t tickRate) { tickRate_ = tickRate > 0 ? tickRate : 1; }
+    uint32_t getTickRate() const { return tickRate_; }
+    Tick toTicks(float seconds) const { return toTicks(seconds, tickRate_); }
+    static Tick toTicks(float seconds, uint32_t tickRate);  // Rounded up; positive durations are at least 1 tick
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        Tick expires = 0;
+        Callback callback;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;   // Also links the free list
+        uint32_t slot = NIL;   // Index into heads_ while scheduled
+        uint32_t generation = 0;
+    };
+
+    static TimerId makeId(uint32_t index, uint32_t generation) {
+        return (static_cast<TimerId>(generation) << 32) | (static_cast<TimerId>(index) + 1);
+    }
+    const Node* findNode(TimerId id) const;
+
+    void place(uint32_t index);
+    void link(uint32_t index, uint32_t slot);
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+    void cascade(size_t level);
+    size_t fireCurrentSlot();
+
+    std::vector<Node> nodes_;
+    uint32_t freeHead_ = NIL;
+    std::array<uint32_t, LEVELS * SLOTS> heads_;
+    Tick currentTick_ = 0;
+    size_t size_ = 0;
+    uint32_t tickRate_;
+};
+
+} // namespace mmorpg
@@ -1,27 +1,37 @@
 #include "server/GameServer.hpp"
+#include "core/Logger.hpp"
+#include "core/Profiler.hpp"
 #include <iostream>
 #include <csignal>
 #include <cstring>
 
 mmorpg::GameServer* g_server = nullptr;
+volatile std::sig_atomic_t g_signal = 0;
 
 void signalHandler(int signal) {
-    std::cout << "\nReceived signal " << signal << ", shutting down..." << std::endl;
+    // Logged once run() returns; the logger is not async-signal-safe
+    g_signal = signal;
     if (g_server) {
         g_server->shutdown();
     }
 }
 
+void dumpSignalHandler(int) {
+    // The game loop writes the trace at the end of its next tick
+    mmorpg::Profiler::instance().requestDump();
+}
+
 void printUsage(const char* program) {
     std::cout << "Usage: " << program << " [options]\n"
               << "Options:\n"
               << "  -c, --config <file>  Load configuration from JSON file\n"
               << "  -p, --port <port>    Override server port\n"
-              << "  -h, --help           Show this help message\n";
+              << "  -h, --help           Show this help message\n"
+              << "Send SIGUSR1 to write a Chrome trace of recent ticks\n";
 }
 
 int main(int argc, char* argv[]) {
-    std::cout << "=== MMORPG Game Server ===" << std::endl;
+    LOG_INFO("=== MMORPG Game Server ===");
 
     // Default config
     mmorpg::GameServer::Config config;
@@ -60,18 +70,23 @@ int main(int argc, char* argv[]) {
     // Setup signal handlers
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
+    mmorpg::Profiler::instance();  // Construct before its handler can run
+    signal(SIGUSR1, dumpSignalHandler);
 
     // Create and run server
     mmorpg::GameServer server(config);
     g_server = &server;
 
     if (!server.initialize()) {
-        std::cerr << "Failed to initialize server" << std::endl;
+        LOG_ERROR("Failed to initialize server");
         return 1;
     }
 
     server.run();
 
-    std::cout << "Server exited cleanly" << std::endl;
+    if (g_signal != 0) {
+        LOG_INFO("Received signal " << static_cast<int>(g_signal) << ", shut down");
+    }
+    LOG_INFO("Server exited cleanly");
     return 0;
 }
@@ -1,6 +1,6 @@
 #include "Connection.hpp"
-#include <cstring>
-#include <iostream>
+#include "../core/Logger.hpp"
+#include <algorithm>
 #include <boost/endian/conversion.hpp>
 
 namespace mmorpg::net {
@@ -9,19 +9,17 @@ Connection::Connection(Socket socket, ConnectionId id)
     : socket_(std::move(socket))
     , id_(id)
     , uuid_(mmorpg::generateUUID()) {
-    recvBuffer_.reserve(RECV_BUFFER_SIZE);
 }
 
 Connection::Connection(Socket socket, ConnectionId id, mmorpg::ConnectionUUID uuid)
     : socket_(std::move(socket))
     , id_(id)
     , uuid_(uuid) {
-    recvBuffer_.reserve(RECV_BUFFER_SIZE);
 }
 
 bool Connection::readFromSocket() {
-    uint8_t buffer[4096];
-    int received = socket_.receiveInto(buffer, sizeof(buffer));
+    prepareForRead();
+    int received = socket_.receiveInto(recvBuffer_.writePtr(), recvBuffer_.writable());
 
     if (received <= 0) {
         // Connection closed or error (including EAGAIN/EWOULDBLOCK)
@@ -32,65 +30,152 @@ bool Connection::readFromSocket() {
         return true;
     }
 
-    // Append to receive buffer
-    recvBuffer_.insert(recvBuffer_.end(), buffer, buffer + received);
+    recvBuffer_.commit(static_cast<size_t>(received));
     return true;
 }
 
-std::vector<proto::Packet> Connection::getCompletePackets() {
-    std::vector<proto::Packet> packets;
-
-    while (recvBuffer_.size() >= 4) {
-        // Read packet length (4 bytes, network byte order)
-        uint32_t packetLen;
-        memcpy(&packetLen, recvBuffer_.data(), 4);
-        packetLen = boost::endian::big_to_native(packetLen);
-
-        // Sanity check
-        if (packetLen > MAX_PACKET_SIZE) {
-            std::cerr << "Packet too large: " << packetLen << std::endl;
-            disconnect();
-            break;
-        }
-
-        // Check if we have the complete packet
-        if (recvBuffer_.size() < 4 + packetLen) {
-            break;  // Wait for more data
+void Connection::prepareForRead() {
+    size_t needed = MIN_READ_SIZE;
+
+    // Make sure the rest of a partially received frame fits
+    if (recvBuffer_.readable() >= Frame::HEADER_SIZE) {
+        size_t length = peekFrameWord() & ~Frame::TYPED_FRAME_FLAG;
+        if (length <= MAX_PACKET_SIZE) {
+            size_t frameSize = Frame::HEADER_SIZE + length;
+            if (frameSize > recvBuffer_.readable()) {
+                needed = std::max(needed, frameSize - recvBuffer_.readable());
+            }
         }
+    }
 
-        // Parse the packet
-        proto::Packet packet;
-        if (packet.ParseFromArray(recvBuffer_.data() + 4, packetLen)) {
-            packets.push_back(std::move(packet));
-        } else {
-            std::cerr << "Failed to parse packet" << std::endl;
-        }
+    recvBuffer_.prepare(needed);
+}
 
-        // Remove processed data from buffer
-        recvBuffer_.erase(recvBuffer_.begin(), recvBuffer_.begin() + 4 + packetLen);
+bool Connection::checkFrameLength(uint32_t length) {
+    // Sanity check
+    if (length > MAX_PACKET_SIZE) {
+        LOG_WARN("Packet too large: " << length);
+        disconnect();
+        recvBuffer_.clear();
+        return false;
     }
+    return true;
+}
 
-    return packets;
+void Connection::reportBadFrame() {
+    LOG_WARN("Failed to parse packet");
 }
 
-bool Connection::sendPacket(proto::MessageType type, const google::protobuf::Message& message) {
-    proto::Packet packet;
-    packet.set_type(static_cast<uint32_t>(type));
-    packet.set_payload(message.SerializeAsString());
-    return sendRawPacket(packet);
+bool Connection::sendPacket(proto::MessageType type, const google::protobuf::Message& message,
+                            SendLane lane) {
+    if (!isConnected()) return false;
+    return sendFrame(Frame::encode(type, message, getFrameFormat()), lane);
 }
 
 bool Connection::sendRawPacket(const proto::Packet& packet) {
-    std::string data = packet.SerializeAsString();
-    uint32_t len = boost::endian::native_to_big(static_cast<uint32_t>(data.size()));
+    if (!isConnected()) return false;
+    return sendFrame(Frame::encode(packet));
+}
 
-    // Send length prefix
-    if (!socket_.send(reinterpret_cast<uint8_t*>(&len), 4)) {
+bool Connection::sendFrame(FramePtr frame, SendLane lane) {
+    if (!isConnected() || !frame) return false;
+
+    if (sink_) {
+        sink_->post(shared_from_this(), std::move(frame), lane);
+        return true;
+    }
+    return queueFrame(std::move(frame), lane);
+}
+
+bool Connection::queueFrame(FramePtr frame, SendLane lane) {
+    if (!isConnected() || !frame) return false;
+
+    // A client that stopped reading must not grow the queue forever
+    if (queuedBytes_ + frame->size() > sendHighWaterMark_) {
+        LOG_WARN("Connection #" << id_ << " send queue over high-water mark ("
+              << queuedBytes_ << " bytes queued), disconnecting");
+        abort();
         return false;
     }
 
-    // Send data
-    return socket_.send(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    queuedBytes_ += frame->size();
+    sendQueue_.push_back(std::move(frame));
+
+    if (!coalescing_ || lane == SendLane::Urgent) {
+        release();
+    }
+    return true;
+}
+
+void Connection::abort() {
+    disconnect();
+
+    // Wake the pending read so its handler removes the connection
+    boost::system::error_code ec;
+    socket_.getAsioSocket().cancel(ec);
+}
+
+void Connection::setCoalescing(bool enabled) {
+    coalescing_ = enabled;
+    if (!enabled) {
+        release();
+    }
+}
+
+void Connection::flush() {
+    release();
+}
+
+void Connection::release() {
+    // Everything queued so far may go; order is never changed
+    releasedFrames_ = sendQueue_.size();
+    if (!writeInProgress_ && releasedFrames_ > 0 && isConnected()) {
+        startWrite();
+    }
+}
+
+void Connection::startWrite() {
+    // Gather released frames into one write
+    writeBuffers_.clear();
+    for (const auto& frame : sendQueue_) {
+        if (writeBuffers_.size() == std::min(releasedFrames_, MAX_GATHER_FRAMES)) break;
+        writeBuffers_.push_back(asio::buffer(frame->data(), frame->size()));
+    }
+    writeBatchSize_ = writeBuffers_.size();
+    writeInProgress_ = true;
+    writeCount_.fetch_add(1, std::memory_order_relaxed);
+
+    auto self = shared_from_this();
+    asio::async_write(
+        socket_.getAsioSocket(),
+        writeBuffers_,
+        [self](const boost::system::error_code& ec, size_t /*bytesWritten*/) {
+            self->handleWrite(ec);
+        }
+    );
+}
+
+void Connection::handleWrite(const boost::system::error_code& ec) {
+    writeInProgress_ = false;
+
+    if (ec) {
+        abort();
+        sendQueue_.clear();
+        releasedFrames_ = 0;
+        queuedBytes_ = 0;
+        return;
+    }
+
+    for (size_t i = 0; i < writeBatchSize_; i++) {
+        queuedBytes_ -= sendQueue_.front()->size();
+        sendQueue_.pop_front();
+    }
+    releasedFrames_ -= writeBatchSize_;
+    writeBatchSize_ = 0;
+
+    if (releasedFrames_ > 0 && isConnected()) {
+        startWrite();
+    }
 }
 
 } // namespace mmorpg::net
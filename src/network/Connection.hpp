@@ -1,17 +1,46 @@
 #pragma once
 
 #include "Socket.hpp"
+#include "Frame.hpp"
+#include "RecvBuffer.hpp"
 #include "../core/Types.hpp"
 #include "../proto/messages.pb.h"
+#include <atomic>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <memory>
+#include <functional>
 #include <cstdint>
+#include <cstring>
+#include <boost/endian/conversion.hpp>
+#include <boost/container/static_vector.hpp>
 
 namespace mmorpg::net {
 
+class Connection;
+
+// How soon a queued frame goes out on a coalescing connection
+enum class SendLane : uint8_t {
+    Normal,  // Held until the next flush() (end of tick)
+    Urgent   // Written now, along with anything queued before it
+};
+
+// Owner of a connection's socket when it lives on another thread (an
+// IoWorker). Frames sent from the simulation thread are handed to it
+// instead of being written directly.
+class FrameSink {
+public:
+    virtual ~FrameSink() = default;
+
+    // Queue a frame for the connection on its I/O thread
+    virtual void post(const std::shared_ptr<Connection>& conn, FramePtr frame, SendLane lane) = 0;
+
+    // Close the connection's socket on its I/O thread
+    virtual void close(const std::shared_ptr<Connection>& conn) = 0;
+};
+
 // Client connection with message buffering
-class Connection {
+class Connection : public std::enable_shared_from_this<Connection> {
 public:
     using ConnectionId = uint32_t;
 
@@ -20,15 +49,17 @@ public:
 
     Connection(const Connection&) = delete;
     Connection& operator=(const Connection&) = delete;
-    Connection(Connection&&) = default;
-    Connection& operator=(Connection&&) = default;
 
     // Accessors
     ConnectionId getId() const { return id_; }
     const mmorpg::ConnectionUUID& getUUID() const { return uuid_; }
     Socket& getSocket() { return socket_; }
     const Socket& getSocket() const { return socket_; }
-    bool isConnected() const { return socket_.isValid() && !disconnected_; }
+    // A connection owned by an I/O thread is only closed there, so other
+    // threads go by the flag alone
+    bool isConnected() const {
+        return !disconnected_.load(std::memory_order_acquire) && (sink_ || socket_.isValid());
+    }
 
     // Associated actor (set after login)
     uint32_t getActorId() const { return actorId_; }
@@ -38,16 +69,65 @@ public:
     // Returns false if connection is closed
     bool readFromSocket();
 
-    // Try to parse complete packets from buffer
-    // Returns list of complete packets
-    std::vector<proto::Packet> getCompletePackets();
-
-    // Send a packet
-    bool sendPacket(proto::MessageType type, const google::protobuf::Message& message);
-    bool sendRawPacket(const proto::Packet& packet);
-
-    // Mark as disconnected
-    void disconnect() { disconnected_ = true; }
+    // Arm a single async_read_some on the socket's io_context.
+    // Received bytes land directly in the receive buffer before the handler
+    // runs; the caller re-arms after draining complete frames.
+    // Handler: void(const boost::system::error_code&). Taken by value rather
+    // than through std::function so re-arming does not allocate.
+    template<typename Handler>
+    void asyncRead(Handler handler);
+
+    // Decode each complete frame in place and hand it to visit(PacketView),
+    // with no copy or allocation. The view is only valid during the call.
+    // Returns the number of frames visited.
+    template<typename Visitor>
+    size_t consumeFrames(Visitor&& visit);
+
+    // Queue a packet for sending; never blocks.
+    // Returns false (and disconnects, cancelling the pending read) if the
+    // queue would exceed the high-water mark.
+    bool sendPacket(proto::MessageType type, const google::protobuf::Message& message,
+                    SendLane lane = SendLane::Normal);
+    bool sendRawPacket(const proto::Packet& packet);  // Always Envelope format
+
+    // Queue a pre-encoded frame (shared, not copied). With a FrameSink the
+    // frame is handed to the owning I/O thread instead.
+    bool sendFrame(FramePtr frame, SendLane lane = SendLane::Normal);
+
+    // Queue a frame and start writing unless coalescing holds it back; must
+    // run on the socket's own thread
+    bool queueFrame(FramePtr frame, SendLane lane = SendLane::Normal);
+
+    // Coalescing: hold Normal frames until flush(), so everything sent to
+    // this client in a tick leaves in one gathered write. Own thread only.
+    void setCoalescing(bool enabled);
+    bool isCoalescing() const { return coalescing_; }
+    void flush();
+
+    // Number of gathered writes issued (one writev each); readable anywhere
+    uint64_t getWriteCount() const { return writeCount_.load(std::memory_order_relaxed); }
+
+    // Route sends through the thread that owns the socket (see IoWorker)
+    void setFrameSink(FrameSink* sink) { sink_ = sink; }
+    FrameSink* getFrameSink() const { return sink_; }
+
+    // Wire format used for outgoing frames. Unless set explicitly, it follows
+    // the format of the first frame the client sends.
+    FrameFormat getFrameFormat() const { return frameFormat_.load(std::memory_order_relaxed); }
+    void setFrameFormat(FrameFormat format) {
+        frameFormat_.store(format, std::memory_order_relaxed);
+        frameFormatKnown_ = true;
+    }
+
+    // Outbound queue limits and state
+    void setSendHighWaterMark(size_t bytes) { sendHighWaterMark_ = bytes; }
+    size_t getSendHighWaterMark() const { return sendHighWaterMark_; }
+    size_t getQueuedBytes() const { return queuedBytes_; }
+    size_t getQueuedFrames() const { return sendQueue_.size(); }
+    size_t getReleasedFrames() const { return releasedFrames_; }
+
+    // Mark as disconnected (any thread)
+    void disconnect() { disconnected_.store(true, std::memory_order_release); }
 
     // Get peer info
     std::string getPeerAddress() const { return socket_.getPeerAddress(); }
@@ -58,17 +138,104 @@ private:
     ConnectionId id_;
     mmorpg::ConnectionUUID uuid_;
     uint32_t actorId_ = 0;
-    bool disconnected_ = false;
+    std::atomic<bool> disconnected_{false};
+    std::atomic<FrameFormat> frameFormat_{FrameFormat::Envelope};
+    bool frameFormatKnown_ = false;
+    FrameSink* sink_ = nullptr;
 
     // Receive buffer
-    std::vector<uint8_t> recvBuffer_;
+    RecvBuffer recvBuffer_{RECV_BUFFER_SIZE};
     static constexpr size_t RECV_BUFFER_SIZE = 65536;
+    static constexpr size_t MIN_READ_SIZE = 4096;
     static constexpr size_t MAX_PACKET_SIZE = 1024 * 1024;  // 1MB max
-
-    // Packet format: [4 bytes length][protobuf data]
-    bool parsePacket(proto::Packet& packet);
+    static constexpr size_t DEFAULT_SEND_HIGH_WATER_MARK = 1024 * 1024;  // 1MB queued
+
+    // Outbound queue drained by async_write
+    // Up to MAX_GATHER_FRAMES queued frames are gathered into a single writev.
+    // async_write copies the buffer sequence, so it is fixed-capacity to keep
+    // each write allocation-free.
+    static constexpr size_t MAX_GATHER_FRAMES = 64;
+    std::deque<FramePtr> sendQueue_;
+    boost::container::static_vector<asio::const_buffer, MAX_GATHER_FRAMES> writeBuffers_;
+    size_t writeBatchSize_ = 0;
+    size_t releasedFrames_ = 0;  // Frames at the front of sendQueue_ cleared to write
+    size_t queuedBytes_ = 0;
+    size_t sendHighWaterMark_ = DEFAULT_SEND_HIGH_WATER_MARK;
+    bool writeInProgress_ = false;
+    bool coalescing_ = false;
+    std::atomic<uint64_t> writeCount_{0};
+
+    // Disconnect from the socket's own thread, cancelling its pending read
+    void abort();
+    void release();
+    void startWrite();
+    void handleWrite(const boost::system::error_code& ec);
+
+    // Frame format: [4 bytes length (+ typed flag)][body], see Frame
+    uint32_t peekFrameWord() const;
+    bool checkFrameLength(uint32_t length);
+    void reportBadFrame();
+    void prepareForRead();
 };
 
+template<typename Visitor>
+size_t Connection::consumeFrames(Visitor&& visit) {
+    size_t frames = 0;
+
+    while (recvBuffer_.readable() >= Frame::HEADER_SIZE) {
+        uint32_t word = peekFrameWord();
+        uint32_t length = word & ~Frame::TYPED_FRAME_FLAG;
+        if (!checkFrameLength(length)) {
+            break;
+        }
+
+        if (recvBuffer_.readable() < Frame::HEADER_SIZE + length) {
+            break;  // Wait for more data
+        }
+
+        FrameFormat format = (word & Frame::TYPED_FRAME_FLAG) ? FrameFormat::Typed
+                                                              : FrameFormat::Envelope;
+        if (!frameFormatKnown_) {
+            // Reply in whatever format the client speaks
+            setFrameFormat(format);
+        }
+
+        PacketView packet;
+        FrameView body{recvBuffer_.readPtr() + Frame::HEADER_SIZE, length};
+        if (Frame::decode(format, body, packet)) {
+            visit(packet);
+            frames++;
+        } else {
+            reportBadFrame();
+        }
+        recvBuffer_.consume(Frame::HEADER_SIZE + length);
+    }
+
+    return frames;
+}
+
+template<typename Handler>
+void Connection::asyncRead(Handler handler) {
+    prepareForRead();
+
+    auto self = shared_from_this();
+    socket_.getAsioSocket().async_read_some(
+        asio::buffer(recvBuffer_.writePtr(), recvBuffer_.writable()),
+        [self, handler = std::move(handler)](const boost::system::error_code& ec, size_t received) mutable {
+            if (!ec) {
+                self->recvBuffer_.commit(received);
+            }
+            handler(ec);
+        }
+    );
+}
+
+inline uint32_t Connection::peekFrameWord() const {
+    uint32_t word;
+    memcpy(&word, recvBuffer_.readPtr(), Frame::HEADER_SIZE);
+    return boost::endian::big_to_native(word);
+}
+
 using ConnectionPtr = std::shared_ptr<Connection>;
 
 } // namespace mmorpg::net
@@ -0,0 +1,136 @@
+#include "Frame.hpp"
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <boost/endian/conversion.hpp>
+#include <cstring>
+
+namespace mmorpg::net {
+
+namespace {
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::internal::WireFormatLite;
+
+// Packet field tags (proto3 wire format)
+constexpr uint8_t PACKET_TYPE_TAG = (1 << 3) | 0;     // uint32 type = 1 (varint)
+constexpr uint8_t PACKET_PAYLOAD_TAG = (2 << 3) | 2;  // bytes payload = 2 (length-delimited)
+
+void writeWord(uint8_t* out, uint32_t value) {
+    value = boost::endian::native_to_big(value);
+    memcpy(out, &value, 4);
+}
+
+uint32_t readWord(const uint8_t* in) {
+    uint32_t value;
+    memcpy(&value, in, 4);
+    return boost::endian::big_to_native(value);
+}
+
+std::string encodeEnvelope(uint32_t typeValue, const google::protobuf::Message& message) {
+    auto payloadSize = static_cast<uint32_t>(message.ByteSizeLong());
+
+    // Lay out the Packet envelope by hand so the payload is serialized
+    // straight into the frame instead of into a temporary string.
+    // Default (zero) fields are omitted, matching Packet::SerializeAsString().
+    size_t envelopeSize = 0;
+    if (typeValue != 0) {
+        envelopeSize += 1 + CodedOutputStream::VarintSize32(typeValue);
+    }
+    if (payloadSize != 0) {
+        envelopeSize += 1 + CodedOutputStream::VarintSize32(payloadSize) + payloadSize;
+    }
+
+    std::string bytes(Frame::HEADER_SIZE + envelopeSize, '\0');
+    auto* out = reinterpret_cast<uint8_t*>(bytes.data());
+    writeWord(out, static_cast<uint32_t>(envelopeSize));
+    out += Frame::HEADER_SIZE;
+
+    if (typeValue != 0) {
+        *out++ = PACKET_TYPE_TAG;
+        out = CodedOutputStream::WriteVarint32ToArray(typeValue, out);
+    }
+    if (payloadSize != 0) {
+        *out++ = PACKET_PAYLOAD_TAG;
+        out = CodedOutputStream::WriteVarint32ToArray(payloadSize, out);
+        message.SerializeWithCachedSizesToArray(out);
+    }
+
+    return bytes;
+}
+
+std::string encodeTyped(uint32_t typeValue, const google::protobuf::Message& message) {
+    size_t messageSize = message.ByteSizeLong();
+    size_t bodySize = Frame::TYPE_SIZE + messageSize;
+
+    std::string bytes(Frame::HEADER_SIZE + bodySize, '\0');
+    auto* out = reinterpret_cast<uint8_t*>(bytes.data());
+    writeWord(out, static_cast<uint32_t>(bodySize) | Frame::TYPED_FRAME_FLAG);
+    writeWord(out + Frame::HEADER_SIZE, typeValue);
+    message.SerializeWithCachedSizesToArray(out + Frame::HEADER_SIZE + Frame::TYPE_SIZE);
+
+    return bytes;
+}
+
+bool decodeEnvelope(const FrameView& body, PacketView& out) {
+    // Walk the Packet fields instead of parsing into a proto::Packet,
+    // so the payload is referenced in place rather than copied out
+    CodedInputStream in(body.data, static_cast<int>(body.size));
+
+    while (uint32_t tag = in.ReadTag()) {
+        if (tag == PACKET_TYPE_TAG) {
+            if (!in.ReadVarint32(&out.type)) return false;
+        } else if (tag == PACKET_PAYLOAD_TAG) {
+            uint32_t length;
+            if (!in.ReadVarint32(&length)) return false;
+            int offset = in.CurrentPosition();
+            if (!in.Skip(static_cast<int>(length))) return false;
+            out.data = body.data + offset;
+            out.size = length;
+        } else if (!WireFormatLite::SkipField(&in, tag)) {
+            return false;
+        }
+    }
+
+    return in.ConsumedEntireMessage();
+}
+
+} // namespace
+
+FramePtr Frame::encode(proto::MessageType type, const google::protobuf::Message& message,
+                       FrameFormat format) {
+    auto typeValue = static_cast<uint32_t>(type);
+    if (format == FrameFormat::Typed) {
+        return make(encodeTyped(typeValue, message));
+    }
+    return make(encodeEnvelope(typeValue, message));
+}
+
+FramePtr Frame::encode(const proto::Packet& packet) {
+    size_t packetSize = packet.ByteSizeLong();
+
+    std::string bytes(HEADER_SIZE + packetSize, '\0');
+    auto* out = reinterpret_cast<uint8_t*>(bytes.data());
+    writeWord(out, static_cast<uint32_t>(packetSize));
+    packet.SerializeWithCachedSizesToArray(out + HEADER_SIZE);
+
+    return make(std::move(bytes));
+}
+
+bool Frame::decode(FrameFormat format, const FrameView& body, PacketView& out) {
+    out = PacketView{};
+    out.format = format;
+
+    if (format == FrameFormat::Typed) {
+        if (body.size < TYPE_SIZE) return false;
+        out.type = readWord(body.data);
+        out.data = body.data + TYPE_SIZE;
+        out.size = body.size - TYPE_SIZE;
+        return true;
+    }
+
+    out.data = body.data;  // Empty payload unless the envelope has one
+    return decodeEnvelope(body, out);
+}
+
+} // namespace mmorpg::net
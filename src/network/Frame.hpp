@@ -0,0 +1,71 @@
+#pragma once
+
+#include "RecvBuffer.hpp"
+#include "../proto/messages.pb.h"
+#include <memory>
+#include <string>
+#include <cstdint>
+
+namespace mmorpg::net {
+
+// Wire framing, selected per connection
+enum class FrameFormat : uint8_t {
+    Envelope,  // [4 bytes length][Packet{type, payload}] - original format
+    Typed      // [4 bytes length | TYPED_FRAME_FLAG][4 bytes type][message]
+};
+
+// Decoded frame: message type plus the serialized message, parsed in place.
+// Points into the receive buffer; only valid during dispatch.
+struct PacketView {
+    uint32_t type = 0;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    FrameFormat format = FrameFormat::Envelope;
+};
+
+class Frame;
+using FramePtr = std::shared_ptr<const Frame>;
+
+// Immutable, length-prefixed wire frame.
+// Encoded once and shared by every connection it is queued on.
+class Frame {
+public:
+    // Encode a message, serializing it once directly into the frame
+    static FramePtr encode(proto::MessageType type, const google::protobuf::Message& message,
+                           FrameFormat format = FrameFormat::Envelope);
+
+    // Encode an already built Packet (Envelope format)
+    static FramePtr encode(const proto::Packet& packet);
+
+    // Decode a frame body (bytes after the length word) without copying
+    static bool decode(FrameFormat format, const FrameView& body, PacketView& out);
+
+    const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(bytes_.data()); }
+    size_t size() const { return bytes_.size(); }
+
+    static constexpr size_t HEADER_SIZE = 4;
+    static constexpr size_t TYPE_SIZE = 4;
+
+    // Set in the length word of Typed frames. Envelope lengths never reach
+    // it (packets are capped far below 2GB), so both formats can share a port.
+    static constexpr uint32_t TYPED_FRAME_FLAG = 0x80000000u;
+
+private:
+    // Lets encode() use make_shared (frame and control block in one
+    // allocation) while keeping construction private
+    struct Token {
+        explicit Token() = default;
+    };
+
+public:
+    Frame(Token, std::string bytes) : bytes_(std::move(bytes)) {}
+
+private:
+    static FramePtr make(std::string bytes) {
+        return std::make_shared<const Frame>(Token{}, std::move(bytes));
+    }
+
+    std::string bytes_;
+};
+
+} // namespace mmorpg::net
@@ -0,0 +1,262 @@
+#include "IoWorker.hpp"
+#include "../core/Logger.hpp"
+#include "../core/Profiler.hpp"
+
+namespace mmorpg::net {
+
+namespace {
+
+#ifdef SO_REUSEPORT
+// Lets every worker bind its own acceptor to the same port; the kernel
+// spreads incoming connections across them
+using reuse_port = asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
+} // namespace
+
+IoWorker::IoWorker(size_t index, uint16_t port, NetEventQueue& events, NotifyHandler notify,
+                   std::atomic<Connection::ConnectionId>& nextConnectionId)
+    : index_(index)
+    , port_(port)
+    , acceptor_(io_)
+    , events_(events)
+    , notify_(std::move(notify))
+    , nextConnectionId_(nextConnectionId) {
+}
+
+IoWorker::~IoWorker() {
+    stop();
+}
+
+bool IoWorker::listen() {
+#ifdef SO_REUSEPORT
+    try {
+        tcp::endpoint endpoint(tcp::v4(), port_);
+        acceptor_.open(endpoint.protocol());
+        acceptor_.set_option(tcp::acceptor::reuse_address(true));
+        acceptor_.set_option(reuse_port(true));
+        acceptor_.bind(endpoint);
+        acceptor_.listen();
+        return true;
+    } catch (const boost::system::system_error& e) {
+        LOG_ERROR("I/O worker " << index_ << " listen error: " << e.what());
+        return false;
+    }
+#else
+    LOG_ERROR("SO_REUSEPORT is not available; use io_threads = 0");
+    return false;
+#endif
+}
+
+void IoWorker::start() {
+    startAccept();
+    thread_ = std::thread([this] {
+        Profiler::instance().setThreadName("io-" + std::to_string(index_));
+        io_.run();
+    });
+}
+
+void IoWorker::stop() {
+    if (stopping_.exchange(true)) return;
+
+    if (thread_.joinable()) {
+        // Tear down on the worker's own thread, then let run() return
+        asio::post(io_, [this] {
+            closeAll();
+            io_.stop();
+        });
+        thread_.join();
+    } else {
+        closeAll();
+    }
+}
+
+void IoWorker::closeAll() {
+    boost::system::error_code ec;
+    acceptor_.close(ec);
+    for (auto& [id, conn] : connections_) {
+        conn->disconnect();
+        conn->getSocket().close();
+    }
+    connections_.clear();
+}
+
+void IoWorker::startAccept() {
+    acceptor_.async_accept(
+        [this](const boost::system::error_code& ec, tcp::socket socket) {
+            handleAccept(ec, std::move(socket));
+        }
+    );
+}
+
+void IoWorker::handleAccept(const boost::system::error_code& ec, tcp::socket socket) {
+    if (stopping_) return;
+
+    if (!ec) {
+        socket.set_option(tcp::no_delay(true));
+
+        auto connId = nextConnectionId_.fetch_add(1, std::memory_order_relaxed);
+        auto conn = std::make_shared<Connection>(Socket(std::move(socket)), connId);
+        conn->setSendHighWaterMark(sendHighWaterMark_);
+        conn->setCoalescing(coalesceWrites_);
+        conn->setFrameSink(this);
+
+        LOG_INFO("New connection #" << connId << " from "
+              << conn->getPeerAddress() << ":" << conn->getPeerPort()
+              << " (I/O thread " << index_ << ")");
+
+        connections_[connId] = conn;
+
+        // Queued ahead of any of its packets
+        NetEvent event;
+        event.kind = NetEvent::Kind::Connected;
+        event.conn = conn;
+        pushEvent(std::move(event));
+        notify_();
+
+        startRead(conn);
+    }
+
+    startAccept();
+}
+
+void IoWorker::startRead(ConnectionPtr conn) {
+    conn->asyncRead([this, conn](const boost::system::error_code& ec) {
+        handleRead(conn, ec);
+    });
+}
+
+void IoWorker::handleRead(const ConnectionPtr& conn, const boost::system::error_code& ec) {
+    if (stopping_) return;
+    PROFILE_ZONE("net.read");
+
+    if (ec) {
+        // EOF, reset, or cancelled by close()
+        conn->disconnect();
+    } else {
+        // Frames are decoded here; only the message bytes cross threads
+        size_t frames = conn->consumeFrames([this, &conn](const PacketView& packet) {
+            if (packetHandler_) {
+                packetHandler_(conn, packet);
+                return;
+            }
+
+            NetEvent event;
+            event.kind = NetEvent::Kind::Packet;
+            event.conn = conn;
+            event.type = packet.type;
+            event.format = packet.format;
+            event.payload.assign(packet.data, packet.data + packet.size);
+            pushEvent(std::move(event));
+        });
+        if (frames > 0) {
+            notify_();
+        }
+    }
+
+    if (conn->isConnected()) {
+        startRead(conn);
+    } else {
+        removeConnection(conn);
+    }
+}
+
+void IoWorker::removeConnection(const ConnectionPtr& conn) {
+    conn->getSocket().close();
+    connections_.erase(conn->getId());
+
+    NetEvent event;
+    event.kind = NetEvent::Kind::Disconnected;
+    event.conn = conn;
+    pushEvent(std::move(event));
+    notify_();
+}
+
+void IoWorker::pushEvent(NetEvent event) {
+    // The simulation thread never waits on a worker (flush() and post()
+    // give up rather than spin), so backing off until it catches up cannot
+    // deadlock
+    while (!events_.tryPush(std::move(event))) {
+        if (stopping_) return;
+        notify_();
+        std::this_thread::yield();
+    }
+}
+
+void IoWorker::post(const ConnectionPtr& conn, FramePtr frame, SendLane lane) {
+    if (!pushOutbound(OutboundFrame{conn, std::move(frame), lane})) {
+        // The worker is far behind; shed this client rather than block the tick
+        LOG_WARN("I/O thread " << index_ << " outbox full, disconnecting #"
+              << conn->getId());
+        conn->disconnect();
+        close(conn);
+    }
+}
+
+void IoWorker::flush() {
+    if (!coalesceWrites_) return;
+
+    // The marker keeps the flush in order with the frames around it. With
+    // the outbox full, the worker flushes once it has drained it instead;
+    // waiting for room here could deadlock with a worker blocked in
+    // pushEvent() on this thread.
+    if (!pushOutbound(OutboundFrame{})) {
+        flushPending_.store(true, std::memory_order_release);
+        scheduleDrain();
+    }
+}
+
+bool IoWorker::pushOutbound(OutboundFrame out) {
+    if (!outbox_.tryPush(std::move(out))) {
+        return false;
+    }
+
+    scheduleDrain();
+    return true;
+}
+
+void IoWorker::scheduleDrain() {
+    // One wakeup per batch of posts
+    if (!flushScheduled_.exchange(true, std::memory_order_acq_rel)) {
+        asio::post(io_, [this] {
+            flushScheduled_.store(false, std::memory_order_release);
+            drainOutbox();
+        });
+    }
+}
+
+void IoWorker::close(const ConnectionPtr& conn) {
+    asio::post(io_, [conn] {
+        // Wake the pending read so the connection is removed
+        boost::system::error_code ec;
+        conn->getSocket().getAsioSocket().cancel(ec);
+    });
+}
+
+void IoWorker::drainOutbox() {
+    PROFILE_ZONE("net.outbox");
+    OutboundFrame out;
+    while (outbox_.tryPop(out)) {
+        if (!out.conn) {
+            flushConnections();
+            continue;
+        }
+
+        // Over its high-water mark, queueFrame cancels the read that removes it
+        out.conn->queueFrame(std::move(out.frame), out.lane);
+    }
+
+    // A flush whose marker did not fit in the outbox
+    if (flushPending_.exchange(false, std::memory_order_acq_rel)) {
+        flushConnections();
+    }
+}
+
+void IoWorker::flushConnections() {
+    // End of tick: one gathered write per connection with held frames
+    for (auto& [id, conn] : connections_) {
+        conn->flush();
+    }
+}
+
+} // namespace mmorpg::net
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Connection.hpp"
+#include "../core/MpscQueue.hpp"
+#include "../core/SpscQueue.hpp"
+#include <boost/asio.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+namespace mmorpg::net {
+
+namespace asio = boost::asio;
+using tcp = asio::ip::tcp;
+
+// Connection lifecycle change or decoded frame, handed from an I/O thread to
+// the simulation thread
+struct NetEvent {
+    enum class Kind : uint8_t { Connected, Packet, Disconnected };
+
+    Kind kind = Kind::Packet;
+    ConnectionPtr conn;
+    uint32_t type = 0;
+    FrameFormat format = FrameFormat::Envelope;
+
+    // Serialized message, copied out of the receive buffer. Game messages
+    // fit inline, so queuing a packet does not allocate; larger ones
+    // spill to the heap.
+    static constexpr size_t INLINE_PAYLOAD = 128;
+    boost::container::small_vector<uint8_t, INLINE_PAYLOAD> payload;
+};
+
+using NetEventQueue = MpscQueue<NetEvent>;
+
+// Frame addressed to one connection, handed from the simulation thread to the
+// thread that owns its socket. An entry without a connection is a flush
+// marker (end of tick).
+struct OutboundFrame {
+    ConnectionPtr conn;
+    FramePtr frame;
+    SendLane lane = SendLane::Normal;
+};
+
+using OutboundQueue = SpscQueue<OutboundFrame>;
+
+// One network I/O thread with its own io_context and SO_REUSEPORT acceptor
+// on the shared port. It owns accept, reads, framing and writes for the
+// connections the kernel hands it; game logic never runs here.
+//
+// Inbound: decoded frames go to the shared NetEventQueue, then notify() asks
+// the simulation thread to drain it, unless a thread-safe packet handler is
+// set, in which case it is called right here.
+// Outbound: frames sent from the simulation thread arrive through an SPSC
+// outbox (see FrameSink) and are written here.
+class IoWorker : public FrameSink {
+public:
+    using NotifyHandler = std::function<void()>;
+    using PacketHandler = std::function<void(ConnectionPtr, const PacketView&)>;
+
+    IoWorker(size_t index, uint16_t port, NetEventQueue& events, NotifyHandler notify,
+             std::atomic<Connection::ConnectionId>& nextConnectionId);
+    ~IoWorker() override;
+
+    IoWorker(const IoWorker&) = delete;
+    IoWorker& operator=(const IoWorker&) = delete;
+
+    // Bind this worker's acceptor to the shared port
+    bool listen();
+
+    // Spawn the I/O thread
+    void start();
+
+    // Close the acceptor and every connection, then join the thread
+    void stop();
+
+    // Per-connection outbound queue limit, applied to new connections
+    void setSendHighWaterMark(size_t bytes) { sendHighWaterMark_ = bytes; }
+
+    // Handle packets on this thread instead of queuing them (set before start)
+    void setPacketHandler(PacketHandler handler) { packetHandler_ = std::move(handler); }
+
+    // Hold frames until flush() on new connections (set before start)
+    void setCoalesceWrites(bool enabled) { coalesceWrites_ = enabled; }
+
+    // Write out everything posted so far (simulation thread, after post());
+    // never blocks
+    void flush();
+
+    size_t getIndex() const { return index_; }
+
+    // FrameSink, called from the simulation thread (single producer)
+    void post(const ConnectionPtr& conn, FramePtr frame, SendLane lane) override;
+    void close(const ConnectionPtr& conn) override;
+
+private:
+    void startAccept();
+    void handleAccept(const boost::system::error_code& ec, tcp::socket socket);
+    void startRead(ConnectionPtr conn);
+    void handleRead(const ConnectionPtr& conn, const boost::system::error_code& ec);
+    void removeConnection(const ConnectionPtr& conn);
+    void drainOutbox();
+    void scheduleDrain();
+    void flushConnections();
+    void closeAll();
+    void pushEvent(NetEvent event);
+    bool pushOutbound(OutboundFrame out);
+
+    size_t index_;
+    uint16_t port_;
+    asio::io_context io_;
+    tcp::acceptor acceptor_;
+    std::thread thread_;
+    std::atomic<bool> stopping_{false};
+
+    // Touched only on this worker's thread
+    boost::container::flat_map<Connection::ConnectionId, ConnectionPtr> connections_;
+    size_t sendHighWaterMark_ = 1024 * 1024;
+    bool coalesceWrites_ = false;
+
+    NetEventQueue& events_;
+    NotifyHandler notify_;
+    PacketHandler packetHandler_;
+    std::atomic<Connection::ConnectionId>& nextConnectionId_;
+
+    OutboundQueue outbox_{OUTBOX_CAPACITY};
+    std::atomic<bool> flushScheduled_{false};
+    std::atomic<bool> flushPending_{false};  // flush() found the outbox full
+
+    static constexpr size_t OUTBOX_CAPACITY = 16384;
+};
+
+} // namespace mmorpg::net
@@ -0,0 +1,34 @@
+#include "RecvBuffer.hpp"
+#include <cstring>
+
+namespace mmorpg::net {
+
+RecvBuffer::RecvBuffer(size_t capacity)
+    : storage_(capacity) {
+}
+
+void RecvBuffer::consume(size_t bytes) {
+    readPos_ += bytes;
+    if (readPos_ == writePos_) {
+        // Fully drained: rewind for free
+        readPos_ = writePos_ = 0;
+    }
+}
+
+void RecvBuffer::prepare(size_t minFree) {
+    if (writable() >= minFree) return;
+
+    // Move the partial frame to the front
+    size_t pending = readable();
+    if (readPos_ > 0) {
+        memmove(storage_.data(), storage_.data() + readPos_, pending);
+        readPos_ = 0;
+        writePos_ = pending;
+    }
+
+    if (writable() < minFree) {
+        storage_.resize(pending + minFree);
+    }
+}
+
+} // namespace mmorpg::net
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace mmorpg::net {
+
+// Non-owning view of one frame body inside a receive buffer.
+// Only valid until the buffer is next read into or compacted.
+struct FrameView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+// Fixed-capacity receive buffer with read/write cursors.
+// Socket reads land directly in the free space after the write cursor and
+// consumed frames only advance the read cursor. The unread tail (at most one
+// partial frame) is moved to the front only when the free space runs out,
+// so each received byte is copied at most once.
+class RecvBuffer {
+public:
+    explicit RecvBuffer(size_t capacity);
+
+    // Free space for the next read
+    uint8_t* writePtr() { return storage_.data() + writePos_; }
+    size_t writable() const { return storage_.size() - writePos_; }
+    void commit(size_t bytes) { writePos_ += bytes; }
+
+    // Unconsumed bytes
+    const uint8_t* readPtr() const { return storage_.data() + readPos_; }
+    size_t readable() const { return writePos_ - readPos_; }
+    void consume(size_t bytes);
+
+    // Ensure at least minFree bytes can be written, compacting (and growing
+    // beyond the initial capacity only if a single frame needs it)
+    void prepare(size_t minFree);
+
+    size_t capacity() const { return storage_.size(); }
+    void clear() { readPos_ = writePos_ = 0; }
+
+private:
+    std::vector<uint8_t> storage_;
+    size_t readPos_ = 0;
+    size_t writePos_ = 0;
+};
+
+} // namespace mmorpg::net
@@ -1,5 +1,5 @@
 #include "Socket.hpp"
-#include <iostream>
+#include "../core/Logger.hpp"
 
 namespace mmorpg::net {
 
@@ -48,7 +48,7 @@ bool Socket::bind(uint16_t port) {
         );
         return true;
     } catch (const boost::system::system_error& e) {
-        std::cerr << "Bind error: " << e.what() << std::endl;
+        LOG_ERROR("Bind error: " << e.what());
         return false;
     }
 }
@@ -59,7 +59,7 @@ bool Socket::listen(int backlog) {
         acceptor_->listen(backlog);
         return true;
     } catch (const boost::system::system_error& e) {
-        std::cerr << "Listen error: " << e.what() << std::endl;
+        LOG_ERROR("Listen error: " << e.what());
         return false;
     }
 }
@@ -90,7 +90,7 @@ bool Socket::connect(const std::string& host, uint16_t port) {
         asio::connect(socket_, endpoints);
         return true;
     } catch (const boost::system::system_error& e) {
-        std::cerr << "Connect error: " << e.what() << std::endl;
+        LOG_ERROR("Connect error: " << e.what());
         return false;
     }
 }
@@ -106,7 +106,7 @@ bool Socket::send(const uint8_t* data, size_t size) {
         asio::write(socket_, asio::buffer(data, size));
         return true;
     } catch (const boost::system::system_error& e) {
-        std::cerr << "Send error: " << e.what() << std::endl;
+        LOG_WARN("Send error: " << e.what());
         return false;
     }
 }
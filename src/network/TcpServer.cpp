@@ -1,12 +1,15 @@
 #include "TcpServer.hpp"
-#include <iostream>
+#include "../core/Logger.hpp"
+#include "../core/Profiler.hpp"
 #include <algorithm>
 
 namespace mmorpg::net {
 
-TcpServer::TcpServer(uint16_t port)
+TcpServer::TcpServer(uint16_t port, IoMode mode, size_t ioThreads)
     : port_(port)
-    , acceptor_(io_) {
+    , mode_(mode)
+    , acceptor_(io_)
+    , ioThreads_(ioThreads) {
 }
 
 TcpServer::~TcpServer() {
@@ -16,6 +19,35 @@ TcpServer::~TcpServer() {
 bool TcpServer::start() {
     if (running_) return true;
 
+    if (ioThreads_ > 0) {
+        events_ = std::make_unique<NetEventQueue>(EVENT_QUEUE_CAPACITY);
+        for (size_t i = 0; i < ioThreads_; i++) {
+            auto worker = std::make_unique<IoWorker>(i, port_, *events_,
+                                                     [this] { notifyEvents(); },
+                                                     nextConnectionId_);
+            worker->setSendHighWaterMark(sendHighWaterMark_);
+            worker->setPacketHandler(ioPacketHandler_);
+            worker->setCoalesceWrites(coalesceWrites_);
+            if (!worker->listen()) {
+                LOG_ERROR("Server start error: I/O thread " << i << " could not listen");
+                workers_.clear();
+                return false;
+            }
+            workers_.push_back(std::move(worker));
+        }
+
+        // Nothing else may keep io_ busy; run() waits for posted events
+        work_.emplace(io_.get_executor());
+        running_ = true;
+        for (auto& worker : workers_) {
+            worker->start();
+        }
+
+        LOG_INFO("Server listening on port " << port_ << " ("
+              << ioThreads_ << " I/O threads)");
+        return true;
+    }
+
     try {
         tcp::endpoint endpoint(tcp::v4(), port_);
         acceptor_.open(endpoint.protocol());
@@ -27,10 +59,10 @@ bool TcpServer::start() {
         running_ = true;
         startAccept();
 
-        std::cout << "Server listening on port " << port_ << std::endl;
+        LOG_INFO("Server listening on port " << port_);
         return true;
     } catch (const boost::system::system_error& e) {
-        std::cerr << "Server start error: " << e.what() << std::endl;
+        LOG_ERROR("Server start error: " << e.what());
         return false;
     }
 }
@@ -39,12 +71,28 @@ void TcpServer::stop() {
     if (!running_) return;
 
     running_ = false;
+
+    // Joins the I/O threads; nothing touches connections concurrently after
+    for (auto& worker : workers_) {
+        worker->stop();
+    }
+    workers_.clear();
+    if (events_) {
+        NetEvent event;
+        while (events_->tryPop(event)) {}
+    }
+    work_.reset();
+
     boost::system::error_code ec;
     acceptor_.close(ec);
+    for (auto& [id, conn] : connections_) {
+        // Aborts any pending async reads
+        conn->getSocket().close();
+    }
     connections_.clear();
     io_.stop();
 
-    std::cout << "Server stopped" << std::endl;
+    LOG_INFO("Server stopped");
 }
 
 void TcpServer::startAccept() {
@@ -59,19 +107,23 @@ void TcpServer::handleAccept(const boost::system::error_code& ec, tcp::socket so
     if (!running_) return;
 
     if (!ec) {
-        socket.non_blocking(true);
+        if (mode_ == IoMode::Poll) {
+            socket.non_blocking(true);
+        }
         socket.set_option(tcp::no_delay(true));
 
         auto connId = nextConnectionId_++;
         auto conn = std::make_shared<Connection>(Socket(std::move(socket)), connId);
+        conn->setSendHighWaterMark(sendHighWaterMark_);
+        conn->setCoalescing(coalesceWrites_);
 
-        std::cout << "New connection #" << connId << " from "
-                  << conn->getPeerAddress() << ":" << conn->getPeerPort() << std::endl;
+        LOG_INFO("New connection #" << connId << " from "
+              << conn->getPeerAddress() << ":" << conn->getPeerPort());
 
-        connections_[connId] = conn;
+        addConnection(conn);
 
-        if (connectHandler_) {
-            connectHandler_(conn);
+        if (mode_ == IoMode::Async && conn->isConnected()) {
+            startRead(conn);
         }
     }
 
@@ -79,8 +131,104 @@ void TcpServer::handleAccept(const boost::system::error_code& ec, tcp::socket so
     startAccept();
 }
 
+void TcpServer::addConnection(const ConnectionPtr& conn) {
+    connections_[conn->getId()] = conn;
+
+    if (connectHandler_) {
+        connectHandler_(conn);
+    }
+}
+
+void TcpServer::notifyEvents() {
+    // Called from I/O threads; one pending drain covers any number of events
+    if (!drainScheduled_.exchange(true, std::memory_order_acq_rel)) {
+        asio::post(io_, [this] {
+            drainScheduled_.store(false, std::memory_order_release);
+            asyncEventsProcessed_ += drainEvents();
+        });
+    }
+}
+
+int TcpServer::drainEvents() {
+    if (!events_ || !running_) return 0;
+    PROFILE_ZONE("net.events");
+
+    int packets = 0;
+    NetEvent event;
+    while (events_->tryPop(event)) {
+        switch (event.kind) {
+            case NetEvent::Kind::Connected:
+                addConnection(event.conn);
+                break;
+            case NetEvent::Kind::Packet:
+                // Skip packets from connections already dropped here
+                if (event.conn->isConnected() && connections_.count(event.conn->getId()) > 0) {
+                    PacketView packet;
+                    packet.type = event.type;
+                    packet.data = event.payload.data();
+                    packet.size = event.payload.size();
+                    packet.format = event.format;
+                    if (packetHandler_) {
+                        packetHandler_(event.conn, packet);
+                    }
+                    packets++;
+                }
+                break;
+            case NetEvent::Kind::Disconnected:
+                removeConnection(event.conn->getId());
+                break;
+        }
+    }
+    return packets;
+}
+
+void TcpServer::startRead(ConnectionPtr conn) {
+    conn->asyncRead([this, conn](const boost::system::error_code& ec) {
+        handleRead(conn, ec);
+    });
+}
+
+void TcpServer::handleRead(ConnectionPtr conn, const boost::system::error_code& ec) {
+    if (!running_) return;
+    PROFILE_ZONE("net.read");
+
+    if (ec) {
+        // EOF, reset, or cancelled by disconnect()
+        conn->disconnect();
+    } else {
+        asyncEventsProcessed_ += dispatchPackets(conn);
+    }
+
+    if (conn->isConnected()) {
+        startRead(conn);
+    } else {
+        removeConnection(conn->getId());
+    }
+}
+
+int TcpServer::dispatchPackets(const ConnectionPtr& conn) {
+    // Frames are decoded in place; the handler parses the message itself
+    auto& handler = ioPacketHandler_ ? ioPacketHandler_ : packetHandler_;
+    return static_cast<int>(conn->consumeFrames([&handler, &conn](const PacketView& packet) {
+        if (handler) {
+            handler(conn, packet);
+        }
+    }));
+}
+
+void TcpServer::run() {
+    if (!running_) return;
+
+    if (io_.stopped()) {
+        io_.restart();
+    }
+
+    io_.run();
+}
+
 int TcpServer::poll(int timeoutMs) {
     if (!running_) return 0;
+    PROFILE_ZONE("net.poll");
 
     // Reset io_context if it was stopped
     if (io_.stopped()) {
@@ -88,22 +236,29 @@ int TcpServer::poll(int timeoutMs) {
     }
 
     // Run ready handlers
+    asyncEventsProcessed_ = 0;
     io_.poll();
 
+    if (!workers_.empty()) {
+        // Pick up events that arrived after the posted drain ran
+        asyncEventsProcessed_ += drainEvents();
+        removeDisconnected();
+        return asyncEventsProcessed_;
+    }
+
+    if (mode_ == IoMode::Async) {
+        // Reads are dispatched from their completion handlers
+        removeDisconnected();
+        return asyncEventsProcessed_;
+    }
+
     // Process connections for incoming data
+    // (sockets were set non-blocking on accept)
     int eventsProcessed = 0;
     for (auto& [id, conn] : connections_) {
         if (conn->isConnected()) {
-            // Non-blocking read
-            conn->getSocket().getAsioSocket().non_blocking(true);
             if (conn->readFromSocket()) {
-                auto packets = conn->getCompletePackets();
-                for (auto& packet : packets) {
-                    if (packetHandler_) {
-                        packetHandler_(conn, packet);
-                    }
-                    eventsProcessed++;
-                }
+                eventsProcessed += dispatchPackets(conn);
             }
         }
     }
@@ -124,15 +279,26 @@ void TcpServer::removeDisconnected() {
     }
 
     for (auto id : toRemove) {
-        auto it = connections_.find(id);
-        if (it != connections_.end()) {
-            std::cout << "Connection #" << id << " disconnected" << std::endl;
+        removeConnection(id);
+    }
+}
 
-            if (disconnectHandler_) {
-                disconnectHandler_(it->second);
-            }
-            connections_.erase(it);
-        }
+void TcpServer::removeConnection(Connection::ConnectionId id) {
+    auto it = connections_.find(id);
+    if (it == connections_.end()) return;
+
+    // Keep the connection alive while handlers run
+    ConnectionPtr conn = it->second;
+    LOG_INFO("Connection #" << id << " disconnected");
+
+    if (disconnectHandler_) {
+        disconnectHandler_(conn);
+    }
+
+    // The handler may have already removed it
+    it = connections_.find(id);
+    if (it != connections_.end()) {
+        connections_.erase(it);
     }
 }
 
@@ -145,18 +311,59 @@ void TcpServer::send(Connection::ConnectionId connId, proto::MessageType type,
 }
 
 void TcpServer::broadcast(proto::MessageType type, const google::protobuf::Message& message) {
+    broadcastEncoded(0, type, message);
+}
+
+void TcpServer::broadcast(const FramePtr& frame) {
     for (auto& [id, conn] : connections_) {
         if (conn->isConnected()) {
-            conn->sendPacket(type, message);
+            conn->sendFrame(frame);
         }
     }
 }
 
 void TcpServer::broadcastExcept(Connection::ConnectionId exceptId, proto::MessageType type,
                                 const google::protobuf::Message& message) {
+    broadcastEncoded(exceptId, type, message);
+}
+
+void TcpServer::broadcastEncoded(Connection::ConnectionId exceptId, proto::MessageType type,
+                                 const google::protobuf::Message& message) {
+    // At most one encode per frame format, whatever the audience size
+    FramePtr frames[2];
+    for (auto& [id, conn] : connections_) {
+        if (id == exceptId || !conn->isConnected()) continue;
+
+        auto& frame = frames[static_cast<size_t>(conn->getFrameFormat())];
+        if (!frame) {
+            frame = Frame::encode(type, message, conn->getFrameFormat());
+        }
+        conn->sendFrame(frame);
+    }
+}
+
+void TcpServer::broadcastExcept(Connection::ConnectionId exceptId, const FramePtr& frame) {
     for (auto& [id, conn] : connections_) {
         if (id != exceptId && conn->isConnected()) {
-            conn->sendPacket(type, message);
+            conn->sendFrame(frame);
+        }
+    }
+}
+
+void TcpServer::flush() {
+    if (!coalesceWrites_) return;
+    PROFILE_ZONE("net.flush");
+
+    if (!workers_.empty()) {
+        for (auto& worker : workers_) {
+            worker->flush();
+        }
+        return;
+    }
+
+    for (auto& [id, conn] : connections_) {
+        if (conn->isConnected()) {
+            conn->flush();
         }
     }
 }
@@ -171,6 +378,15 @@ void TcpServer::disconnect(Connection::ConnectionId id) {
     auto it = connections_.find(id);
     if (it != connections_.end()) {
         it->second->disconnect();
+
+        if (auto* sink = it->second->getFrameSink()) {
+            // Closed on its I/O thread, which reports the disconnect back
+            sink->close(it->second);
+        } else if (mode_ == IoMode::Async) {
+            // Wake the pending read so the connection is removed
+            boost::system::error_code ec;
+            it->second->getSocket().getAsioSocket().cancel(ec);
+        }
     }
 }
 
@@ -2,9 +2,12 @@
 
 #include "Socket.hpp"
 #include "Connection.hpp"
+#include "IoWorker.hpp"
 #include <boost/asio.hpp>
 #include <boost/container/flat_map.hpp>
+#include <atomic>
 #include <functional>
+#include <optional>
 #include <vector>
 #include <memory>
 
@@ -13,14 +16,25 @@ namespace mmorpg::net {
 namespace asio = boost::asio;
 using tcp = asio::ip::tcp;
 
-// Single-threaded TCP server using Boost.Asio
+// How connections are serviced
+enum class IoMode {
+    Poll,   // poll() reads every socket on each call
+    Async   // each connection keeps an async_read_some pending on io_
+};
+
+// TCP server using Boost.Asio.
+//
+// With ioThreads == 0 everything runs on the thread driving io_. Otherwise
+// each of ioThreads IoWorkers accepts, reads, frames and writes its share of
+// the connections, and the handlers below still run only on the thread
+// driving io_ (via run() or poll()), so game logic stays single-threaded.
 class TcpServer {
 public:
-    using PacketHandler = std::function<void(ConnectionPtr, const proto::Packet&)>;
+    using PacketHandler = std::function<void(ConnectionPtr, const PacketView&)>;
     using ConnectHandler = std::function<void(ConnectionPtr)>;
     using DisconnectHandler = std::function<void(ConnectionPtr)>;
 
-    explicit TcpServer(uint16_t port);
+    explicit TcpServer(uint16_t port, IoMode mode = IoMode::Poll, size_t ioThreads = 0);
     ~TcpServer();
 
     // Non-copyable
@@ -31,16 +45,27 @@ public:
     bool start();
     void stop();
     bool isRunning() const { return running_; }
+    IoMode getIoMode() const { return mode_; }
+    size_t getIoThreadCount() const { return ioThreads_; }
 
     // Run one iteration of the event loop
     // Returns number of events processed
     int poll(int timeoutMs = 100);
 
+    // Block in the io_context until stop() (Async mode).
+    // Packets are dispatched from read completions as they arrive.
+    void run();
+
     // Get io_context for integration with other async operations
     asio::io_context& getIoContext() { return io_; }
 
     // Set handlers
     void onPacket(PacketHandler handler) { packetHandler_ = std::move(handler); }
+
+    // Like onPacket, but called on the I/O thread that decoded the frame
+    // (inline when there are none), so it must be thread-safe. Takes
+    // precedence over onPacket. Set before start().
+    void onIoPacket(PacketHandler handler) { ioPacketHandler_ = std::move(handler); }
     void onConnect(ConnectHandler handler) { connectHandler_ = std::move(handler); }
     void onDisconnect(DisconnectHandler handler) { disconnectHandler_ = std::move(handler); }
 
@@ -48,12 +73,25 @@ public:
     void send(Connection::ConnectionId connId, proto::MessageType type,
               const google::protobuf::Message& message);
 
-    // Broadcast to all connections
+    // Broadcast to all connections (message is serialized once per frame format)
     void broadcast(proto::MessageType type, const google::protobuf::Message& message);
+    void broadcast(const FramePtr& frame);
 
     // Broadcast to all except one
     void broadcastExcept(Connection::ConnectionId exceptId, proto::MessageType type,
                          const google::protobuf::Message& message);
+    void broadcastExcept(Connection::ConnectionId exceptId, const FramePtr& frame);
+
+    // Per-connection outbound queue limit, applied to new connections
+    void setSendHighWaterMark(size_t bytes) { sendHighWaterMark_ = bytes; }
+
+    // Hold outgoing frames until flush(), so each client gets at most one
+    // write per tick (plus urgent frames). Set before start().
+    void setCoalesceWrites(bool enabled) { coalesceWrites_ = enabled; }
+    bool getCoalesceWrites() const { return coalesceWrites_; }
+
+    // Write out everything queued since the last flush (end of tick)
+    void flush();
 
     // Get connection by ID
     ConnectionPtr getConnection(Connection::ConnectionId id);
@@ -67,18 +105,39 @@ public:
 private:
     void startAccept();
     void handleAccept(const boost::system::error_code& ec, tcp::socket socket);
-    void processConnection(ConnectionPtr conn);
+    void startRead(ConnectionPtr conn);
+    void handleRead(ConnectionPtr conn, const boost::system::error_code& ec);
+    int dispatchPackets(const ConnectionPtr& conn);
     void removeDisconnected();
+    void removeConnection(Connection::ConnectionId id);
+    void addConnection(const ConnectionPtr& conn);
+    void notifyEvents();
+    int drainEvents();
+    void broadcastEncoded(Connection::ConnectionId exceptId, proto::MessageType type,
+                          const google::protobuf::Message& message);
 
     uint16_t port_;
+    IoMode mode_;
     asio::io_context io_;
     tcp::acceptor acceptor_;
     bool running_ = false;
 
     boost::container::flat_map<Connection::ConnectionId, ConnectionPtr> connections_;
-    Connection::ConnectionId nextConnectionId_ = 1;
+    std::atomic<Connection::ConnectionId> nextConnectionId_{1};
+    int asyncEventsProcessed_ = 0;
+    size_t sendHighWaterMark_ = 1024 * 1024;
+    bool coalesceWrites_ = false;
+
+    // I/O threads (empty when ioThreads_ == 0) and their inbound events
+    size_t ioThreads_;
+    std::vector<std::unique_ptr<IoWorker>> workers_;
+    std::unique_ptr<NetEventQueue> events_;
+    std::atomic<bool> drainScheduled_{false};
+    std::optional<asio::executor_work_guard<asio::io_context::executor_type>> work_;
+    static constexpr size_t EVENT_QUEUE_CAPACITY = 65536;
 
     PacketHandler packetHandler_;
+    PacketHandler ioPacketHandler_;
     ConnectHandler connectHandler_;
     DisconnectHandler disconnectHandler_;
 };
@@ -0,0 +1,72 @@
+#include "Command.hpp"
+
+namespace mmorpg {
+
+namespace {
+
+// Parse a request straight out of the receive buffer into a per-thread
+// message that is reused across packets
+template<typename T>
+const T* parsePayload(const net::PacketView& packet) {
+    static thread_local T message;
+    if (!message.ParseFromArray(packet.data, static_cast<int>(packet.size))) {
+        return nullptr;
+    }
+    return &message;
+}
+
+} // namespace
+
+bool decodeCommand(const net::PacketView& packet, Intent& out) {
+    switch (static_cast<proto::MessageType>(packet.type)) {
+        case proto::MSG_LOGIN_REQUEST: {
+            auto* req = parsePayload<proto::LoginRequest>(packet);
+            if (!req) return false;
+            out = LoginCommand{req->username()};
+            return true;
+        }
+        case proto::MSG_LOGOUT:
+            out = LogoutCommand{};
+            return true;
+        case proto::MSG_ATTACK_REQUEST: {
+            auto* req = parsePayload<proto::AttackRequest>(packet);
+            if (!req) return false;
+            out = AttackCommand{req->target_id()};
+            return true;
+        }
+        case proto::MSG_SKILL_REQUEST: {
+            auto* req = parsePayload<proto::SkillRequest>(packet);
+            if (!req) return false;
+            out = SkillCommand{req->skill_id(), req->target_id()};
+            return true;
+        }
+        case proto::MSG_LEARN_SKILL: {
+            auto* req = parsePayload<proto::LearnSkill>(packet);
+            if (!req) return false;
+            out = LearnSkillCommand{req->skill_id()};
+            return true;
+        }
+        case proto::MSG_UPGRADE_SKILL: {
+            auto* req = parsePayload<proto::UpgradeSkill>(packet);
+            if (!req) return false;
+            out = UpgradeSkillCommand{req->skill_id()};
+            return true;
+        }
+        case proto::MSG_CHAT: {
+            auto* chat = parsePayload<proto::Chat>(packet);
+            if (!chat) return false;
+            out = ChatCommand{chat->message()};
+            return true;
+        }
+        case proto::MSG_PING: {
+            auto* ping = parsePayload<proto::Ping>(packet);
+            if (!ping) return false;
+            out = PingCommand{ping->timestamp()};
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+} // namespace mmorpg
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../network/Connection.hpp"
+#include "../core/MpscQueue.hpp"
+#include "../core/Types.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <variant>
+
+namespace mmorpg {
+
+// Client intents decoded from packets. Plain data, so decoding can happen on
+// whichever thread read the packet while execution stays on the simulation
+// thread.
+struct LoginCommand {
+    std::string username;
+};
+
+struct LogoutCommand {};
+
+struct AttackCommand {
+    ActorId targetId = 0;
+};
+
+struct SkillCommand {
+    SkillId skillId = 0;
+    ActorId targetId = 0;
+};
+
+struct LearnSkillCommand {
+    SkillId skillId = 0;
+};
+
+struct UpgradeSkillCommand {
+    SkillId skillId = 0;
+};
+
+struct ChatCommand {
+    std::string message;
+};
+
+struct PingCommand {
+    uint64_t timestamp = 0;
+};
+
+using Intent = std::variant<
+    LoginCommand,
+    LogoutCommand,
+    AttackCommand,
+    SkillCommand,
+    LearnSkillCommand,
+    UpgradeSkillCommand,
+    ChatCommand,
+    PingCommand
+>;
+
+// A decoded intent tagged with the connection that sent it and when it
+// arrived
+struct Command {
+    using Clock = std::chrono::steady_clock;
+
+    net::ConnectionPtr conn;  // Issuing connection (and its ID)
+    Clock::time_point arrival;
+    Intent intent;
+
+    net::Connection::ConnectionId getConnectionId() const { return conn ? conn->getId() : 0; }
+};
+
+// Bounded lock-free queue of commands: filled by any number of threads (I/O
+// workers, or the simulation thread itself), drained at the start of a tick
+using CommandQueue = MpscQueue<Command>;
+
+// Decode a packet into an intent. Touches no game state, so it is safe to
+// call from any thread. Returns false for unknown or malformed packets.
+bool decodeCommand(const net::PacketView& packet, Intent& out);
+
+} // namespace mmorpg
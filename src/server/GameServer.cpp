@@ -1,5 +1,6 @@
 #include "GameServer.hpp"
-#include <iostream>
+#include "../core/Logger.hpp"
+#include "../core/Profiler.hpp"
 #include <chrono>
 #include <thread>
 
@@ -15,23 +16,46 @@ GameServer::Config GameServer::Config::loadFromFile(const std::string& filename)
         // Server settings
         config.port = tree.get<uint16_t>("server.port", config.port);
         config.tickRate = tree.get<uint32_t>("server.tick_rate", config.tickRate);
+        auto policy = tree.get<std::string>("server.overrun_policy", "catch_up");
+        if (policy == "catch_up") {
+            config.overrunPolicy = OverrunPolicy::CatchUp;
+        } else if (policy == "skip") {
+            config.overrunPolicy = OverrunPolicy::Skip;
+        } else {
+            LOG_WARN("Unknown overrun policy '" << policy << "', using catch_up");
+        }
+        config.maxCatchUpTicks = tree.get<uint32_t>("server.max_catch_up_ticks", config.maxCatchUpTicks);
+        config.profileTracePath = tree.get<std::string>("server.profile_trace_path", config.profileTracePath);
+        auto logLevel = tree.get<std::string>("server.log_level", Logger::levelName(config.logLevel));
+        if (!Logger::parseLevel(logLevel, config.logLevel)) {
+            LOG_WARN("Unknown log level '" << logLevel << "', using " << Logger::levelName(config.logLevel));
+        }
+        config.commandQueueCapacity = tree.get<uint32_t>("server.command_queue_capacity", config.commandQueueCapacity);
+        config.workerThreads = tree.get<uint32_t>("server.worker_threads", config.workerThreads);
 
         // Network settings
         config.maxConnections = tree.get<uint32_t>("network.max_connections", config.maxConnections);
         config.timeoutMs = tree.get<uint32_t>("network.timeout_ms", config.timeoutMs);
+        config.asyncIo = tree.get<bool>("network.async_io", config.asyncIo);
+        config.ioThreads = tree.get<uint32_t>("network.io_threads", config.ioThreads);
+        config.coalesceWrites = tree.get<bool>("network.coalesce_writes", config.coalesceWrites);
+        config.sendHighWaterMark = tree.get<uint32_t>("network.send_high_water_mark", config.sendHighWaterMark);
+        config.packetArenaBytes = tree.get<uint32_t>("network.packet_arena_bytes", config.packetArenaBytes);
 
         // Game settings
         config.startingLevel = tree.get<int32_t>("game.starting_level", config.startingLevel);
         config.startingSkillPoints = tree.get<int32_t>("game.starting_skill_points", config.startingSkillPoints);
         config.expMultiplier = tree.get<float>("game.exp_multiplier", config.expMultiplier);
+        config.respawnSeconds = tree.get<float>("game.respawn_seconds", config.respawnSeconds);
+        config.skillDataPath = tree.get<std::string>("game.skill_data", config.skillDataPath);
 
-        std::cout << "Loaded config from " << filename << std::endl;
+        LOG_INFO("Loaded config from " << filename);
     } catch (const pt::json_parser_error& e) {
-        std::cerr << "Config parse error: " << e.what() << std::endl;
-        std::cout << "Using default configuration" << std::endl;
+        LOG_ERROR("Config parse error: " << e.what());
+        LOG_INFO("Using default configuration");
     } catch (const std::exception& e) {
-        std::cerr << "Config load error: " << e.what() << std::endl;
-        std::cout << "Using default configuration" << std::endl;
+        LOG_ERROR("Config load error: " << e.what());
+        LOG_INFO("Using default configuration");
     }
 
     return config;
@@ -39,7 +63,7 @@ GameServer::Config GameServer::Config::loadFromFile(const std::string& filename)
 
 GameServer::GameServer(Config config)
     : config_(config)
-    , tickInterval_(1000 / config.tickRate) {
+    , scheduler_(config.tickRate, config.overrunPolicy, config.maxCatchUpTicks) {
 }
 
 GameServer::~GameServer() {
@@ -47,34 +71,53 @@ GameServer::~GameServer() {
 }
 
 bool GameServer::initialize() {
+    Logger::instance().setLevel(config_.logLevel);
+
     // Create systems
     eventBus_ = std::make_shared<EventBus>();
     actorManager_ = std::make_unique<ActorManager>();
     actorManager_->setEventBus(eventBus_);
+    if (config_.workerThreads > 0) {
+        jobs_ = std::make_unique<JobSystem>(config_.workerThreads);
+        actorManager_->setJobSystem(jobs_.get());
+    }
+    actorManager_->getTimers().setTickRate(config_.tickRate);
+    idleTimeoutTicks_ = actorManager_->getTimers().toTicks(config_.timeoutMs / 1000.0f);
     combatSystem_ = std::make_unique<CombatSystem>(*actorManager_, *eventBus_);
+    commandQueue_ = std::make_unique<CommandQueue>(config_.commandQueueCapacity);
+
+    // Message arena for packet handling
+    google::protobuf::ArenaOptions arenaOptions;
+    if (config_.packetArenaBytes > 0) {
+        arenaBlock_ = std::make_unique<char[]>(config_.packetArenaBytes);
+        arenaOptions.initial_block = arenaBlock_.get();
+        arenaOptions.initial_block_size = config_.packetArenaBytes;
+    }
+    tickArena_ = std::make_unique<google::protobuf::Arena>(arenaOptions);
 
     // Setup skill system
-    SkillDatabase::instance().loadDefaultSkills();
-    setupSkillTree();
+    if (!setupSkills()) {
+        return false;
+    }
 
     // Subscribe to events
-    damageEventId_ = eventBus_->subscribe([this](const GameEvent& event) {
-        if (auto* dmg = std::get_if<DamageEvent>(&event)) {
-            onDamageEvent(*dmg);
-        }
+    damageEventId_ = eventBus_->subscribe<DamageEvent>([this](const DamageEvent& event) {
+        onDamageEvent(event);
     });
 
-    deathEventId_ = eventBus_->subscribe([this](const GameEvent& event) {
-        if (auto* death = std::get_if<DeathEvent>(&event)) {
-            onDeathEvent(*death);
-        }
+    deathEventId_ = eventBus_->subscribe<DeathEvent>([this](const DeathEvent& event) {
+        onDeathEvent(event);
     });
 
     // Create TCP server
-    server_ = std::make_unique<net::TcpServer>(config_.port);
-
-    server_->onPacket([this](net::ConnectionPtr conn, const proto::Packet& packet) {
-        handlePacket(conn, packet);
+    server_ = std::make_unique<net::TcpServer>(
+        config_.port, config_.asyncIo ? net::IoMode::Async : net::IoMode::Poll, config_.ioThreads);
+    server_->setSendHighWaterMark(config_.sendHighWaterMark);
+    server_->setCoalesceWrites(config_.coalesceWrites);
+
+    // Decoded on the I/O thread that read the packet, executed at the next tick
+    server_->onIoPacket([this](net::ConnectionPtr conn, const net::PacketView& packet) {
+        enqueuePacket(conn, packet);
     });
 
     server_->onConnect([this](net::ConnectionPtr conn) {
@@ -86,7 +129,7 @@ bool GameServer::initialize() {
     });
 
     if (!server_->start()) {
-        std::cerr << "Failed to start server" << std::endl;
+        LOG_ERROR("Failed to start server");
         return false;
     }
 
@@ -94,19 +137,27 @@ bool GameServer::initialize() {
     tickTimer_ = std::make_unique<asio::steady_timer>(server_->getIoContext());
 
     running_ = true;
-    std::cout << "Game server initialized on port " << config_.port << std::endl;
+    LOG_INFO("Game server initialized on port " << config_.port);
     return true;
 }
 
 void GameServer::run() {
     if (!running_) return;
 
-    std::cout << "Game loop started (tick rate: " << config_.tickRate << " Hz)" << std::endl;
+    LOG_INFO("Game loop started (tick rate: " << config_.tickRate << " Hz)");
+    Profiler::instance().setThreadName("game");
 
     // Start the tick timer
+    scheduler_.start(TickScheduler::Clock::now());
     scheduleNextTick();
 
-    // Run the io_context - this blocks until stop() is called
+    if (server_->getIoMode() == net::IoMode::Async) {
+        // Block until stop(); socket reads and the tick timer wake us
+        server_->run();
+        return;
+    }
+
+    // Polling fallback
     while (running_) {
         // Poll for network events and timers
         server_->getIoContext().poll();
@@ -122,7 +173,8 @@ void GameServer::run() {
 void GameServer::scheduleNextTick() {
     if (!running_ || !tickTimer_) return;
 
-    tickTimer_->expires_after(tickInterval_);
+    // Absolute deadline: time spent ticking does not push the schedule back
+    tickTimer_->expires_at(scheduler_.getDeadline());
     tickTimer_->async_wait([this](const boost::system::error_code& ec) {
         onTickTimer(ec);
     });
@@ -132,7 +184,20 @@ void GameServer::onTickTimer(const boost::system::error_code& ec) {
     if (ec || !running_) return;
 
     // Perform game tick
+    uint64_t skipped = scheduler_.getStats().skippedTicks;
+    scheduler_.beginTick(TickScheduler::Clock::now());
     tick();
+    scheduler_.endTick(TickScheduler::Clock::now());
+
+    if (Profiler::instance().takeDumpRequest()) {
+        Profiler::instance().writeChromeTrace(config_.profileTracePath);
+    }
+
+    if (scheduler_.getStats().skippedTicks > skipped) {
+        LOG_WARN("Tick " << currentTick_ << " overran ("
+              << std::chrono::duration_cast<std::chrono::milliseconds>(scheduler_.getStats().lastDuration).count()
+              << " ms), skipped " << scheduler_.getStats().skippedTicks - skipped << " ticks");
+    }
 
     // Schedule next tick
     scheduleNextTick();
@@ -159,286 +224,336 @@ void GameServer::shutdown() {
     }
 
     connToCharacter_.clear();
+    idleTimers_.clear();
     actorManager_->clear();
+    actorManager_->getTimers().clear();
 
-    std::cout << "Game server shutdown complete" << std::endl;
+    LOG_INFO("Game server shutdown complete");
 }
 
 void GameServer::tick() {
+    PROFILE_ZONE("tick");
+
+    // Messages from the previous tick are all encoded by now
+    if (tickArena_) {
+        tickArena_->Reset();
+    }
+
+    {
+        PROFILE_ZONE("tick.commands");
+        drainCommands();
+        resolveSkills();
+    }
+
     currentTick_++;
-    actorManager_->updateAll(currentTick_);
+    {
+        PROFILE_ZONE("tick.actors");
+        actorManager_->updateAll(currentTick_);
+    }
+
+    // Deferred events raised during the tick
+    eventBus_->processQueue();
+
+    replicateActors();
+
+    // Everything this tick produced goes out as one write per client
+    server_->flush();
 }
 
-void GameServer::setupSkillTree() {
-    // Tier 1 skills (no prerequisites)
-    skillTree_.addNode({1, {}, {4}, 1});      // Slash -> Power Strike
-    skillTree_.addNode({2, {}, {5}, 1});      // Fireball -> Flame Wave
-    skillTree_.addNode({3, {}, {6}, 1});      // Heal -> Regeneration
-
-    // Tier 2 skills
-    skillTree_.addNode({4, {1}, {7}, 2});     // Power Strike -> Berserk
-    skillTree_.addNode({5, {2}, {8}, 2});     // Flame Wave -> Meteor
-    skillTree_.addNode({6, {3}, {9}, 2});     // Regeneration -> Divine Shield
-
-    // Tier 3 skills
-    skillTree_.addNode({7, {4}, {}, 3});      // Berserk
-    skillTree_.addNode({8, {5}, {}, 3});      // Meteor
-    skillTree_.addNode({9, {6}, {}, 3});      // Divine Shield
+void GameServer::replicateActors() {
+    PROFILE_ZONE("tick.replicate");
+
+    dirtyRows_.clear();
+    actorManager_->collectDirty(dirtyRows_);
+
+    const ActorComponents& components = actorManager_->getComponents();
+    auto* update = newMessage<proto::ActorUpdate>();
+    for (ActorComponents::Row row : dirtyRows_) {
+        const Position& position = components.position(row);
+        update->set_actor_id(components.id(row));
+        update->set_current_hp(components.hp(row));
+        update->set_current_mp(components.mp(row));
+        update->set_pos_x(position.x);
+        update->set_pos_y(position.y);
+        server_->broadcast(proto::MSG_ACTOR_UPDATE, *update);
+    }
 }
 
-void GameServer::handlePacket(net::ConnectionPtr conn, const proto::Packet& packet) {
-    auto type = static_cast<proto::MessageType>(packet.type());
+bool GameServer::setupSkills() {
+    SkillDatabase& db = SkillDatabase::instance();
+    db.setTickRate(config_.tickRate);
+
+    // A compiled snapshot (skillc) is mapped; anything else is a JSON data file
+    const std::string& path = config_.skillDataPath;
+    bool loaded = true;
+    if (path.empty()) {
+        db.loadDefaultSkills();
+    } else if (path.size() > 4 && path.compare(path.size() - 4, 4, ".bin") == 0) {
+        loaded = db.loadSnapshot(path);
+    } else {
+        loaded = db.loadDefinitions(path);
+    }
+    if (!loaded) {
+        LOG_ERROR("Failed to load skill data from " << path);
+        return false;
+    }
 
-    switch (type) {
-        case proto::MSG_LOGIN_REQUEST: {
-            proto::LoginRequest req;
-            if (req.ParseFromString(packet.payload())) {
-                handleLogin(conn, req);
-            }
-            break;
-        }
-        case proto::MSG_LOGOUT:
-            handleLogout(conn);
-            break;
-        case proto::MSG_ATTACK_REQUEST: {
-            proto::AttackRequest req;
-            if (req.ParseFromString(packet.payload())) {
-                handleAttack(conn, req);
-            }
-            break;
-        }
-        case proto::MSG_SKILL_REQUEST: {
-            proto::SkillRequest req;
-            if (req.ParseFromString(packet.payload())) {
-                handleSkillRequest(conn, req);
-            }
-            break;
-        }
-        case proto::MSG_LEARN_SKILL: {
-            proto::LearnSkill req;
-            if (req.ParseFromString(packet.payload())) {
-                handleLearnSkill(conn, req);
-            }
-            break;
-        }
-        case proto::MSG_UPGRADE_SKILL: {
-            proto::UpgradeSkill req;
-            if (req.ParseFromString(packet.payload())) {
-                handleUpgradeSkill(conn, req);
-            }
-            break;
-        }
-        case proto::MSG_CHAT: {
-            proto::Chat chat;
-            if (chat.ParseFromString(packet.payload())) {
-                handleChat(conn, chat);
-            }
-            break;
-        }
-        case proto::MSG_PING: {
-            proto::Ping ping;
-            if (ping.ParseFromString(packet.payload())) {
-                handlePing(conn, ping);
-            }
-            break;
+    combatSystem_->getSkillExecutor().setEffects(CompiledSkillEffects::compile(db));
+    skillTree_ = CompiledSkillTree::compile(db.buildTree());
+    return skillTree_ != nullptr;
+}
+
+void GameServer::enqueuePacket(const net::ConnectionPtr& conn, const net::PacketView& packet) {
+    Command command;
+    command.conn = conn;
+    command.arrival = Command::Clock::now();
+    if (!decodeCommand(packet, command.intent)) {
+        LOG_WARN("Unknown or malformed packet type: " << packet.type);
+        return;
+    }
+
+    if (!commandQueue_->tryPush(std::move(command))) {
+        LOG_WARN("Command queue full, dropping packet from connection #"
+              << conn->getId());
+    }
+}
+
+size_t GameServer::drainCommands() {
+    size_t executed = 0;
+    Command command;
+    while (commandQueue_->tryPop(command)) {
+        // The client may have gone between the packet and this tick
+        if (!command.conn->isConnected()) continue;
+
+        auto idle = idleTimers_.find(command.conn->getId());
+        if (idle != idleTimers_.end()) {
+            idle->second.lastActivity = currentTick_;
         }
-        default:
-            std::cerr << "Unknown packet type: " << packet.type() << std::endl;
-            break;
+
+        std::visit([this, &command](const auto& intent) {
+            handle(command.conn, intent);
+        }, command.intent);
+        executed++;
     }
+    command = Command{};
+    return executed;
 }
 
-void GameServer::handleLogin(net::ConnectionPtr conn, const proto::LoginRequest& req) {
-    std::cout << "Login request from " << req.username() << std::endl;
+void GameServer::handle(const net::ConnectionPtr& conn, const LoginCommand& cmd) {
+    LOG_DEBUG("Login request from " << cmd.username);
 
     // Create character for this connection
-    auto character = actorManager_->createActor<Character>(req.username());
+    auto character = actorManager_->createActor<Character>(cmd.username);
     character->setSkillTree(skillTree_);
 
     // Random stats for variety
-    character->setPrimaryStat("strength", 10 + (conn->getId() % 10));
-    character->setPrimaryStat("intelligence", 10 + ((conn->getId() * 3) % 10));
-    character->setPrimaryStat("agility", 10 + ((conn->getId() * 7) % 10));
+    character->setPrimaryStat(PrimaryStat::Strength, 10 + (conn->getId() % 10));
+    character->setPrimaryStat(PrimaryStat::Intelligence, 10 + ((conn->getId() * 3) % 10));
+    character->setPrimaryStat(PrimaryStat::Agility, 10 + ((conn->getId() * 7) % 10));
 
     conn->setActorId(character->getId());
     connToCharacter_[conn->getId()] = character;
 
     // Send login response
-    proto::LoginResponse response;
-    response.set_success(true);
-    response.set_actor_id(character->getId());
-    response.set_message("Welcome to the game, " + req.username() + "!");
-    *response.mutable_actor() = buildActorInfo(*character);
+    auto* response = newMessage<proto::LoginResponse>();
+    response->set_success(true);
+    response->set_actor_id(character->getId());
+    response->set_message("Welcome to the game, " + cmd.username + "!");
+    fillActorInfo(*response->mutable_actor(), *character);
 
-    conn->sendPacket(proto::MSG_LOGIN_RESPONSE, response);
+    conn->sendPacket(proto::MSG_LOGIN_RESPONSE, *response);
 
     // Broadcast spawn to all other players
-    proto::ActorSpawn spawn;
-    *spawn.mutable_actor() = buildActorInfo(*character);
-    server_->broadcastExcept(conn->getId(), proto::MSG_ACTOR_SPAWN, spawn);
+    auto* spawn = newMessage<proto::ActorSpawn>();
+    *spawn->mutable_actor() = response->actor();
+    server_->broadcastExcept(conn->getId(), proto::MSG_ACTOR_SPAWN, *spawn);
 
     // Send existing actors to new player
-    proto::ActorList actorList;
+    auto* actorList = newMessage<proto::ActorList>();
     for (auto& [connId, otherChar] : connToCharacter_) {
         if (connId != conn->getId()) {
-            *actorList.add_actors() = buildActorInfo(*otherChar);
+            fillActorInfo(*actorList->add_actors(), *otherChar);
         }
     }
-    if (actorList.actors_size() > 0) {
-        conn->sendPacket(proto::MSG_ACTOR_LIST, actorList);
+    if (actorList->actors_size() > 0) {
+        conn->sendPacket(proto::MSG_ACTOR_LIST, *actorList);
     }
 
     // Send skill list
-    conn->sendPacket(proto::MSG_SKILL_LIST, buildSkillList(*character));
+    conn->sendPacket(proto::MSG_SKILL_LIST, *buildSkillList(*character));
 
-    std::cout << "Player " << req.username() << " joined (Actor ID: "
-              << character->getId() << ")" << std::endl;
+    LOG_INFO("Player " << cmd.username << " joined (Actor ID: "
+          << character->getId() << ")");
 }
 
-void GameServer::handleLogout(net::ConnectionPtr conn) {
+void GameServer::handle(const net::ConnectionPtr& conn, const LogoutCommand& /*cmd*/) {
     onDisconnect(conn);
     server_->disconnect(conn->getId());
 }
 
-void GameServer::handleAttack(net::ConnectionPtr conn, const proto::AttackRequest& req) {
+void GameServer::handle(const net::ConnectionPtr& conn, const AttackCommand& cmd) {
     auto it = connToCharacter_.find(conn->getId());
     if (it == connToCharacter_.end()) return;
 
     auto& attacker = it->second;
-    auto target = actorManager_->getActor(req.target_id());
+    // Owning: damage/death subscribers run before we read the target's HP
+    auto target = actorManager_->getActor(cmd.targetId);
     if (!target) return;
 
     // Process attack through combat system
     auto result = combatSystem_->handleBasicAttack(
-        BasicAttack{attacker->getId(), req.target_id(), true}
+        BasicAttack{attacker->getId(), cmd.targetId, true}
     );
 
     // Send result to attacker
-    proto::AttackResult attackResult;
-    attackResult.set_attacker_id(attacker->getId());
-    attackResult.set_target_id(req.target_id());
-    attackResult.set_damage(result.finalDamage);
-    attackResult.set_is_critical(result.isCritical);
-    attackResult.set_is_dodged(result.isDodged);
-    attackResult.set_target_hp(target->getRuntimeStats().currentHp);
+    auto* attackResult = newMessage<proto::AttackResult>();
+    attackResult->set_attacker_id(attacker->getId());
+    attackResult->set_target_id(cmd.targetId);
+    attackResult->set_damage(result.finalDamage);
+    attackResult->set_is_critical(result.isCritical);
+    attackResult->set_is_dodged(result.isDodged);
+    attackResult->set_target_hp(target->getRuntimeStats().currentHp);
 
     // Broadcast to all
-    server_->broadcast(proto::MSG_ATTACK_RESULT, attackResult);
+    server_->broadcast(proto::MSG_ATTACK_RESULT, *attackResult);
 }
 
-void GameServer::handleSkillRequest(net::ConnectionPtr conn, const proto::SkillRequest& req) {
+void GameServer::handle(const net::ConnectionPtr& conn, const SkillCommand& cmd) {
     auto it = connToCharacter_.find(conn->getId());
     if (it == connToCharacter_.end()) return;
 
     auto& caster = it->second;
 
-    proto::SkillResult result;
-    result.set_caster_id(caster->getId());
-    result.set_skill_id(req.skill_id());
-    result.set_target_id(req.target_id());
+    auto* result = newMessage<proto::SkillResult>();
+    result->set_caster_id(caster->getId());
+    result->set_skill_id(cmd.skillId);
+    result->set_target_id(cmd.targetId);
+
+    // Try to use the skill; its effects resolve with the tick's other casts
+    if (caster->useSkill(cmd.skillId)) {
+        result->set_success(true);
+        std::string_view name = SkillDatabase::instance().getName(cmd.skillId);
+        result->set_message(caster->getName() + " uses " + std::string(name) + "!");
+
+        SkillCast cast;
+        cast.caster = caster->getId();
+        cast.skill = cmd.skillId;
+        cast.level = caster->getSkillLevel(cmd.skillId);
+        cast.target = cmd.targetId;
+        const Actor* target = actorManager_->findActor(cmd.targetId);
+        cast.center = target ? target->getPosition() : caster->getPosition();
+        pendingSkills_.push_back({conn, result, combatSystem_->getSkillExecutor().queue(cast)});
+        return;
+    }
 
-    // Try to use the skill
-    if (caster->useSkill(req.skill_id())) {
-        result.set_success(true);
+    result->set_success(false);
+    result->set_message("Cannot use skill!");
+    server_->broadcast(proto::MSG_SKILL_RESULT, *result);
+    conn->sendPacket(proto::MSG_SKILL_LIST, *buildSkillList(*caster));
+}
 
-        // Get skill info
-        auto* skill = SkillDatabase::instance().getSkill(req.skill_id());
-        if (skill) {
-            result.set_damage(caster->getSkillLevel(req.skill_id()) * 20);  // Simplified
-            result.set_message(caster->getName() + " uses " + skill->getName() + "!");
-        }
+void GameServer::resolveSkills() {
+    if (pendingSkills_.empty()) return;
 
-        // Apply damage if target exists
-        if (req.target_id() != 0) {
-            auto target = actorManager_->getActor(req.target_id());
-            if (target) {
-                target->takeDamage(result.damage());
-            }
+    const std::vector<CastResult>& casts = combatSystem_->getSkillExecutor().execute();
+    for (const PendingSkill& pending : pendingSkills_) {
+        pending.result->set_damage(casts[pending.cast].damage);
+        server_->broadcast(proto::MSG_SKILL_RESULT, *pending.result);
+
+        // Send updated skill list (cooldowns changed)
+        auto it = connToCharacter_.find(pending.conn->getId());
+        if (it != connToCharacter_.end()) {
+            pending.conn->sendPacket(proto::MSG_SKILL_LIST, *buildSkillList(*it->second));
         }
-    } else {
-        result.set_success(false);
-        result.set_message("Cannot use skill!");
     }
-
-    server_->broadcast(proto::MSG_SKILL_RESULT, result);
-
-    // Send updated skill list (cooldowns changed)
-    conn->sendPacket(proto::MSG_SKILL_LIST, buildSkillList(*caster));
+    pendingSkills_.clear();
 }
 
-void GameServer::handleLearnSkill(net::ConnectionPtr conn, const proto::LearnSkill& req) {
+void GameServer::handle(const net::ConnectionPtr& conn, const LearnSkillCommand& cmd) {
     auto it = connToCharacter_.find(conn->getId());
     if (it == connToCharacter_.end()) return;
 
     auto& character = it->second;
-    bool success = character->learnSkill(req.skill_id());
+    bool success = character->learnSkill(cmd.skillId);
 
     // Send updated skill list
-    conn->sendPacket(proto::MSG_SKILL_LIST, buildSkillList(*character));
+    conn->sendPacket(proto::MSG_SKILL_LIST, *buildSkillList(*character));
 
     if (!success) {
-        proto::Error error;
-        error.set_code(1);
-        error.set_message("Cannot learn this skill!");
-        conn->sendPacket(proto::MSG_ERROR, error);
+        auto* error = newMessage<proto::Error>();
+        error->set_code(1);
+        error->set_message("Cannot learn this skill!");
+        conn->sendPacket(proto::MSG_ERROR, *error);
     }
 }
 
-void GameServer::handleUpgradeSkill(net::ConnectionPtr conn, const proto::UpgradeSkill& req) {
+void GameServer::handle(const net::ConnectionPtr& conn, const UpgradeSkillCommand& cmd) {
     auto it = connToCharacter_.find(conn->getId());
     if (it == connToCharacter_.end()) return;
 
     auto& character = it->second;
-    bool success = character->upgradeSkill(req.skill_id());
+    bool success = character->upgradeSkill(cmd.skillId);
 
     // Send updated skill list
-    conn->sendPacket(proto::MSG_SKILL_LIST, buildSkillList(*character));
+    conn->sendPacket(proto::MSG_SKILL_LIST, *buildSkillList(*character));
 
     if (!success) {
-        proto::Error error;
-        error.set_code(2);
-        error.set_message("Cannot upgrade this skill!");
-        conn->sendPacket(proto::MSG_ERROR, error);
+        auto* error = newMessage<proto::Error>();
+        error->set_code(2);
+        error->set_message("Cannot upgrade this skill!");
+        conn->sendPacket(proto::MSG_ERROR, *error);
     }
 }
 
-void GameServer::handleChat(net::ConnectionPtr conn, const proto::Chat& chat) {
+void GameServer::handle(const net::ConnectionPtr& conn, const ChatCommand& cmd) {
     auto it = connToCharacter_.find(conn->getId());
     if (it == connToCharacter_.end()) return;
 
-    proto::Chat broadcastChat;
-    broadcastChat.set_sender_id(it->second->getId());
-    broadcastChat.set_sender_name(it->second->getName());
-    broadcastChat.set_message(chat.message());
+    auto* broadcastChat = newMessage<proto::Chat>();
+    broadcastChat->set_sender_id(it->second->getId());
+    broadcastChat->set_sender_name(it->second->getName());
+    broadcastChat->set_message(cmd.message);
 
-    server_->broadcast(proto::MSG_CHAT, broadcastChat);
+    server_->broadcast(proto::MSG_CHAT, *broadcastChat);
 }
 
-void GameServer::handlePing(net::ConnectionPtr conn, const proto::Ping& ping) {
-    proto::Pong pong;
-    pong.set_timestamp(ping.timestamp());
-    conn->sendPacket(proto::MSG_PONG, pong);
+void GameServer::handle(const net::ConnectionPtr& conn, const PingCommand& cmd) {
+    auto* pong = newMessage<proto::Pong>();
+    pong->set_timestamp(cmd.timestamp);
+    // Latency probes skip the end-of-tick batch
+    conn->sendPacket(proto::MSG_PONG, *pong, net::SendLane::Urgent);
 }
 
 void GameServer::onConnect(net::ConnectionPtr conn) {
-    std::cout << "Connection #" << conn->getId() << " established" << std::endl;
+    LOG_INFO("Connection #" << conn->getId() << " established");
+
+    if (idleTimeoutTicks_ > 0) {
+        idleTimers_[conn->getId()].lastActivity = currentTick_;
+        scheduleIdleCheck(conn->getId(), currentTick_ + idleTimeoutTicks_);
+    }
 }
 
 void GameServer::onDisconnect(net::ConnectionPtr conn) {
+    auto idle = idleTimers_.find(conn->getId());
+    if (idle != idleTimers_.end()) {
+        actorManager_->getTimers().cancel(idle->second.timer);
+        idleTimers_.erase(idle);
+    }
+
     auto it = connToCharacter_.find(conn->getId());
     if (it != connToCharacter_.end()) {
         auto& character = it->second;
 
         // Broadcast despawn
-        proto::ActorDespawn despawn;
-        despawn.set_actor_id(character->getId());
-        server_->broadcastExcept(conn->getId(), proto::MSG_ACTOR_DESPAWN, despawn);
+        auto* despawn = newMessage<proto::ActorDespawn>();
+        despawn->set_actor_id(character->getId());
+        server_->broadcastExcept(conn->getId(), proto::MSG_ACTOR_DESPAWN, *despawn);
 
         // Remove from manager
         actorManager_->removeActor(character->getId());
         connToCharacter_.erase(it);
 
-        std::cout << "Player " << character->getName() << " left" << std::endl;
+        LOG_INFO("Player " << character->getName() << " left");
     }
 }
 
@@ -448,24 +563,56 @@ void GameServer::onDamageEvent(const DamageEvent& event) {
 
 void GameServer::onDeathEvent(const DeathEvent& event) {
     // Broadcast death notification
-    proto::Chat deathMsg;
-    deathMsg.set_sender_id(0);
-    deathMsg.set_sender_name("System");
+    auto* deathMsg = newMessage<proto::Chat>();
+    deathMsg->set_sender_id(0);
+    deathMsg->set_sender_name("System");
 
-    auto victim = actorManager_->getActor(event.actor);
-    auto killer = actorManager_->getActor(event.killer);
+    const Actor* victim = actorManager_->findActor(event.actor);
+    const Actor* killer = actorManager_->findActor(event.killer);
 
     if (victim && killer) {
-        deathMsg.set_message(victim->getName() + " was killed by " + killer->getName() + "!");
+        deathMsg->set_message(victim->getName() + " was killed by " + killer->getName() + "!");
     } else if (victim) {
-        deathMsg.set_message(victim->getName() + " has died!");
+        deathMsg->set_message(victim->getName() + " has died!");
+    }
+
+    server_->broadcast(proto::MSG_CHAT, *deathMsg);
+
+    if (victim) {
+        ActorId id = event.actor;
+        Tick delay = actorManager_->getTimers().toTicks(config_.respawnSeconds);
+        actorManager_->getTimers().schedule(delay, [this, id] { respawn(id); });
+    }
+}
+
+void GameServer::respawn(ActorId id) {
+    // The actor may have logged out since it died
+    if (Actor* actor = actorManager_->findActor(id)) {
+        actor->revive();
+    }
+}
+
+void GameServer::scheduleIdleCheck(net::Connection::ConnectionId id, Tick at) {
+    idleTimers_[id].timer = actorManager_->getTimers().scheduleAt(at, [this, id] { checkIdle(id); });
+}
+
+void GameServer::checkIdle(net::Connection::ConnectionId id) {
+    auto idle = idleTimers_.find(id);
+    if (idle == idleTimers_.end()) return;
+
+    Tick deadline = idle->second.lastActivity + idleTimeoutTicks_;
+    if (deadline > currentTick_) {
+        // Active since the timer was set; look again at the new deadline
+        scheduleIdleCheck(id, deadline);
+        return;
     }
 
-    server_->broadcast(proto::MSG_CHAT, deathMsg);
+    LOG_INFO("Connection #" << id << " timed out after " << config_.timeoutMs << " ms idle");
+    idleTimers_.erase(idle);
+    server_->disconnect(id);
 }
 
-proto::ActorInfo GameServer::buildActorInfo(const Character& character) {
-    proto::ActorInfo info;
+void GameServer::fillActorInfo(proto::ActorInfo& info, const Character& character) {
     info.set_id(character.getId());
     info.set_name(character.getName());
     info.set_level(character.getLevel());
@@ -475,33 +622,34 @@ proto::ActorInfo GameServer::buildActorInfo(const Character& character) {
     info.set_max_mp(character.getDerivedStats().maxMp);
 
     auto* stats = info.mutable_stats();
-    const auto& primary = character.getPrimaryStats();
+    const PrimaryStats primary = character.getEffectivePrimaryStats();
     stats->set_strength(primary.strength);
     stats->set_agility(primary.agility);
     stats->set_intelligence(primary.intelligence);
     stats->set_vitality(primary.vitality);
     stats->set_wisdom(primary.wisdom);
     stats->set_luck(primary.luck);
-
-    return info;
 }
 
-proto::SkillList GameServer::buildSkillList(const Character& character) {
-    proto::SkillList list;
-    list.set_skill_points(character.getSkillPoints());
+proto::SkillList* GameServer::buildSkillList(const Character& character) {
+    auto* list = newMessage<proto::SkillList>();
+    list->set_skill_points(character.getSkillPoints());
 
-    for (SkillId id : character.getLearnedSkills()) {
-        auto* skill = SkillDatabase::instance().getSkill(id);
-        if (skill) {
-            auto* info = list.add_skills();
+    const SkillDatabase& db = SkillDatabase::instance();
+    character.forEachLearnedSkill([&](SkillId id, int32_t level) {
+        if (const SkillRecord* skill = db.getRecord(id)) {
+            auto* info = list->add_skills();
             info->set_id(id);
-            info->set_name(skill->getName());
-            info->set_level(character.getSkillLevel(id));
-            info->set_max_level(skill->getMaxLevel());
-            info->set_mana_cost(skill->getManaCost());
-            info->set_cooldown(skill->getCooldown());
+            info->set_name(std::string(db.getName(id)));
+            info->set_level(level);
+            info->set_max_level(skill->maxLevel);
+            // At the character's level
+            if (const auto* stats = db.getLevelStats(id, level)) {
+                info->set_mana_cost(stats->manaCost);
+                info->set_cooldown(stats->cooldown);
+            }
         }
-    }
+    });
 
     return list;
 }
@@ -1,15 +1,20 @@
 #pragma once
 
+#include "Command.hpp"
+#include "TickScheduler.hpp"
 #include "../network/TcpServer.hpp"
 #include "../actors/Character.hpp"
 #include "../actors/ActorManager.hpp"
 #include "../combat/CombatSystem.hpp"
 #include "../core/EventBus.hpp"
-#include "../skills/SkillTree.hpp"
+#include "../core/JobSystem.hpp"
+#include "../core/Logger.hpp"
+#include "../skills/CompiledSkillTree.hpp"
 #include <boost/asio.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/container/flat_map.hpp>
+#include <google/protobuf/arena.h>
 #include <memory>
 #include <string>
 
@@ -24,15 +29,28 @@ public:
         // Server settings
         uint16_t port = 7777;
         uint32_t tickRate = 20;  // Ticks per second
+        OverrunPolicy overrunPolicy = OverrunPolicy::CatchUp;  // When a tick runs past the next deadline
+        uint32_t maxCatchUpTicks = 5;  // Missed ticks replayed before the rest are skipped
+        std::string profileTracePath = "tick_trace.json";  // Written on SIGUSR1
+        LogLevel logLevel = LogLevel::Info;
+        uint32_t commandQueueCapacity = 65536;  // Client commands buffered between ticks
+        uint32_t workerThreads = 0;  // Simulation threads besides the tick thread; 0 = tick thread only
 
         // Network settings
         uint32_t maxConnections = 100;
-        uint32_t timeoutMs = 30000;
+        uint32_t timeoutMs = 30000;  // Idle connections are dropped after this; 0 = never
+        bool asyncIo = true;  // Readiness-driven reads instead of polling
+        uint32_t ioThreads = 0;  // Network I/O threads; 0 = network on the game thread
+        bool coalesceWrites = true;  // One write per client per tick (Pong excepted)
+        uint32_t sendHighWaterMark = 1024 * 1024;  // Max queued outbound bytes per client
+        uint32_t packetArenaBytes = 256 * 1024;  // Preallocated per-tick message arena
 
         // Game settings
         int32_t startingLevel = 1;
         int32_t startingSkillPoints = 3;
         float expMultiplier = 1.0f;
+        float respawnSeconds = 10.0f;  // Dead actors come back after this
+        std::string skillDataPath;     // JSON definitions or a .bin snapshot; empty = built-in skills
 
         // Load config from JSON file
         static Config loadFromFile(const std::string& filename);
@@ -51,18 +69,37 @@ public:
     ActorManager& getActorManager() { return *actorManager_; }
     CombatSystem& getCombatSystem() { return *combatSystem_; }
     EventBus& getEventBus() { return *eventBus_; }
+    net::TcpServer& getNetwork() { return *server_; }
+
+    // Advance one simulation tick (normally driven by the tick timer).
+    // Commands received since the last tick are executed first.
+    void tick();
+
+    // Timing of timer-driven ticks (duration, lateness, overruns)
+    const TickScheduler::Stats& getTickStats() const { return scheduler_.getStats(); }
+
+    // Commands waiting for the next tick
+    size_t getPendingCommands() const { return commandQueue_ ? commandQueue_->size() : 0; }
+
+    // Bytes of the per-tick message arena in use since the last tick
+    uint64_t getTickArenaUsed() const { return tickArena_ ? tickArena_->SpaceUsed() : 0; }
 
 private:
-    // Packet handlers
-    void handlePacket(net::ConnectionPtr conn, const proto::Packet& packet);
-    void handleLogin(net::ConnectionPtr conn, const proto::LoginRequest& req);
-    void handleLogout(net::ConnectionPtr conn);
-    void handleAttack(net::ConnectionPtr conn, const proto::AttackRequest& req);
-    void handleSkillRequest(net::ConnectionPtr conn, const proto::SkillRequest& req);
-    void handleLearnSkill(net::ConnectionPtr conn, const proto::LearnSkill& req);
-    void handleUpgradeSkill(net::ConnectionPtr conn, const proto::UpgradeSkill& req);
-    void handleChat(net::ConnectionPtr conn, const proto::Chat& chat);
-    void handlePing(net::ConnectionPtr conn, const proto::Ping& ping);
+    // Decode a packet and queue it for the next tick (any thread)
+    void enqueuePacket(const net::ConnectionPtr& conn, const net::PacketView& packet);
+
+    // Execute queued commands (simulation thread, start of tick)
+    size_t drainCommands();
+
+    // Command handlers
+    void handle(const net::ConnectionPtr& conn, const LoginCommand& cmd);
+    void handle(const net::ConnectionPtr& conn, const LogoutCommand& cmd);
+    void handle(const net::ConnectionPtr& conn, const AttackCommand& cmd);
+    void handle(const net::ConnectionPtr& conn, const SkillCommand& cmd);
+    void handle(const net::ConnectionPtr& conn, const LearnSkillCommand& cmd);
+    void handle(const net::ConnectionPtr& conn, const UpgradeSkillCommand& cmd);
+    void handle(const net::ConnectionPtr& conn, const ChatCommand& cmd);
+    void handle(const net::ConnectionPtr& conn, const PingCommand& cmd);
 
     // Connection events
     void onConnect(net::ConnectionPtr conn);
@@ -72,39 +109,85 @@ private:
     void onDamageEvent(const DamageEvent& event);
     void onDeathEvent(const DeathEvent& event);
 
-    // Game loop
-    void tick();
+    // Timers on the actor manager's wheel
+    void respawn(ActorId id);
+    void scheduleIdleCheck(net::Connection::ConnectionId id, Tick at);
+    void checkIdle(net::Connection::ConnectionId id);
+
+    // Broadcast an ActorUpdate for every actor whose HP/MP/position changed
+    void replicateActors();
+
+    // Helper to fill an ActorInfo proto
+    void fillActorInfo(proto::ActorInfo& info, const Character& character);
 
-    // Helper to build ActorInfo proto
-    proto::ActorInfo buildActorInfo(const Character& character);
+    // Helper to build SkillList proto (on the tick arena)
+    proto::SkillList* buildSkillList(const Character& character);
 
-    // Helper to build SkillList proto
-    proto::SkillList buildSkillList(const Character& character);
+    // Response messages live on the tick arena; they only have to outlive
+    // the handler, since outgoing frames are encoded immediately
+    template<typename T>
+    T* newMessage() { return google::protobuf::Arena::CreateMessage<T>(tickArena_.get()); }
 
-    // Create default skill tree
-    void setupSkillTree();
+    // Load skill definitions and compile the skill tree and effects
+    bool setupSkills();
+
+    // Resolve the skill casts queued while draining commands and send
+    // their results
+    void resolveSkills();
 
     Config config_;
     bool running_ = false;
 
     // Core systems
+    std::unique_ptr<JobSystem> jobs_;  // Outlives the actor manager using it
     std::shared_ptr<EventBus> eventBus_;
     std::unique_ptr<ActorManager> actorManager_;
     std::unique_ptr<CombatSystem> combatSystem_;
     std::unique_ptr<net::TcpServer> server_;
 
+    // Client commands, decoded where packets are read and executed by tick()
+    std::unique_ptr<CommandQueue> commandQueue_;
+
     // Mapping connection to character
     boost::container::flat_map<net::Connection::ConnectionId, std::shared_ptr<Character>> connToCharacter_;
 
-    // Skill tree template
-    SkillTree skillTree_;
+    // Idle timeouts: the last tick each connection sent a command, and a
+    // timer due when it would time out. The timer only looks again when
+    // it fires, so activity costs a store, not a reschedule.
+    struct IdleTimer {
+        Tick lastActivity = 0;
+        TimingWheel::TimerId timer = TimingWheel::INVALID_TIMER;
+    };
+    boost::container::flat_map<net::Connection::ConnectionId, IdleTimer> idleTimers_;
+    Tick idleTimeoutTicks_ = 0;  // 0 = disabled
+
+    // Skill tree, compiled once and shared by every character
+    SkillTreePtr skillTree_;
+
+    // Skill results waiting on this tick's cast batch
+    struct PendingSkill {
+        net::ConnectionPtr conn;
+        proto::SkillResult* result;  // On the tick arena
+        size_t cast;                 // Index in the executor's results
+    };
+    std::vector<PendingSkill> pendingSkills_;
 
     // Tick counter
     Tick currentTick_ = 0;
 
-    // Timer for game tick (uses TcpServer's io_context)
+    // Scratch list of changed component rows, reused every tick
+    std::vector<ActorComponents::Row> dirtyRows_;
+
+    // Per-tick message arena, reset at each tick boundary. Its first block
+    // is owned here and survives Reset(), so steady-state packet handling
+    // does not touch the heap for message objects.
+    std::unique_ptr<char[]> arenaBlock_;
+    std::unique_ptr<google::protobuf::Arena> tickArena_;
+
+    // Timer for game tick (uses TcpServer's io_context), armed for the
+    // scheduler's absolute deadlines
     std::unique_ptr<asio::steady_timer> tickTimer_;
-    std::chrono::milliseconds tickInterval_;
+    TickScheduler scheduler_;
 
     // Async tick handler
     void scheduleNextTick();
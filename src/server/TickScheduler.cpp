@@ -0,0 +1,58 @@
+#include "TickScheduler.hpp"
+#include <algorithm>
+
+namespace mmorpg {
+
+TickScheduler::TickScheduler(uint32_t tickRate, OverrunPolicy policy, uint32_t maxCatchUpTicks)
+    : tickRate_(std::max<uint32_t>(tickRate, 1))
+    , policy_(policy)
+    , maxCatchUpTicks_(maxCatchUpTicks) {
+}
+
+void TickScheduler::start(Clock::time_point now) {
+    start_ = now;
+    next_ = 1;
+}
+
+TickScheduler::Clock::time_point TickScheduler::deadline(uint64_t index) const {
+    // Exact for any rate: no per-tick truncation to whole milliseconds
+    auto sinceStart = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::nanoseconds(index * 1000000000ull / tickRate_));
+    return start_ + sinceStart;
+}
+
+uint64_t TickScheduler::firstDeadlineAfter(Clock::time_point now) const {
+    if (now < start_) return 1;
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_).count();
+    uint64_t index = static_cast<uint64_t>(elapsed) * tickRate_ / 1000000000ull + 1;
+    while (deadline(index) <= now) index++;
+    return index;
+}
+
+void TickScheduler::beginTick(Clock::time_point now) {
+    tickStart_ = now;
+    auto lateness = std::max(now - getDeadline(), Clock::duration::zero());
+    stats_.lastLateness = lateness;
+    stats_.maxLateness = std::max(stats_.maxLateness, lateness);
+}
+
+void TickScheduler::endTick(Clock::time_point now) {
+    auto duration = now - tickStart_;
+    stats_.ticks++;
+    stats_.lastDuration = duration;
+    stats_.maxDuration = std::max(stats_.maxDuration, duration);
+    stats_.totalDuration += duration;
+
+    next_++;
+    if (getDeadline() > now) return;
+
+    // Behind schedule: the next deadline has already passed
+    stats_.overruns++;
+    uint64_t due = firstDeadlineAfter(now);
+    uint64_t behind = due - next_;
+    uint64_t keep = policy_ == OverrunPolicy::CatchUp ? std::min<uint64_t>(behind, maxCatchUpTicks_) : 0;
+    stats_.skippedTicks += behind - keep;
+    next_ = due - keep;
+}
+
+} // namespace mmorpg
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace mmorpg {
+
+// What to do when a tick finishes after the next deadline has passed
+enum class OverrunPolicy : uint8_t {
+    CatchUp,  // Run the missed ticks back to back (up to maxCatchUpTicks)
+    Skip      // Drop missed ticks and resume on the next future deadline
+};
+
+// Fixed-timestep deadlines for the game loop.
+// Deadline n is start + n / tickRate, computed from the start point each
+// time, so neither rounding nor time spent ticking accumulates as drift.
+// The caller waits until getDeadline(), then brackets the tick with
+// beginTick()/endTick().
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        uint64_t ticks = 0;
+        uint64_t overruns = 0;      // Ticks that ended past the next deadline
+        uint64_t skippedTicks = 0;  // Deadlines dropped by the overrun policy
+        Clock::duration lastDuration{};
+        Clock::duration maxDuration{};
+        Clock::duration totalDuration{};
+        Clock::duration lastLateness{};  // How long after its deadline a tick started
+        Clock::duration maxLateness{};
+
+        Clock::duration averageDuration() const {
+            return ticks ? totalDuration / static_cast<int64_t>(ticks) : Clock::duration{};
+        }
+    };
+
+    TickScheduler(uint32_t tickRate, OverrunPolicy policy = OverrunPolicy::CatchUp,
+                  uint32_t maxCatchUpTicks = 5);
+
+    // Anchor the schedule; the first deadline is one interval after now
+    void start(Clock::time_point now);
+
+    // Deadline of the next tick to run
+    Clock::time_point getDeadline() const { return deadline(next_); }
+
+    // Record the start of the tick due at getDeadline()
+    void beginTick(Clock::time_point now);
+
+    // Record the end of the tick and advance to the next deadline
+    void endTick(Clock::time_point now);
+
+    uint32_t getTickRate() const { return tickRate_; }
+    OverrunPolicy getPolicy() const { return policy_; }
+    Clock::duration getInterval() const { return deadline(1) - start_; }
+    const Stats& getStats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+
+private:
+    Clock::time_point deadline(uint64_t index) const;
+
+    // Index of the first deadline strictly after now
+    uint64_t firstDeadlineAfter(Clock::time_point now) const;
+
+    uint32_t tickRate_;
+    OverrunPolicy policy_;
+    uint32_t maxCatchUpTicks_;
+
+    Clock::time_point start_{};
+    uint64_t next_ = 1;
+    Clock::time_point tickStart_{};
+
+    Stats stats_;
+};
+
+} // namespace mmorpg
@@ -0,0 +1,89 @@
+#include "CompiledSkillEffects.hpp"
+#include "../core/TimingWheel.hpp"
+#include <algorithm>
+
+namespace mmorpg {
+
+namespace {
+
+// A periodic effect's applications over its duration (at least one)
+uint32_t applications(float duration, float interval) {
+    if (interval <= 0.0f || duration <= interval) return 1;
+    return static_cast<uint32_t>(duration / interval);
+}
+
+EffectOp compileEffect(const EffectRecord& record, float scale, uint32_t tickRate) {
+    EffectOp op;
+    op.flags = record.flags;
+    op.stat = static_cast<PrimaryStat>(record.stat);
+    int32_t amount = static_cast<int32_t>(record.amount * scale);
+
+    // Cases in SkillEffect alternative order
+    switch (record.kind) {
+        case 0:  // Damage
+            op.code = EffectOp::Code::Damage;
+            op.amount = amount;
+            op.scaling = record.scaling;
+            break;
+        case 1:  // Heal
+            op.code = EffectOp::Code::Heal;
+            op.amount = amount;
+            op.scaling = record.scaling;
+            break;
+        case 2:  // Buff
+        case 3:  // Debuff
+            op.code = EffectOp::Code::Modifier;
+            op.amount = record.kind == 2 ? amount : -amount;
+            op.scaling = (record.kind == 2 ? record.scaling : -record.scaling) * scale;
+            op.duration = TimingWheel::toTicks(record.duration, tickRate);
+            break;
+        case 4:  // DoT
+        case 5:  // HoT
+            op.code = EffectOp::Code::Periodic;
+            op.amount = record.kind == 5 ? amount : -amount;
+            op.duration = applications(record.duration, record.interval);
+            op.interval = std::max<uint32_t>(TimingWheel::toTicks(record.interval, tickRate), 1);
+            break;
+        case 6:  // Mana restore
+            op.code = EffectOp::Code::ManaRestore;
+            op.amount = amount;
+            op.scaling = record.scaling;
+            break;
+        default:  // Shield
+            op.code = EffectOp::Code::Shield;
+            op.amount = amount;
+            op.duration = TimingWheel::toTicks(record.duration, tickRate);
+            break;
+    }
+    return op;
+}
+
+} // namespace
+
+SkillEffectsPtr CompiledSkillEffects::compile(const SkillDatabase& db) {
+    std::shared_ptr<CompiledSkillEffects> compiled(new CompiledSkillEffects());
+    compiled->tickRate_ = db.getTickRate();
+
+    std::vector<SkillId> ids = db.getAllSkillIds();
+    compiled->skills_.resize(ids.empty() ? 0 : ids.back() + 1);
+    for (SkillId id : ids) {
+        const SkillRecord& record = *db.getRecord(id);
+        const EffectRecord* effects = db.getEffects(record);
+        Entry& entry = compiled->skills_[id];
+        entry.firstRun = static_cast<uint32_t>(compiled->runs_.size());
+        entry.levelCount = static_cast<uint32_t>(std::max(record.maxLevel, 1));
+        entry.targetType = record.targetType;
+        entry.range = record.range;
+
+        for (uint32_t level = 1; level <= entry.levelCount; level++) {
+            float scale = db.getLevelStats(id, static_cast<int32_t>(level))->effectScale;
+            compiled->runs_.push_back({static_cast<uint32_t>(compiled->ops_.size()), record.effectCount});
+            for (uint32_t i = 0; i < record.effectCount; i++) {
+                compiled->ops_.push_back(compileEffect(effects[i], scale, compiled->tickRate_));
+            }
+        }
+    }
+    return compiled;
+}
+
+} // namespace mmorpg
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "../core/Types.hpp"
+#include "../core/PrimaryStat.hpp"
+#include "SkillDatabase.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mmorpg {
+
+class CompiledSkillEffects;
+using SkillEffectsPtr = std::shared_ptr<const CompiledSkillEffects>;
+
+// One skill effect at one skill level, reduced to what applying it
+// needs: the level's effect scale is already multiplied in, debuffs and
+// DoTs are negative amounts, and durations are in game ticks.
+struct EffectOp {
+    enum class Code : uint8_t {
+        Damage,       // DamageCalculator with bonus amount + (scaling - 1) * attack
+        Heal,         // amount + scaling * caster's magical attack
+        Modifier,     // Buff/debuff: StatModifier{stat, amount, scaling} for duration
+        Periodic,     // DoT/HoT: amount HP every interval ticks, duration times
+        ManaRestore,  // amount + scaling * caster's wisdom
+        Shield        // Absorbs amount damage of the flagged kinds for duration
+    };
+
+    Code code = Code::Damage;
+    uint8_t flags = 0;  // EFFECT_* bits
+    PrimaryStat stat = PrimaryStat::Strength;
+    int32_t amount = 0;
+    float scaling = 0.0f;  // Stat scaling, or a modifier's percent
+    Tick duration = 0;     // Modifier/shield ticks (0 = until removed), periodic applications
+    uint32_t interval = 1;  // Periodic ticks between applications
+};
+
+// Immutable instruction table for every skill in a SkillDatabase, built
+// once at load and shared by whoever executes skills. Each (skill,
+// level) pair owns a run of EffectOps in definition order, so applying a
+// skill is a loop over a contiguous array with no variant dispatch or
+// lookups by name.
+class CompiledSkillEffects {
+public:
+    // Reads the database at its tick rate; recompile after reloading it
+    // or changing the rate
+    static SkillEffectsPtr compile(const SkillDatabase& db);
+
+    struct Ops {
+        const EffectOp* begin = nullptr;
+        const EffectOp* end = nullptr;
+
+        bool empty() const { return begin == end; }
+        size_t size() const { return static_cast<size_t>(end - begin); }
+    };
+
+    // A skill's ops at a level (clamped to its max level); empty for
+    // unknown skills or levels below 1
+    Ops getOps(SkillId id, int32_t level) const {
+        if (id >= skills_.size() || level < 1 || skills_[id].levelCount == 0) return {};
+        const Entry& entry = skills_[id];
+        const Run& run = runs_[entry.firstRun + std::min<uint32_t>(level, entry.levelCount) - 1];
+        return {ops_.data() + run.first, ops_.data() + run.first + run.count};
+    }
+
+    bool hasSkill(SkillId id) const { return id < skills_.size() && skills_[id].levelCount != 0; }
+    TargetType getTargetType(SkillId id) const { return static_cast<TargetType>(skills_[id].targetType); }
+    float getRange(SkillId id) const { return skills_[id].range; }
+
+    size_t getOpCount() const { return ops_.size(); }
+    uint32_t getTickRate() const { return tickRate_; }
+
+private:
+    struct Entry {
+        uint32_t firstRun = 0;    // levelCount runs, one per level
+        uint32_t levelCount = 0;  // 0 = no such skill
+        uint8_t targetType = 0;   // TargetType
+        float range = 0.0f;
+    };
+    struct Run {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    CompiledSkillEffects() = default;
+
+    std::vector<Entry> skills_;  // By skill id
+    std::vector<Run> runs_;
+    std::vector<EffectOp> ops_;
+    uint32_t tickRate_ = 0;
+};
+
+} // namespace mmorpg
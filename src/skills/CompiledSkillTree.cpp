@@ -0,0 +1,197 @@
+#include "CompiledSkillTree.hpp"
+#include "../core/Logger.hpp"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace mmorpg {
+
+SkillTreePtr CompiledSkillTree::compile(const SkillTree& tree) {
+    std::vector<SkillId> ids = tree.getAllSkillIds();
+    if (ids.size() > MAX_SKILLS) {
+        LOG_ERROR("Skill tree has " << ids.size() << " skills, more than " << MAX_SKILLS);
+        return nullptr;
+    }
+    std::sort(ids.begin(), ids.end());
+    if (!ids.empty() && ids.back() > SkillDatabase::MAX_SKILL_ID) {
+        LOG_ERROR("Skill tree has skill id " << ids.back() << ", more than " << SkillDatabase::MAX_SKILL_ID);
+        return nullptr;
+    }
+
+    // Positions in id order while the topological order is worked out
+    auto position = [&ids](SkillId id) -> size_t {
+        auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        return (it == ids.end() || *it != id) ? ids.size() : static_cast<size_t>(it - ids.begin());
+    };
+    const SkillDatabase& db = SkillDatabase::instance();
+    auto requiredSkill = [&db](SkillId id) -> SkillId {
+        const SkillRecord* record = db.getRecord(id);
+        return record && record->requirement.prerequisiteLevel > 0 ? record->requirement.prerequisiteSkill
+                                                                   : INVALID_SKILL_ID;
+    };
+
+    // Edges run from each prerequisite (tree or required skill) to the node
+    std::vector<std::vector<size_t>> edges(ids.size());
+    std::vector<size_t> incoming(ids.size(), 0);
+    for (size_t i = 0; i < ids.size(); i++) {
+        std::vector<SkillId> before = tree.getNode(ids[i])->prerequisites;
+        before.push_back(requiredSkill(ids[i]));
+        std::sort(before.begin(), before.end());
+        before.erase(std::unique(before.begin(), before.end()), before.end());
+        for (SkillId prerequisite : before) {
+            size_t from = position(prerequisite);
+            if (from < ids.size()) {
+                edges[from].push_back(i);
+                incoming[i]++;
+            }
+        }
+    }
+
+    // Kahn's algorithm, taking the lowest (tier, id) among ready nodes
+    using Ready = std::pair<int32_t, SkillId>;
+    std::priority_queue<Ready, std::vector<Ready>, std::greater<Ready>> ready;
+    for (size_t i = 0; i < ids.size(); i++) {
+        if (incoming[i] == 0) ready.push({tree.getNode(ids[i])->tier, ids[i]});
+    }
+    std::vector<SkillId> order;
+    order.reserve(ids.size());
+    while (!ready.empty()) {
+        SkillId id = ready.top().second;
+        ready.pop();
+        order.push_back(id);
+        for (size_t next : edges[position(id)]) {
+            if (--incoming[next] == 0) ready.push({tree.getNode(ids[next])->tier, ids[next]});
+        }
+    }
+    if (order.size() != ids.size()) {
+        LOG_ERROR("Skill tree prerequisites form a cycle");
+        return nullptr;
+    }
+
+    std::shared_ptr<CompiledSkillTree> compiled(new CompiledSkillTree());
+    compiled->indexById_.assign(ids.empty() ? 0 : ids.back() + 1, NO_INDEX);
+    for (size_t index = 0; index < order.size(); index++) {
+        compiled->indexById_[order[index]] = static_cast<SkillIndex>(index);
+    }
+    compiled->maxTier_ = tree.getMaxTier();
+
+    // Requirements as indices. Prerequisites outside the tree (or skills
+    // missing from the database) can never be learned here.
+    std::vector<std::vector<SkillIndex>> dependents(order.size());
+    compiled->nodes_.reserve(order.size());
+    for (size_t index = 0; index < order.size(); index++) {
+        SkillId id = order[index];
+        const SkillNode* source = tree.getNode(id);
+        Node node{id, source->tier, {}, 1, NO_INDEX, 0, false, 0, 0};
+
+        for (SkillId prerequisite : source->prerequisites) {
+            SkillIndex required = compiled->indexOf(prerequisite);
+            if (required == NO_INDEX) {
+                LOG_WARN("Skill " << id << " requires skill " << prerequisite << ", which is not in the tree");
+                node.blocked = true;
+            } else {
+                node.prerequisites.set(required);
+            }
+        }
+
+        if (const SkillRecord* record = db.getRecord(id)) {
+            node.requiredCharLevel = record->requirement.requiredCharLevel;
+            if (requiredSkill(id) != INVALID_SKILL_ID) {
+                node.requiredSkill = compiled->indexOf(requiredSkill(id));
+                node.requiredSkillLevel = record->requirement.prerequisiteLevel;
+                if (node.requiredSkill == NO_INDEX) {
+                    node.blocked = true;
+                } else {
+                    node.prerequisites.set(node.requiredSkill);
+                }
+            }
+        } else {
+            node.blocked = true;
+        }
+
+        node.prerequisites.forEach([&](SkillIndex prerequisite) {
+            dependents[prerequisite].push_back(static_cast<SkillIndex>(index));
+        });
+        compiled->nodes_.push_back(node);
+    }
+
+    for (size_t index = 0; index < order.size(); index++) {
+        Node& node = compiled->nodes_[index];
+        node.firstDependent = static_cast<uint32_t>(compiled->dependents_.size());
+        node.dependentCount = static_cast<uint32_t>(dependents[index].size());
+        compiled->dependents_.insert(compiled->dependents_.end(), dependents[index].begin(), dependents[index].end());
+        compiled->byCharLevel_.push_back(static_cast<SkillIndex>(index));
+    }
+    std::stable_sort(compiled->byCharLevel_.begin(), compiled->byCharLevel_.end(),
+                     [&](SkillIndex a, SkillIndex b) {
+                         return compiled->nodes_[a].requiredCharLevel < compiled->nodes_[b].requiredCharLevel;
+                     });
+    return compiled;
+}
+
+bool CompiledSkillTree::meetsRequirements(SkillIndex index, const SkillLevels& levels) const {
+    const Node& node = nodes_[index];
+    if (node.blocked || levels.characterLevel < node.requiredCharLevel) return false;
+    if (!levels.learned.containsAll(node.prerequisites)) return false;
+    return node.requiredSkill == NO_INDEX || levels.level[node.requiredSkill] >= node.requiredSkillLevel;
+}
+
+void CompiledSkillTree::recheck(SkillLevels& levels, SkillIndex index) const {
+    if (!levels.has(index) && meetsRequirements(index, levels)) {
+        levels.available.set(index);
+    } else {
+        levels.available.reset(index);
+    }
+}
+
+void CompiledSkillTree::recheckDependents(SkillLevels& levels, SkillIndex index) const {
+    const Node& node = nodes_[index];
+    for (uint32_t i = 0; i < node.dependentCount; i++) {
+        recheck(levels, dependents_[node.firstDependent + i]);
+    }
+}
+
+void CompiledSkillTree::refresh(SkillLevels& levels, int32_t characterLevel) const {
+    levels.characterLevel = characterLevel;
+    levels.available = SkillMask();
+    for (size_t index = 0; index < nodes_.size(); index++) {
+        recheck(levels, static_cast<SkillIndex>(index));
+    }
+}
+
+void CompiledSkillTree::learn(SkillLevels& levels, SkillIndex index) const {
+    levels.learned.set(index);
+    levels.available.reset(index);
+    levels.level[index] = 1;
+    recheckDependents(levels, index);
+}
+
+void CompiledSkillTree::upgrade(SkillLevels& levels, SkillIndex index) const {
+    levels.level[index]++;
+    recheckDependents(levels, index);
+}
+
+void CompiledSkillTree::setCharacterLevel(SkillLevels& levels, int32_t characterLevel) const {
+    int32_t low = std::min(levels.characterLevel, characterLevel);
+    int32_t high = std::max(levels.characterLevel, characterLevel);
+    levels.characterLevel = characterLevel;
+
+    // Only nodes whose level requirement lies in (low, high] can change
+    auto atMost = [this](int32_t level) {
+        return [this, level](SkillIndex index) { return nodes_[index].requiredCharLevel <= level; };
+    };
+    auto first = std::partition_point(byCharLevel_.begin(), byCharLevel_.end(), atMost(low));
+    auto last = std::partition_point(first, byCharLevel_.end(), atMost(high));
+    for (auto it = first; it != last; ++it) {
+        recheck(levels, *it);
+    }
+}
+
+std::vector<SkillId> CompiledSkillTree::getAvailableSkills(const SkillLevels& levels) const {
+    std::vector<SkillId> available;
+    levels.available.forEach([&](SkillIndex index) { available.push_back(nodes_[index].skillId); });
+    return available;
+}
+
+} // namespace mmorpg
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "../core/Types.hpp"
+#include "SkillDatabase.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mmorpg {
+
+class CompiledSkillTree;
+using SkillTreePtr = std::shared_ptr<const CompiledSkillTree>;
+
+// Immutable, index-based form of a SkillTree, built once and shared by
+// every character on it. Skills are numbered 0..size()-1 in topological
+// order (prerequisites first, then by tier and id) - a "skill index" -
+// and each node's requirements are resolved at compile time into a
+// prerequisite mask over indices, a character level and an optional
+// required skill level. A character's skill state (SkillLevels) is a
+// learned mask, an available mask and one level byte per index; the
+// available mask is kept current by learn(), upgrade() and
+// setCharacterLevel(), which recheck only the nodes the change can
+// affect, so availability queries are a bit test.
+class CompiledSkillTree {
+public:
+    using SkillIndex = uint16_t;
+    static constexpr size_t MAX_SKILLS = 256;
+    static constexpr SkillIndex NO_INDEX = UINT16_MAX;
+
+    // One bit per skill index
+    class SkillMask {
+    public:
+        void set(SkillIndex index) { words_[index >> 6] |= uint64_t{1} << (index & 63); }
+        void reset(SkillIndex index) { words_[index >> 6] &= ~(uint64_t{1} << (index & 63)); }
+        bool test(SkillIndex index) const { return (words_[index >> 6] >> (index & 63)) & 1; }
+
+        // (*this & other) == other
+        bool containsAll(const SkillMask& other) const {
+            uint64_t missing = 0;
+            for (size_t i = 0; i < WORDS; i++) missing |= other.words_[i] & ~words_[i];
+            return missing == 0;
+        }
+
+        // Call fn(index) for each set bit, in index order
+        template<typename Fn>
+        void forEach(Fn&& fn) const {
+            for (size_t i = 0; i < WORDS; i++) {
+                for (uint64_t bits = words_[i]; bits != 0; bits &= bits - 1) {
+                    fn(static_cast<SkillIndex>(i * 64 + __builtin_ctzll(bits)));
+                }
+            }
+        }
+
+    private:
+        static constexpr size_t WORDS = MAX_SKILLS / 64;
+        std::array<uint64_t, WORDS> words_{};
+    };
+
+    // nullptr (logged) if the tree has more than MAX_SKILLS nodes or a
+    // prerequisite cycle. Requirements are read from the SkillDatabase
+    // here; recompile after reloading it.
+    static SkillTreePtr compile(const SkillTree& tree);
+
+    size_t size() const { return nodes_.size(); }
+    SkillIndex indexOf(SkillId id) const {  // NO_INDEX if not in the tree
+        return id < indexById_.size() ? indexById_[id] : NO_INDEX;
+    }
+    SkillId skillId(SkillIndex index) const { return nodes_[index].skillId; }
+    int32_t tier(SkillIndex index) const { return nodes_[index].tier; }
+    int32_t getMaxTier() const { return maxTier_; }
+
+    // Per-character skill state over this tree's indices (level 0 = not learned)
+    struct SkillLevels {
+        SkillMask learned;
+        SkillMask available;         // Not learned, requirements met
+        int32_t characterLevel = 0;  // The level `available` reflects
+        std::array<uint8_t, MAX_SKILLS> level{};  // Max levels are at most SkillDatabase::MAX_SKILL_LEVEL
+
+        bool has(SkillIndex index) const { return learned.test(index); }
+    };
+
+    // Recompute levels.available from scratch at a character level
+    void refresh(SkillLevels& levels, int32_t characterLevel) const;
+
+    // Learn an available skill at level 1, or raise a learned one, and
+    // update what that makes available
+    void learn(SkillLevels& levels, SkillIndex index) const;
+    void upgrade(SkillLevels& levels, SkillIndex index) const;
+
+    // Update availability for a new character level
+    void setCharacterLevel(SkillLevels& levels, int32_t characterLevel) const;
+
+    // Available to learn now
+    bool canLearn(SkillIndex index, const SkillLevels& levels) const {
+        return index < nodes_.size() && levels.available.test(index);
+    }
+
+    // Skill ids in levels.available, in index order
+    std::vector<SkillId> getAvailableSkills(const SkillLevels& levels) const;
+
+private:
+    struct Node {
+        SkillId skillId;
+        int32_t tier;
+        SkillMask prerequisites;   // Tree prerequisites and the required skill
+        int32_t requiredCharLevel;
+        SkillIndex requiredSkill;  // NO_INDEX if none
+        int32_t requiredSkillLevel;
+        bool blocked;              // Needs a skill outside the tree or the database
+        uint32_t firstDependent;   // Run of dependents_: nodes requiring this one
+        uint32_t dependentCount;
+    };
+
+    CompiledSkillTree() = default;
+
+    bool meetsRequirements(SkillIndex index, const SkillLevels& levels) const;
+    void recheck(SkillLevels& levels, SkillIndex index) const;
+    void recheckDependents(SkillLevels& levels, SkillIndex index) const;
+
+    std::vector<Node> nodes_;              // By index
+    std::vector<SkillIndex> dependents_;
+    std::vector<SkillIndex> indexById_;    // NO_INDEX for ids not in the tree
+    std::vector<SkillIndex> byCharLevel_;  // Indices by required character level
+    int32_t maxTier_ = 0;
+};
+
+} // namespace mmorpg
@@ -22,14 +22,17 @@ float Skill::getScaledCooldown() const {
     return cooldown_ * std::max(0.5f, multiplier);
 }
 
+float Skill::getEffectScale() const {
+    // Effects grow with level
+    // Level 1: base values, Level 5: base * 2.0
+    return 1.0f + (level_ - 1) * 0.25f;
+}
+
 int32_t Skill::getScaledDamage() const {
     // Find first damage effect and scale it
     for (const auto& effect : effects_) {
         if (auto* dmg = std::get_if<DamageEffect>(&effect)) {
-            // Damage increases with level
-            // Level 1: base damage, Level 5: base * 2.0
-            float multiplier = 1.0f + (level_ - 1) * 0.25f;
-            return static_cast<int32_t>(dmg->baseDamage * multiplier);
+            return static_cast<int32_t>(dmg->baseDamage * getEffectScale());
         }
     }
     return 0;
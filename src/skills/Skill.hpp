@@ -63,6 +63,7 @@ public:
     int32_t getScaledManaCost() const;
     float getScaledCooldown() const;
     int32_t getScaledDamage() const;  // For first damage effect
+    float getEffectScale() const;     // Multiplier for effect magnitudes
 
     // Builder pattern for fluent construction
     Skill& withDescription(std::string desc) {
@@ -0,0 +1,117 @@
+#include "SkillData.hpp"
+#include "../core/Logger.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace mmorpg {
+
+EffectRecord toEffectRecord(const SkillEffect& effect) {
+    EffectRecord record;
+    record.kind = static_cast<uint8_t>(effect.index());
+    std::visit([&](auto&& e) {
+        using T = std::decay_t<decltype(e)>;
+        if constexpr (std::is_same_v<T, DamageEffect>) {
+            record.amount = e.baseDamage;
+            record.scaling = e.statScaling;
+            record.flags = e.isPhysical ? EFFECT_PHYSICAL : 0;
+        } else if constexpr (std::is_same_v<T, HealEffect>) {
+            record.amount = e.baseHeal;
+            record.scaling = e.statScaling;
+        } else if constexpr (std::is_same_v<T, BuffEffect>) {
+            record.stat = static_cast<uint8_t>(e.stat);
+            record.amount = e.flatBonus;
+            record.scaling = e.percentBonus;
+            record.duration = e.duration;
+        } else if constexpr (std::is_same_v<T, DebuffEffect>) {
+            record.stat = static_cast<uint8_t>(e.stat);
+            record.amount = e.flatPenalty;
+            record.scaling = e.percentPenalty;
+            record.duration = e.duration;
+        } else if constexpr (std::is_same_v<T, DotEffect>) {
+            record.amount = e.damagePerTick;
+            record.duration = e.duration;
+            record.interval = e.tickInterval;
+            record.flags = e.isPhysical ? EFFECT_PHYSICAL : 0;
+        } else if constexpr (std::is_same_v<T, HotEffect>) {
+            record.amount = e.healPerTick;
+            record.duration = e.duration;
+            record.interval = e.tickInterval;
+        } else if constexpr (std::is_same_v<T, ManaRestoreEffect>) {
+            record.amount = e.amount;
+            record.scaling = e.statScaling;
+        } else if constexpr (std::is_same_v<T, ShieldEffect>) {
+            record.amount = e.amount;
+            record.duration = e.duration;
+            record.flags = (e.absorbsPhysical ? EFFECT_ABSORBS_PHYSICAL : 0) |
+                           (e.absorbsMagical ? EFFECT_ABSORBS_MAGICAL : 0);
+        }
+    }, effect);
+    return record;
+}
+
+static_assert(std::variant_size_v<SkillEffect> == 8, "toSkillEffect() handles each kind");
+
+SkillEffect toSkillEffect(const EffectRecord& record) {
+    // Cases in SkillEffect alternative order
+    PrimaryStat stat = static_cast<PrimaryStat>(record.stat);
+    switch (record.kind) {
+        case 0: return DamageEffect{record.amount, record.scaling, (record.flags & EFFECT_PHYSICAL) != 0};
+        case 1: return HealEffect{record.amount, record.scaling};
+        case 2: return BuffEffect{stat, record.amount, record.scaling, record.duration};
+        case 3: return DebuffEffect{stat, record.amount, record.scaling, record.duration};
+        case 4: return DotEffect{record.amount, record.duration, record.interval, (record.flags & EFFECT_PHYSICAL) != 0};
+        case 5: return HotEffect{record.amount, record.duration, record.interval};
+        case 6: return ManaRestoreEffect{record.amount, record.scaling};
+        default: return ShieldEffect{record.amount, record.duration,
+                                     (record.flags & EFFECT_ABSORBS_PHYSICAL) != 0,
+                                     (record.flags & EFFECT_ABSORBS_MAGICAL) != 0};
+    }
+}
+
+// MappedFile implementation
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("Cannot open " << path << ": " << std::strerror(errno));
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        LOG_ERROR("Cannot map " << path << ": empty or unreadable");
+        ::close(fd);
+        return false;
+    }
+
+    void* data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file
+    if (data == MAP_FAILED) {
+        LOG_ERROR("Cannot map " << path << ": " << std::strerror(errno));
+        return false;
+    }
+
+    data_ = static_cast<const uint8_t*>(data);
+    size_ = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+} // namespace mmorpg
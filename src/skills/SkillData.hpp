@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../core/Types.hpp"
+#include "Skill.hpp"
+#include "SkillEffect.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace mmorpg {
+
+// Flat, pointer-free skill tables. SkillDatabase keeps its skills in
+// this form, and a compiled snapshot file is exactly these arrays
+// behind a header, so a snapshot is mapped and read in place.
+
+// A skill's numbers at one level, computed when the skill is loaded
+struct SkillLevelStats {
+    int32_t manaCost = 0;
+    float cooldown = 0.0f;   // Seconds
+    Tick cooldownTicks = 0;  // At the database's tick rate
+    int32_t damage = 0;      // First damage effect, scaled
+    float effectScale = 1.0f;  // Multiplier for effect magnitudes at this level
+};
+
+// One skill definition. Records are indexed by skill id; an unused id
+// has id == INVALID_SKILL_ID.
+struct SkillRecord {
+    SkillId id = INVALID_SKILL_ID;
+    uint8_t type = 0;        // SkillType
+    uint8_t targetType = 0;  // TargetType
+    uint16_t reserved = 0;
+    int32_t manaCost = 0;
+    float cooldown = 0.0f;   // Seconds
+    float range = 0.0f;
+    int32_t maxLevel = 0;
+    SkillRequirement requirement;
+    uint32_t name = 0;       // Offsets into the string pool
+    uint32_t nameLength = 0;
+    uint32_t description = 0;
+    uint32_t descriptionLength = 0;
+    uint32_t firstEffect = 0;  // effectCount rows of the effect table
+    uint32_t effectCount = 0;
+    uint32_t firstLevel = 0;   // maxLevel rows of the level table
+};
+
+// One SkillEffect with its fields in fixed slots
+struct EffectRecord {
+    uint8_t kind = 0;   // SkillEffect variant index
+    uint8_t stat = 0;   // Buff/Debuff: PrimaryStat
+    uint8_t flags = 0;  // EFFECT_* bits
+    uint8_t reserved = 0;
+    int32_t amount = 0;      // Base damage/heal, flat bonus/penalty, per-tick amount, mana, shield
+    float scaling = 0.0f;    // Stat scaling, or percent bonus/penalty
+    float duration = 0.0f;   // Seconds
+    float interval = 0.0f;   // DoT/HoT seconds between ticks
+};
+
+constexpr uint8_t EFFECT_PHYSICAL = 1;         // Damage/DoT
+constexpr uint8_t EFFECT_ABSORBS_PHYSICAL = 2;  // Shield
+constexpr uint8_t EFFECT_ABSORBS_MAGICAL = 4;   // Shield
+constexpr uint8_t EFFECT_KNOWN_FLAGS = EFFECT_PHYSICAL | EFFECT_ABSORBS_PHYSICAL | EFFECT_ABSORBS_MAGICAL;
+
+EffectRecord toEffectRecord(const SkillEffect& effect);
+SkillEffect toSkillEffect(const EffectRecord& record);
+
+// A skill tree node; prerequisites and unlocks are runs of the link table
+struct TreeNodeRecord {
+    SkillId skillId = INVALID_SKILL_ID;
+    int32_t tier = 0;
+    float uiX = 0.0f;
+    float uiY = 0.0f;
+    uint32_t firstPrerequisite = 0;
+    uint32_t prerequisiteCount = 0;
+    uint32_t firstUnlock = 0;
+    uint32_t unlockCount = 0;
+};
+
+// Snapshot file layout: this header, then each table at its offset
+// (8-byte aligned). Written and read on the same architecture; the
+// version changes whenever any record layout does.
+struct SkillSnapshotHeader {
+    static constexpr char MAGIC[8] = {'M', 'M', 'O', 'S', 'K', 'I', 'L', 'L'};
+    static constexpr uint32_t VERSION = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t tickRate;     // Of the levels' cooldownTicks
+    uint32_t recordCount;  // Highest skill id + 1
+    uint32_t effectCount;
+    uint32_t levelCount;
+    uint32_t nodeCount;
+    uint32_t linkCount;
+    uint32_t stringBytes;
+    uint64_t recordsOffset;
+    uint64_t effectsOffset;
+    uint64_t levelsOffset;
+    uint64_t nodesOffset;
+    uint64_t linksOffset;
+    uint64_t stringsOffset;
+    uint64_t fileSize;
+};
+
+static_assert(std::is_trivially_copyable<SkillLevelStats>::value, "mapped from snapshots");
+static_assert(std::is_trivially_copyable<SkillRecord>::value, "mapped from snapshots");
+static_assert(std::is_trivially_copyable<EffectRecord>::value, "mapped from snapshots");
+static_assert(std::is_trivially_copyable<TreeNodeRecord>::value, "mapped from snapshots");
+static_assert(std::is_trivially_copyable<SkillSnapshotHeader>::value, "mapped from snapshots");
+
+// Read-only memory map of a whole file (unmapped on destruction)
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);  // False (logged) on failure
+    void close();
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace mmorpg
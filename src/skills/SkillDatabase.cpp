@@ -0,0 +1,696 @@
+#include "SkillDatabase.hpp"
+#include "../core/Logger.hpp"
+#include "../core/TimingWheel.hpp"
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+
+namespace pt = boost::property_tree;
+
+namespace mmorpg {
+
+namespace {
+
+constexpr size_t SNAPSHOT_ALIGNMENT = 8;
+
+size_t alignUp(size_t offset) {
+    return (offset + SNAPSHOT_ALIGNMENT - 1) & ~(SNAPSHOT_ALIGNMENT - 1);
+}
+
+bool parseSkillType(const std::string& name, SkillType& type) {
+    if (name == "active") type = SkillType::Active;
+    else if (name == "passive") type = SkillType::Passive;
+    else if (name == "toggle") type = SkillType::Toggle;
+    else return false;
+    return true;
+}
+
+bool parseTargetType(const std::string& name, TargetType& target) {
+    if (name == "self") target = TargetType::Self;
+    else if (name == "single_enemy") target = TargetType::SingleEnemy;
+    else if (name == "single_ally") target = TargetType::SingleAlly;
+    else if (name == "area_enemy") target = TargetType::AreaEnemy;
+    else if (name == "area_ally") target = TargetType::AreaAlly;
+    else if (name == "area_all") target = TargetType::AreaAll;
+    else return false;
+    return true;
+}
+
+bool parseStat(const pt::ptree& node, PrimaryStat& stat) {
+    return parsePrimaryStat(node.get<std::string>("stat", primaryStatName(stat)), stat);
+}
+
+// Field names follow the effect structs; missing fields keep their defaults
+bool parseEffect(const pt::ptree& node, SkillEffect& effect) {
+    std::string type = node.get<std::string>("type", "");
+    if (type == "damage") {
+        DamageEffect e;
+        e.baseDamage = node.get("base_damage", e.baseDamage);
+        e.statScaling = node.get("stat_scaling", e.statScaling);
+        e.isPhysical = node.get("physical", e.isPhysical);
+        effect = e;
+    } else if (type == "heal") {
+        HealEffect e;
+        e.baseHeal = node.get("base_heal", e.baseHeal);
+        e.statScaling = node.get("stat_scaling", e.statScaling);
+        effect = e;
+    } else if (type == "buff") {
+        BuffEffect e;
+        if (!parseStat(node, e.stat)) return false;
+        e.flatBonus = node.get("flat_bonus", e.flatBonus);
+        e.percentBonus = node.get("percent_bonus", e.percentBonus);
+        e.duration = node.get("duration", e.duration);
+        effect = e;
+    } else if (type == "debuff") {
+        DebuffEffect e;
+        if (!parseStat(node, e.stat)) return false;
+        e.flatPenalty = node.get("flat_penalty", e.flatPenalty);
+        e.percentPenalty = node.get("percent_penalty", e.percentPenalty);
+        e.duration = node.get("duration", e.duration);
+        effect = e;
+    } else if (type == "dot") {
+        DotEffect e;
+        e.damagePerTick = node.get("damage_per_tick", e.damagePerTick);
+        e.duration = node.get("duration", e.duration);
+        e.tickInterval = node.get("tick_interval", e.tickInterval);
+        e.isPhysical = node.get("physical", e.isPhysical);
+        effect = e;
+    } else if (type == "hot") {
+        HotEffect e;
+        e.healPerTick = node.get("heal_per_tick", e.healPerTick);
+        e.duration = node.get("duration", e.duration);
+        e.tickInterval = node.get("tick_interval", e.tickInterval);
+        effect = e;
+    } else if (type == "mana_restore") {
+        ManaRestoreEffect e;
+        e.amount = node.get("amount", e.amount);
+        e.statScaling = node.get("stat_scaling", e.statScaling);
+        effect = e;
+    } else if (type == "shield") {
+        ShieldEffect e;
+        e.amount = node.get("amount", e.amount);
+        e.duration = node.get("duration", e.duration);
+        e.absorbsPhysical = node.get("absorbs_physical", e.absorbsPhysical);
+        e.absorbsMagical = node.get("absorbs_magical", e.absorbsMagical);
+        effect = e;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::vector<SkillId> parseIds(const pt::ptree& node, const char* key) {
+    std::vector<SkillId> ids;
+    if (auto list = node.get_child_optional(key)) {
+        for (const auto& [_, item] : *list) {
+            ids.push_back(item.get_value<SkillId>());
+        }
+    }
+    return ids;
+}
+
+template<typename T>
+bool inBounds(uint64_t offset, uint32_t count, size_t fileSize) {
+    return offset % SNAPSHOT_ALIGNMENT == 0 && offset <= fileSize &&
+           static_cast<uint64_t>(count) * sizeof(T) <= fileSize - offset;
+}
+
+} // namespace
+
+SkillDatabase& SkillDatabase::instance() {
+    static SkillDatabase db;
+    return db;
+}
+
+void SkillDatabase::registerSkill(Skill skill) {
+    SkillId id = skill.getId();
+    if (id == INVALID_SKILL_ID || id > MAX_SKILL_ID) {
+        LOG_ERROR("Skill id " << id << " is outside 1.." << MAX_SKILL_ID);
+        return;
+    }
+    if (skill.getMaxLevel() < 1 || skill.getMaxLevel() > MAX_SKILL_LEVEL) {
+        LOG_ERROR("Skill " << id << " max level " << skill.getMaxLevel() << " is outside 1.." << MAX_SKILL_LEVEL);
+        return;
+    }
+    if (getRecord(id)) return;
+
+    detach();
+
+    SkillRecord record;
+    record.id = id;
+    record.type = static_cast<uint8_t>(skill.getType());
+    record.targetType = static_cast<uint8_t>(skill.getTargetType());
+    record.manaCost = skill.getManaCost();
+    record.cooldown = skill.getCooldown();
+    record.range = skill.getRange();
+    record.maxLevel = skill.getMaxLevel();
+    record.requirement = skill.getRequirement();
+    record.name = addString(skill.getName());
+    record.nameLength = static_cast<uint32_t>(skill.getName().size());
+    record.description = addString(skill.getDescription());
+    record.descriptionLength = static_cast<uint32_t>(skill.getDescription().size());
+
+    record.firstEffect = static_cast<uint32_t>(owned_.effects.size());
+    record.effectCount = static_cast<uint32_t>(skill.getEffects().size());
+    for (const SkillEffect& effect : skill.getEffects()) {
+        owned_.effects.push_back(toEffectRecord(effect));
+    }
+
+    // The Skill scaling formulas, run once per level here
+    record.firstLevel = static_cast<uint32_t>(owned_.levels.size());
+    int32_t levels = levelCount(record);
+    for (int32_t level = 1; level <= levels; level++) {
+        skill.setLevel(level);
+        SkillLevelStats stats;
+        stats.manaCost = skill.getScaledManaCost();
+        stats.cooldown = skill.getScaledCooldown();
+        stats.cooldownTicks = TimingWheel::toTicks(stats.cooldown, tickRate_);
+        stats.damage = skill.getScaledDamage();
+        stats.effectScale = skill.getEffectScale();
+        owned_.levels.push_back(stats);
+    }
+
+    if (id >= owned_.records.size()) {
+        owned_.records.resize(id + 1);
+    }
+    owned_.records[id] = record;
+    skillCount_++;
+    viewOwned();
+}
+
+void SkillDatabase::addTreeNode(const SkillNode& node) {
+    detach();
+
+    TreeNodeRecord record;
+    record.skillId = node.skillId;
+    record.tier = node.tier;
+    record.uiX = node.uiX;
+    record.uiY = node.uiY;
+    record.firstPrerequisite = static_cast<uint32_t>(owned_.links.size());
+    record.prerequisiteCount = static_cast<uint32_t>(node.prerequisites.size());
+    owned_.links.insert(owned_.links.end(), node.prerequisites.begin(), node.prerequisites.end());
+    record.firstUnlock = static_cast<uint32_t>(owned_.links.size());
+    record.unlockCount = static_cast<uint32_t>(node.unlocks.size());
+    owned_.links.insert(owned_.links.end(), node.unlocks.begin(), node.unlocks.end());
+
+    owned_.nodes.push_back(record);
+    viewOwned();
+}
+
+std::string_view SkillDatabase::getName(SkillId id) const {
+    const SkillRecord* record = getRecord(id);
+    return record ? string(record->name, record->nameLength) : std::string_view();
+}
+
+std::string_view SkillDatabase::getDescription(SkillId id) const {
+    const SkillRecord* record = getRecord(id);
+    return record ? string(record->description, record->descriptionLength) : std::string_view();
+}
+
+void SkillDatabase::setTickRate(uint32_t tickRate) {
+    tickRate = tickRate > 0 ? tickRate : 1;
+    if (tickRate == tickRate_) return;
+    tickRate_ = tickRate;
+    recomputeTicks();
+}
+
+void SkillDatabase::recomputeTicks() {
+    if (view_.levelCount == 0) return;
+    detach();
+    for (SkillLevelStats& stats : owned_.levels) {
+        stats.cooldownTicks = TimingWheel::toTicks(stats.cooldown, tickRate_);
+    }
+}
+
+const Skill* SkillDatabase::getSkill(SkillId id) const {
+    const SkillRecord* record = getRecord(id);
+    if (!record) return nullptr;
+
+    std::lock_guard<std::mutex> lock(skillsMutex_);
+    if (id >= skills_.size()) {
+        skills_.resize(id + 1);
+    }
+    if (!skills_[id]) {
+        auto skill = std::make_unique<Skill>(id, std::string(getName(id)));
+        skill->withDescription(std::string(getDescription(id)))
+            .withType(static_cast<SkillType>(record->type))
+            .withTargetType(static_cast<TargetType>(record->targetType))
+            .withManaCost(record->manaCost)
+            .withCooldown(record->cooldown)
+            .withRange(record->range)
+            .withMaxLevel(record->maxLevel)
+            .withRequirement(record->requirement);
+        const EffectRecord* effects = getEffects(*record);
+        for (uint32_t i = 0; i < record->effectCount; i++) {
+            skill->addEffect(toSkillEffect(effects[i]));
+        }
+        skills_[id] = std::move(skill);
+    }
+    return skills_[id].get();
+}
+
+Skill SkillDatabase::getSkillCopy(SkillId id) const {
+    const Skill* skill = getSkill(id);
+    if (!skill) {
+        return Skill(INVALID_SKILL_ID, "Invalid");
+    }
+    return *skill;
+}
+
+std::vector<SkillId> SkillDatabase::getAllSkillIds() const {
+    std::vector<SkillId> result;
+    result.reserve(skillCount_);
+    for (uint32_t id = 0; id < view_.recordCount; id++) {
+        if (view_.records[id].id != INVALID_SKILL_ID) {
+            result.push_back(id);
+        }
+    }
+    return result;
+}
+
+SkillTree SkillDatabase::buildTree() const {
+    SkillTree tree;
+    for (uint32_t i = 0; i < view_.nodeCount; i++) {
+        const TreeNodeRecord& record = view_.nodes[i];
+        SkillNode node;
+        node.skillId = record.skillId;
+        node.tier = record.tier;
+        node.uiX = record.uiX;
+        node.uiY = record.uiY;
+        const SkillId* prerequisites = view_.links + record.firstPrerequisite;
+        node.prerequisites.assign(prerequisites, prerequisites + record.prerequisiteCount);
+        const SkillId* unlocks = view_.links + record.firstUnlock;
+        node.unlocks.assign(unlocks, unlocks + record.unlockCount);
+        tree.addNode(std::move(node));
+    }
+    return tree;
+}
+
+bool SkillDatabase::loadDefinitions(const std::string& path) {
+    std::vector<Skill> skills;
+    std::vector<SkillNode> nodes;
+
+    try {
+        pt::ptree root;
+        pt::read_json(path, root);
+
+        std::unordered_set<SkillId> ids;
+        for (const auto& [_, node] : root.get_child("skills")) {
+            SkillId id = node.get<SkillId>("id");
+            if (id == INVALID_SKILL_ID || id > MAX_SKILL_ID || !ids.insert(id).second) {
+                LOG_ERROR(path << ": skill id " << id << " is invalid or repeated");
+                return false;
+            }
+
+            Skill skill(id, node.get<std::string>("name"));
+            skill.withDescription(node.get<std::string>("description", ""));
+
+            SkillType type = SkillType::Active;
+            TargetType target = TargetType::SingleEnemy;
+            if (!parseSkillType(node.get<std::string>("type", "active"), type) ||
+                !parseTargetType(node.get<std::string>("target", "single_enemy"), target)) {
+                LOG_ERROR(path << ": skill " << id << " has an unknown type or target");
+                return false;
+            }
+            skill.withType(type)
+                .withTargetType(target)
+                .withManaCost(node.get("mana_cost", skill.getManaCost()))
+                .withCooldown(node.get("cooldown", skill.getCooldown()))
+                .withRange(node.get("range", skill.getRange()))
+                .withMaxLevel(node.get("max_level", skill.getMaxLevel()));
+            if (skill.getMaxLevel() < 1 || skill.getMaxLevel() > MAX_SKILL_LEVEL) {
+                LOG_ERROR(path << ": skill " << id << " max_level is outside 1.." << MAX_SKILL_LEVEL);
+                return false;
+            }
+
+            if (auto required = node.get_child_optional("requires")) {
+                SkillRequirement requirement;
+                requirement.prerequisiteSkill = required->get("skill", requirement.prerequisiteSkill);
+                requirement.prerequisiteLevel = required->get("level", requirement.prerequisiteLevel);
+                requirement.requiredCharLevel = required->get("char_level", requirement.requiredCharLevel);
+                skill.withRequirement(requirement);
+            }
+
+            if (auto effects = node.get_child_optional("effects")) {
+                for (const auto& [__, item] : *effects) {
+                    SkillEffect effect;
+                    if (!parseEffect(item, effect)) {
+                        LOG_ERROR(path << ": skill " << id << " has an invalid effect");
+                        return false;
+                    }
+                    skill.withEffect(effect);
+                }
+            }
+            skills.push_back(std::move(skill));
+        }
+
+        if (auto tree = root.get_child_optional("tree")) {
+            for (const auto& [_, item] : *tree) {
+                SkillNode node;
+                node.skillId = item.get<SkillId>("skill");
+                node.tier = item.get<int32_t>("tier", 1);
+                node.prerequisites = parseIds(item, "prerequisites");
+                node.unlocks = parseIds(item, "unlocks");
+                node.uiX = item.get("x", node.uiX);
+                node.uiY = item.get("y", node.uiY);
+                if (!ids.count(node.skillId)) {
+                    LOG_ERROR(path << ": tree node for undefined skill " << node.skillId);
+                    return false;
+                }
+                nodes.push_back(std::move(node));
+            }
+        }
+    } catch (const pt::ptree_error& e) {
+        LOG_ERROR("Failed to load skills from " << path << ": " << e.what());
+        return false;
+    }
+
+    clear();
+    for (Skill& skill : skills) {
+        registerSkill(std::move(skill));
+    }
+    for (const SkillNode& node : nodes) {
+        addTreeNode(node);
+    }
+    LOG_INFO("Loaded " << skillCount_ << " skills and " << nodes.size() << " tree nodes from " << path);
+    return true;
+}
+
+bool SkillDatabase::saveSnapshot(const std::string& path) const {
+    SkillSnapshotHeader header{};
+    std::memcpy(header.magic, SkillSnapshotHeader::MAGIC, sizeof(header.magic));
+    header.version = SkillSnapshotHeader::VERSION;
+    header.tickRate = tickRate_;
+    header.recordCount = view_.recordCount;
+    header.effectCount = view_.effectCount;
+    header.levelCount = view_.levelCount;
+    header.nodeCount = view_.nodeCount;
+    header.linkCount = view_.linkCount;
+    header.stringBytes = view_.stringBytes;
+
+    size_t offset = sizeof(header);
+    auto place = [&offset](uint64_t& at, size_t bytes) {
+        at = alignUp(offset);
+        offset = at + bytes;
+    };
+    place(header.recordsOffset, view_.recordCount * sizeof(SkillRecord));
+    place(header.effectsOffset, view_.effectCount * sizeof(EffectRecord));
+    place(header.levelsOffset, view_.levelCount * sizeof(SkillLevelStats));
+    place(header.nodesOffset, view_.nodeCount * sizeof(TreeNodeRecord));
+    place(header.linksOffset, view_.linkCount * sizeof(SkillId));
+    place(header.stringsOffset, view_.stringBytes);
+    header.fileSize = offset;
+
+    std::vector<char> image(offset, 0);
+    std::memcpy(image.data(), &header, sizeof(header));
+    auto copy = [&image](uint64_t at, const void* data, size_t bytes) {
+        if (bytes > 0) std::memcpy(image.data() + at, data, bytes);
+    };
+    copy(header.recordsOffset, view_.records, view_.recordCount * sizeof(SkillRecord));
+    copy(header.effectsOffset, view_.effects, view_.effectCount * sizeof(EffectRecord));
+    copy(header.levelsOffset, view_.levels, view_.levelCount * sizeof(SkillLevelStats));
+    copy(header.nodesOffset, view_.nodes, view_.nodeCount * sizeof(TreeNodeRecord));
+    copy(header.linksOffset, view_.links, view_.linkCount * sizeof(SkillId));
+    copy(header.stringsOffset, view_.strings, view_.stringBytes);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(image.data(), static_cast<std::streamsize>(image.size()));
+    if (!out) {
+        LOG_ERROR("Failed to write skill snapshot " << path);
+        return false;
+    }
+    return true;
+}
+
+bool SkillDatabase::loadSnapshot(const std::string& path) {
+    auto map = std::make_unique<MappedFile>();
+    if (!map->open(path)) return false;
+
+    const uint8_t* data = map->data();
+    size_t size = map->size();
+    SkillSnapshotHeader header;
+    if (size < sizeof(header)) {
+        LOG_ERROR(path << " is not a skill snapshot (too short)");
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, SkillSnapshotHeader::MAGIC, sizeof(header.magic)) != 0) {
+        LOG_ERROR(path << " is not a skill snapshot");
+        return false;
+    }
+    if (header.version != SkillSnapshotHeader::VERSION) {
+        LOG_ERROR(path << " is skill snapshot version " << header.version
+                  << ", expected " << SkillSnapshotHeader::VERSION << " (recompile it with skillc)");
+        return false;
+    }
+    if (header.fileSize != size ||
+        !inBounds<SkillRecord>(header.recordsOffset, header.recordCount, size) ||
+        !inBounds<EffectRecord>(header.effectsOffset, header.effectCount, size) ||
+        !inBounds<SkillLevelStats>(header.levelsOffset, header.levelCount, size) ||
+        !inBounds<TreeNodeRecord>(header.nodesOffset, header.nodeCount, size) ||
+        !inBounds<SkillId>(header.linksOffset, header.linkCount, size) ||
+        !inBounds<char>(header.stringsOffset, header.stringBytes, size)) {
+        LOG_ERROR(path << " is truncated or corrupt");
+        return false;
+    }
+
+    View view;
+    view.records = reinterpret_cast<const SkillRecord*>(data + header.recordsOffset);
+    view.recordCount = header.recordCount;
+    view.effects = reinterpret_cast<const EffectRecord*>(data + header.effectsOffset);
+    view.effectCount = header.effectCount;
+    view.levels = reinterpret_cast<const SkillLevelStats*>(data + header.levelsOffset);
+    view.levelCount = header.levelCount;
+    view.nodes = reinterpret_cast<const TreeNodeRecord*>(data + header.nodesOffset);
+    view.nodeCount = header.nodeCount;
+    view.links = reinterpret_cast<const SkillId*>(data + header.linksOffset);
+    view.linkCount = header.linkCount;
+    view.strings = reinterpret_cast<const char*>(data + header.stringsOffset);
+    view.stringBytes = header.stringBytes;
+
+    // Every range a lookup follows must stay inside its table
+    size_t skills = 0;
+    for (uint32_t id = 0; id < view.recordCount; id++) {
+        const SkillRecord& record = view.records[id];
+        if (record.id == INVALID_SKILL_ID) continue;
+        bool valid = record.id == id &&
+                     record.type <= static_cast<uint8_t>(SkillType::Toggle) &&
+                     record.targetType <= static_cast<uint8_t>(TargetType::AreaAll) &&
+                     record.maxLevel >= 1 && record.maxLevel <= MAX_SKILL_LEVEL &&
+                     uint64_t{record.firstEffect} + record.effectCount <= view.effectCount &&
+                     uint64_t{record.firstLevel} + levelCount(record) <= view.levelCount &&
+                     uint64_t{record.name} + record.nameLength <= view.stringBytes &&
+                     uint64_t{record.description} + record.descriptionLength <= view.stringBytes;
+        for (uint32_t i = 0; valid && i < record.effectCount; i++) {
+            const EffectRecord& effect = view.effects[record.firstEffect + i];
+            valid = effect.kind < std::variant_size_v<SkillEffect> &&
+                    effect.stat < PRIMARY_STAT_COUNT &&
+                    (effect.flags & ~EFFECT_KNOWN_FLAGS) == 0;
+        }
+        if (!valid) {
+            LOG_ERROR(path << " is corrupt (skill " << id << ")");
+            return false;
+        }
+        skills++;
+    }
+    for (uint32_t i = 0; i < view.nodeCount; i++) {
+        const TreeNodeRecord& node = view.nodes[i];
+        if (uint64_t{node.firstPrerequisite} + node.prerequisiteCount > view.linkCount ||
+            uint64_t{node.firstUnlock} + node.unlockCount > view.linkCount) {
+            LOG_ERROR(path << " is corrupt (tree node " << i << ")");
+            return false;
+        }
+    }
+
+    owned_ = Tables();
+    map_ = std::move(map);
+    view_ = view;
+    skillCount_ = skills;
+    resetSkills();
+    if (header.tickRate != tickRate_) {
+        recomputeTicks();
+    }
+    LOG_INFO("Mapped " << skillCount_ << " skills and " << view_.nodeCount << " tree nodes from " << path);
+    return true;
+}
+
+void SkillDatabase::detach() {
+    if (!map_) return;
+
+    owned_.records.assign(view_.records, view_.records + view_.recordCount);
+    owned_.effects.assign(view_.effects, view_.effects + view_.effectCount);
+    owned_.levels.assign(view_.levels, view_.levels + view_.levelCount);
+    owned_.nodes.assign(view_.nodes, view_.nodes + view_.nodeCount);
+    owned_.links.assign(view_.links, view_.links + view_.linkCount);
+    owned_.strings.assign(view_.strings, view_.stringBytes);
+    map_.reset();
+    viewOwned();
+}
+
+void SkillDatabase::viewOwned() {
+    view_.records = owned_.records.data();
+    view_.recordCount = static_cast<uint32_t>(owned_.records.size());
+    view_.effects = owned_.effects.data();
+    view_.effectCount = static_cast<uint32_t>(owned_.effects.size());
+    view_.levels = owned_.levels.data();
+    view_.levelCount = static_cast<uint32_t>(owned_.levels.size());
+    view_.nodes = owned_.nodes.data();
+    view_.nodeCount = static_cast<uint32_t>(owned_.nodes.size());
+    view_.links = owned_.links.data();
+    view_.linkCount = static_cast<uint32_t>(owned_.links.size());
+    view_.strings = owned_.strings.data();
+    view_.stringBytes = static_cast<uint32_t>(owned_.strings.size());
+}
+
+void SkillDatabase::resetSkills() {
+    std::lock_guard<std::mutex> lock(skillsMutex_);
+    skills_.clear();
+}
+
+uint32_t SkillDatabase::addString(const std::string& text) {
+    uint32_t offset = static_cast<uint32_t>(owned_.strings.size());
+    owned_.strings += text;
+    return offset;
+}
+
+void SkillDatabase::clear() {
+    owned_ = Tables();
+    map_.reset();
+    viewOwned();
+    skillCount_ = 0;
+    resetSkills();
+}
+
+void SkillDatabase::loadDefaultSkills() {
+    clear();
+
+    // Tier 1 - Basic Skills
+    registerSkill(
+        Skill(1, "Slash")
+            .withDescription("A basic sword attack")
+            .withType(SkillType::Active)
+            .withTargetType(TargetType::SingleEnemy)
+            .withManaCost(10)
+            .withCooldown(2.0f)
+            .withMaxLevel(5)
+            .withEffect(DamageEffect{30, 1.0f, true})
+    );
+
+    registerSkill(
+        Skill(2, "Fireball")
+            .withDescription("Launches a ball of fire at the enemy")
+            .withType(SkillType::Active)
+            .withTargetType(TargetType::SingleEnemy)
+            .withManaCost(25)
+            .withCooldown(3.0f)
+            .withRange(10.0f)
+            .withMaxLevel(5)
+            .withEffect(DamageEffect{50, 1.2f, false})
+    );
+
+    registerSkill(
+        Skill(3, "Heal")
+            .withDescription("Restores HP to self or ally")
+            .withType(SkillType::Active)
+            .withTargetType(TargetType::SingleAlly)
+            .withManaCost(30)
+            .withCooldown(5.0f)
+            .withMaxLevel(5)
+            .withEffect(HealEffect{60, 0.8f})
+    );
+
+    // Tier 2 - Advanced Skills (require tier 1)
+    registerSkill(
+        Skill(4, "Power Strike")
+            .withDescription("A powerful charged attack")
+            .withType(SkillType::Active)
+            .withTargetType(TargetType::SingleEnemy)
+            .withManaCost(25)
+            .withCooldown(5.0f)
+            .withMaxLevel(5)
+            .withRequirement({1, 2, 5})  // Requires Slash level 2, char level 5
+            .withEffect(DamageEffect{80, 1.5f, true})
+    );
+
+    registerSkill(
+        Skill(5, "Flame Wave")
+            .withDescription("Sends a wave of fire in front of you")
+            .withType(SkillType::Active)
+            .withTargetType(TargetType::AreaEnemy)
+            .withManaCost(40)
+            .withCooldown(6.0f)
+            .withRange(8.0f)
+            .withMaxLevel(5)
+            .withRequirement({2, 2, 5})  // Requires Fireball level 2
+            .withEffect(DamageEffect{40, 1.0f, false})
+    );
+
+    registerSkill(
+        Skill(6, "Regeneration")
+            .withDescription("Heals over time")
+            .withType(SkillType::Active)
+            .withTargetType(TargetType::SingleAlly)
+            .withManaCost(35)
+            .withCooldown(10.0f)
+            .withMaxLevel(5)
+            .withRequirement({3, 2, 5})
+            .withEffect(HotEffect{20, 10.0f, 1.0f})
+    );
+
+    // Tier 3 - Ultimate Skills
+    registerSkill(
+        Skill(7, "Berserk")
+            .withDescription("Greatly increases attack power")
+            .withType(SkillType::Active)
+            .withTargetType(TargetType::Self)
+            .withManaCost(50)
+            .withCooldown(30.0f)
+            .withMaxLevel(3)
+            .withRequirement({4, 3, 10})
+            .withEffect(BuffEffect{PrimaryStat::Strength, 20, 0.5f, 15.0f})
+    );
+
+    registerSkill(
+        Skill(8, "Meteor")
+            .withDescription("Calls down a devastating meteor")
+            .withType(SkillType::Active)
+            .withTargetType(TargetType::AreaEnemy)
+            .withManaCost(100)
+            .withCooldown(60.0f)
+            .withRange(15.0f)
+            .withMaxLevel(3)
+            .withRequirement({5, 3, 10})
+            .withEffect(DamageEffect{200, 2.0f, false})
+    );
+
+    registerSkill(
+        Skill(9, "Divine Shield")
+            .withDescription("Creates a shield absorbing damage")
+            .withType(SkillType::Active)
+            .withTargetType(TargetType::Self)
+            .withManaCost(60)
+            .withCooldown(45.0f)
+            .withMaxLevel(3)
+            .withRequirement({6, 3, 10})
+            .withEffect(ShieldEffect{200, 10.0f, true, true})
+    );
+
+    // Tier 1 skills (no prerequisites)
+    addTreeNode({1, {}, {4}, 1, 0.0f, 0.0f});      // Slash -> Power Strike
+    addTreeNode({2, {}, {5}, 1, 1.0f, 0.0f});      // Fireball -> Flame Wave
+    addTreeNode({3, {}, {6}, 1, 2.0f, 0.0f});      // Heal -> Regeneration
+
+    // Tier 2 skills
+    addTreeNode({4, {1}, {7}, 2, 0.0f, 1.0f});     // Power Strike -> Berserk
+    addTreeNode({5, {2}, {8}, 2, 1.0f, 1.0f});     // Flame Wave -> Meteor
+    addTreeNode({6, {3}, {9}, 2, 2.0f, 1.0f});     // Regeneration -> Divine Shield
+
+    // Tier 3 skills
+    addTreeNode({7, {4}, {}, 3, 0.0f, 2.0f});      // Berserk
+    addTreeNode({8, {5}, {}, 3, 1.0f, 2.0f});      // Meteor
+    addTreeNode({9, {6}, {}, 3, 2.0f, 2.0f});      // Divine Shield
+}
+
+} // namespace mmorpg
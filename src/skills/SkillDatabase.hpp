@@ -0,0 +1,151 @@
+#pragma once
+
+#include "../core/Types.hpp"
+#include "Skill.hpp"
+#include "SkillData.hpp"
+#include "SkillTree.hpp"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mmorpg {
+
+// Singleton database of skill definitions and the skill tree.
+// Skills live in flat tables (SkillData.hpp): a record per skill id, and
+// effect and per-level rows found through each record, so lookups are an
+// index and a bounds check. Definitions come from a JSON data file
+// (loadDefinitions), the built-in set (loadDefaultSkills), or a binary
+// snapshot written by saveSnapshot (see tools/skillc), which is mapped
+// and used in place with no parsing or per-skill allocation.
+// CompiledSkillTree and CompiledSkillEffects copy what they need when
+// compiled and do not follow later loads.
+//
+// Pointers and views returned here stay valid until the next change
+// (register, load or clear). Changing a mapped database (registerSkill,
+// a tick rate other than the snapshot's) first copies the tables into
+// owned storage.
+class SkillDatabase {
+public:
+    static constexpr SkillId MAX_SKILL_ID = 65535;  // Tables are indexed by id
+    static constexpr int32_t MAX_SKILL_LEVEL = 255;  // Learned levels are stored in a byte
+
+    static SkillDatabase& instance();
+
+    // Register a skill definition (ignored if the id is taken)
+    void registerSkill(Skill skill);
+
+    // Add a node to the skill tree definition
+    void addTreeNode(const SkillNode& node);
+
+    // Record for a skill id; nullptr if there is none
+    const SkillRecord* getRecord(SkillId id) const {
+        if (id >= view_.recordCount || view_.records[id].id == INVALID_SKILL_ID) return nullptr;
+        return &view_.records[id];
+    }
+
+    // Empty for unknown skills
+    std::string_view getName(SkillId id) const;
+    std::string_view getDescription(SkillId id) const;
+
+    // record.effectCount rows in definition order
+    const EffectRecord* getEffects(const SkillRecord& record) const { return view_.effects + record.firstEffect; }
+
+    // Precomputed values at a level (clamped to the max level);
+    // nullptr for unknown skills or levels below 1
+    const SkillLevelStats* getLevelStats(SkillId id, int32_t level) const {
+        const SkillRecord* record = getRecord(id);
+        if (!record || level < 1) return nullptr;
+        return &view_.levels[record->firstLevel + std::min(level, levelCount(*record)) - 1];
+    }
+
+    // Game ticks per second for cooldownTicks (recomputes the table)
+    void setTickRate(uint32_t tickRate);
+    uint32_t getTickRate() const { return tickRate_; }
+
+    // Full Skill object, built from the tables on first use
+    const Skill* getSkill(SkillId id) const;
+
+    // Get skill copy for modification (e.g., leveling up)
+    Skill getSkillCopy(SkillId id) const;
+
+    // Check if skill exists
+    bool hasSkill(SkillId id) const { return getRecord(id) != nullptr; }
+
+    // Get all skill IDs (ascending)
+    std::vector<SkillId> getAllSkillIds() const;
+    size_t getSkillCount() const { return skillCount_; }
+
+    // The skill tree definition
+    SkillTree buildTree() const;
+    size_t getTreeNodeCount() const { return view_.nodeCount; }
+
+    // Replace the contents from a JSON data file; false (logged, contents
+    // unchanged) if it cannot be read or is invalid
+    bool loadDefinitions(const std::string& path);
+
+    // Replace the contents with a mapped snapshot; false (logged, contents
+    // unchanged) if it is missing, truncated or another version
+    bool loadSnapshot(const std::string& path);
+    bool saveSnapshot(const std::string& path) const;
+    bool isMapped() const { return map_ != nullptr; }
+
+    // Load default skills and tree (for demo/testing)
+    void loadDefaultSkills();
+
+    // Clear all skills and the tree
+    void clear();
+
+private:
+    SkillDatabase() = default;
+    SkillDatabase(const SkillDatabase&) = delete;
+    SkillDatabase& operator=(const SkillDatabase&) = delete;
+
+    // Where the tables are read from: owned_ or the mapped snapshot
+    struct View {
+        const SkillRecord* records = nullptr;
+        uint32_t recordCount = 0;
+        const EffectRecord* effects = nullptr;
+        uint32_t effectCount = 0;
+        const SkillLevelStats* levels = nullptr;
+        uint32_t levelCount = 0;
+        const TreeNodeRecord* nodes = nullptr;
+        uint32_t nodeCount = 0;
+        const SkillId* links = nullptr;
+        uint32_t linkCount = 0;
+        const char* strings = nullptr;
+        uint32_t stringBytes = 0;
+    };
+
+    struct Tables {
+        std::vector<SkillRecord> records;  // By skill id
+        std::vector<EffectRecord> effects;
+        std::vector<SkillLevelStats> levels;
+        std::vector<TreeNodeRecord> nodes;
+        std::vector<SkillId> links;
+        std::string strings;
+    };
+
+    static int32_t levelCount(const SkillRecord& record) { return std::max(record.maxLevel, 1); }
+
+    void detach();      // Copy a mapped snapshot into owned_
+    void viewOwned();   // Point view_ at owned_
+    void resetSkills();  // Drop materialized Skill objects
+    void recomputeTicks();
+    uint32_t addString(const std::string& text);
+    std::string_view string(uint32_t offset, uint32_t length) const { return {view_.strings + offset, length}; }
+
+    Tables owned_;
+    std::unique_ptr<MappedFile> map_;
+    View view_;
+    size_t skillCount_ = 0;
+    uint32_t tickRate_ = 20;
+
+    // getSkill() objects by id, built on demand
+    mutable std::mutex skillsMutex_;
+    mutable std::vector<std::unique_ptr<Skill>> skills_;
+};
+
+} // namespace mmorpg
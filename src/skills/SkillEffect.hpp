@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../core/Types.hpp"
+#include "../core/PrimaryStat.hpp"
 #include <variant>
 #include <chrono>
 #include <string>
@@ -22,7 +23,7 @@ struct HealEffect {
 
 // Buff effect (temporary stat increase)
 struct BuffEffect {
-    std::string statName;       // Which stat to buff (e.g., "strength")
+    PrimaryStat stat = PrimaryStat::Strength;  // Which stat to buff
     int32_t flatBonus = 0;      // +X to stat
     float percentBonus = 0.0f;  // +X% to stat
     float duration = 10.0f;     // Duration in seconds
@@ -30,7 +31,7 @@ struct BuffEffect {
 
 // Debuff effect (temporary stat decrease)
 struct DebuffEffect {
-    std::string statName;
+    PrimaryStat stat = PrimaryStat::Strength;
     int32_t flatPenalty = 0;
     float percentPenalty = 0.0f;
     float duration = 10.0f;
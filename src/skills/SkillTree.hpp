@@ -3,6 +3,7 @@
 #include "../core/Types.hpp"
 #include "Skill.hpp"
 #include <unordered_map>
+#include <algorithm>
 #include <unordered_set>
 #include <vector>
 #include <memory>
@@ -58,38 +59,4 @@ private:
     int32_t maxTier_ = 0;
 };
 
-// Singleton database of skill definitions
-class SkillDatabase {
-public:
-    static SkillDatabase& instance();
-
-    // Register a skill definition
-    void registerSkill(Skill skill);
-
-    // Get skill by ID (const)
-    const Skill* getSkill(SkillId id) const;
-
-    // Get skill copy for modification (e.g., leveling up)
-    Skill getSkillCopy(SkillId id) const;
-
-    // Check if skill exists
-    bool hasSkill(SkillId id) const;
-
-    // Get all skill IDs
-    std::vector<SkillId> getAllSkillIds() const;
-
-    // Load default skills (for demo/testing)
-    void loadDefaultSkills();
-
-    // Clear all skills
-    void clear();
-
-private:
-    SkillDatabase() = default;
-    SkillDatabase(const SkillDatabase&) = delete;
-    SkillDatabase& operator=(const SkillDatabase&) = delete;
-
-    std::unordered_map<SkillId, Skill> skills_;
-};
-
 } // namespace mmorpg
@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 #include "actors/Actor.hpp"
 #include "actors/ActorManager.hpp"
+#include "core/EventBus.hpp"
+#include "core/JobSystem.hpp"
+#include <boost/container/flat_map.hpp>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
 
 using namespace mmorpg;
 
@@ -120,7 +127,7 @@ TEST_F(ActorTest, ModifyPrimaryStat) {
     auto actor = manager.createActor<Actor>("TestActor");
     int32_t initialStr = actor->getPrimaryStats().strength;
 
-    actor->modifyPrimaryStat("strength", 10);
+    actor->modifyPrimaryStat(PrimaryStat::Strength, 10);
 
     EXPECT_EQ(actor->getPrimaryStats().strength, initialStr + 10);
 }
@@ -167,3 +174,788 @@ TEST_F(ActorTest, HpPercentage) {
     // Use EXPECT_NEAR due to integer division rounding
     EXPECT_NEAR(actor->getHpPercent(), 0.5f, 0.01f);
 }
+
+TEST_F(ActorTest, StaleIdDoesNotFindReusedSlot) {
+    auto first = manager.createActor<Actor>("First");
+    ActorId staleId = first->getId();
+    ASSERT_TRUE(manager.removeActor(staleId));
+
+    // The slot is reused under a new generation
+    auto second = manager.createActor<Actor>("Second");
+    EXPECT_NE(second->getId(), staleId);
+    EXPECT_EQ(second->getId() & SlotMap<ActorPtr>::INDEX_MASK, staleId & SlotMap<ActorPtr>::INDEX_MASK);
+
+    EXPECT_EQ(manager.getActor(staleId), nullptr);
+    EXPECT_EQ(manager.findActor(staleId), nullptr);
+    EXPECT_FALSE(manager.removeActor(staleId));
+    EXPECT_EQ(manager.findActor(second->getId()), second.get());
+}
+
+TEST_F(ActorTest, RemoveKeepsOthersReachable) {
+    std::vector<ActorPtr> actors;
+    for (int i = 0; i < 10; i++) {
+        actors.push_back(manager.createActor<Actor>("Actor" + std::to_string(i)));
+    }
+
+    // Remove from the middle and the ends; the rest must still resolve
+    for (int i : {0, 4, 9}) {
+        ASSERT_TRUE(manager.removeActor(actors[i]->getId()));
+    }
+    EXPECT_EQ(manager.getActorCount(), 7u);
+    for (int i = 0; i < 10; i++) {
+        bool removed = i == 0 || i == 4 || i == 9;
+        EXPECT_EQ(manager.findActor(actors[i]->getId()), removed ? nullptr : actors[i].get());
+    }
+    EXPECT_EQ(manager.getAllActors().size(), 7u);
+    EXPECT_EQ(manager.findActor(INVALID_ACTOR_ID), nullptr);
+}
+
+TEST_F(ActorTest, ClearInvalidatesIds) {
+    auto actor = manager.createActor<Actor>("Gone");
+    ActorId id = actor->getId();
+    manager.clear();
+
+    auto fresh = manager.createActor<Actor>("Fresh");
+    EXPECT_EQ(manager.getActorCount(), 1u);
+    EXPECT_EQ(manager.findActor(id), nullptr);
+    EXPECT_NE(fresh->getId(), id);
+}
+
+TEST_F(ActorTest, DISABLED_ActorChurnBenchmark) {
+    constexpr size_t ACTORS = 50000;
+    constexpr size_t CHURN = 2000;
+    constexpr size_t LOOKUPS = 1000000;
+    using Clock = std::chrono::steady_clock;
+    auto nsPer = [](Clock::duration elapsed, size_t ops) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / static_cast<long long>(ops);
+    };
+
+    // The previous storage, for comparison
+    auto runFlatMap = [&](long long& churnNs, long long& lookupNs) {
+        boost::container::flat_map<ActorId, ActorPtr> actors;
+        ActorId nextId = 1;
+        std::vector<ActorId> ids;
+        for (size_t i = 0; i < ACTORS; i++) {
+            ActorId id = nextId++;
+            actors[id] = std::make_shared<Actor>(id, "npc");
+            ids.push_back(id);
+        }
+        std::mt19937 rng(7);
+        auto start = Clock::now();
+        for (size_t i = 0; i < CHURN; i++) {
+            size_t victim = rng() % ids.size();
+            actors.erase(ids[victim]);
+            ActorId id = nextId++;
+            actors[id] = std::make_shared<Actor>(id, "npc");
+            ids[victim] = id;
+        }
+        churnNs = nsPer(Clock::now() - start, CHURN);
+
+        int32_t alive = 0;
+        start = Clock::now();
+        for (size_t i = 0; i < LOOKUPS; i++) {
+            auto it = actors.find(ids[rng() % ids.size()]);
+            ActorPtr actor = it == actors.end() ? nullptr : it->second;
+            alive += actor && actor->isAlive();
+        }
+        lookupNs = nsPer(Clock::now() - start, LOOKUPS);
+        EXPECT_EQ(alive, static_cast<int32_t>(LOOKUPS));
+    };
+
+    auto runSlotMap = [&](long long& churnNs, long long& lookupNs) {
+        ActorManager actors;
+        std::vector<ActorId> ids;
+        for (size_t i = 0; i < ACTORS; i++) {
+            ids.push_back(actors.createActor<Actor>("npc")->getId());
+        }
+        std::mt19937 rng(7);
+        auto start = Clock::now();
+        for (size_t i = 0; i < CHURN; i++) {
+            size_t victim = rng() % ids.size();
+            actors.removeActor(ids[victim]);
+            ids[victim] = actors.createActor<Actor>("npc")->getId();
+        }
+        churnNs = nsPer(Clock::now() - start, CHURN);
+
+        int32_t alive = 0;
+        start = Clock::now();
+        for (size_t i = 0; i < LOOKUPS; i++) {
+            const Actor* actor = actors.findActor(ids[rng() % ids.size()]);
+            alive += actor && actor->isAlive();
+        }
+        lookupNs = nsPer(Clock::now() - start, LOOKUPS);
+        EXPECT_EQ(alive, static_cast<int32_t>(LOOKUPS));
+    };
+
+    long long flatChurn = 0, flatLookup = 0, slotChurn = 0, slotLookup = 0;
+    runFlatMap(flatChurn, flatLookup);
+    runSlotMap(slotChurn, slotLookup);
+    std::cout << "At " << ACTORS << " actors, per op: spawn+despawn " << flatChurn << " ns flat_map vs "
+              << slotChurn << " ns slot map; lookup " << flatLookup << " ns vs " << slotLookup << " ns"
+              << std::endl;
+}
+
+TEST_F(ActorTest, RegenIsCappedAndSkipsTheDead) {
+    auto wounded = manager.createActor<Actor>("Wounded");
+    auto dead = manager.createActor<Actor>("Dead");
+    int32_t maxHp = wounded->getDerivedStats().maxHp;
+    wounded->takeDamage(15);
+    wounded->useMana(5);
+    wounded->setRegen(10, 10);
+    dead->setRegen(10, 10);
+    dead->takeDamage(dead->getDerivedStats().maxHp);
+
+    manager.updateAll(1);
+    EXPECT_EQ(wounded->getRuntimeStats().currentHp, maxHp - 5);
+    EXPECT_EQ(wounded->getRuntimeStats().currentMp, wounded->getDerivedStats().maxMp);
+
+    manager.updateAll(2);
+    EXPECT_EQ(wounded->getRuntimeStats().currentHp, maxHp);
+    EXPECT_FALSE(dead->isAlive());
+}
+
+TEST_F(ActorTest, PeriodicEffectExpires) {
+    auto actor = manager.createActor<Actor>("Target");
+    int32_t maxHp = actor->getDerivedStats().maxHp;
+    actor->addPeriodicEffect({-5, 3});
+    EXPECT_EQ(manager.getComponents().effectCount(), 1u);
+
+    for (Tick tick = 1; tick <= 5; tick++) {
+        manager.updateAll(tick);
+    }
+    EXPECT_EQ(actor->getRuntimeStats().currentHp, maxHp - 15);
+    EXPECT_EQ(manager.getComponents().effectCount(), 0u);
+}
+
+TEST_F(ActorTest, PeriodicDamageKills) {
+    class Tracked : public Actor {
+    public:
+        Tracked(ActorId id, std::string name, int& deaths)
+            : Actor(id, std::move(name)), deaths_(deaths) {}
+    protected:
+        void onDeath() override { deaths_++; }
+    private:
+        int& deaths_;
+    };
+
+    int deaths = 0;
+    auto actor = manager.createActor<Tracked>("Doomed", deaths);
+    actor->addPeriodicEffect({-actor->getDerivedStats().maxHp / 2 - 1, 10});
+
+    manager.updateAll(1);
+    EXPECT_TRUE(actor->isAlive());
+    manager.updateAll(2);
+    EXPECT_FALSE(actor->isAlive());
+    EXPECT_EQ(deaths, 1);
+    EXPECT_EQ(manager.getComponents().effectCount(), 0u);
+}
+
+TEST_F(ActorTest, DrainStopsAtZeroAndKills) {
+    class Tracked : public Actor {
+    public:
+        Tracked(ActorId id, std::string name, int& deaths)
+            : Actor(id, std::move(name)), deaths_(deaths) {}
+    protected:
+        void onDeath() override { deaths_++; }
+    private:
+        int& deaths_;
+    };
+
+    int deaths = 0;
+    auto actor = manager.createActor<Tracked>("Drained", deaths);
+    int32_t maxHp = actor->getDerivedStats().maxHp;
+    actor->setRegen(-(maxHp / 2 + 1), -actor->getDerivedStats().maxMp);
+
+    manager.updateAll(1);
+    EXPECT_TRUE(actor->isAlive());
+    EXPECT_EQ(actor->getRuntimeStats().currentMp, 0);
+    EXPECT_EQ(deaths, 0);
+
+    // Killed in the tick the drain empties HP, not below zero
+    manager.updateAll(2);
+    EXPECT_FALSE(actor->isAlive());
+    EXPECT_EQ(actor->getRuntimeStats().currentHp, 0);
+    EXPECT_EQ(actor->getRuntimeStats().currentMp, 0);
+    EXPECT_EQ(deaths, 1);
+    EXPECT_FALSE(manager.getComponents().isRegenerating(ActorManager::rowOf(actor->getId())));
+
+    manager.updateAll(3);
+    EXPECT_EQ(deaths, 1);
+}
+
+TEST_F(ActorTest, PeriodicEffectRunsEveryInterval) {
+    auto actor = manager.createActor<Actor>("Poisoned");
+    int32_t maxHp = actor->getDerivedStats().maxHp;
+    actor->addPeriodicEffect({-4, 2, 5});
+
+    for (Tick tick = 1; tick <= 4; tick++) {
+        manager.updateAll(tick);
+    }
+    EXPECT_EQ(actor->getRuntimeStats().currentHp, maxHp);
+    manager.updateAll(5);
+    EXPECT_EQ(actor->getRuntimeStats().currentHp, maxHp - 4);
+    manager.updateAll(10);
+    EXPECT_EQ(actor->getRuntimeStats().currentHp, maxHp - 8);
+    EXPECT_EQ(manager.getComponents().effectCount(), 0u);
+    EXPECT_TRUE(manager.getTimers().empty());
+}
+
+TEST_F(ActorTest, RemovalCancelsTimers) {
+    auto actor = manager.createActor<Actor>("Leaving");
+    actor->addPeriodicEffect({-1, 100});
+    actor->addStatModifier({PrimaryStat::Strength, 5, 0.0f, 1, 100});
+    EXPECT_EQ(manager.getTimers().size(), 2u);
+
+    manager.removeActor(actor->getId());
+    EXPECT_TRUE(manager.getTimers().empty());
+    EXPECT_EQ(manager.getComponents().effectCount(), 0u);
+}
+
+TEST_F(ActorTest, ReviveRestoresTheDead) {
+    auto actor = manager.createActor<Actor>("Fallen");
+    actor->revive();  // Alive: nothing to do
+    actor->useMana(5);
+    EXPECT_LT(actor->getRuntimeStats().currentMp, actor->getDerivedStats().maxMp);
+
+    actor->takeDamage(actor->getDerivedStats().maxHp);
+    ASSERT_FALSE(actor->isAlive());
+    actor->revive();
+    EXPECT_EQ(actor->getRuntimeStats().currentHp, actor->getDerivedStats().maxHp);
+    EXPECT_EQ(actor->getRuntimeStats().currentMp, actor->getDerivedStats().maxMp);
+}
+
+TEST_F(ActorTest, RemovedActorKeepsItsState) {
+    auto actor = manager.createActor<Actor>("Leaving");
+    actor->takeDamage(20);
+    actor->setPosition({3.0f, 4.0f});
+    int32_t hp = actor->getRuntimeStats().currentHp;
+    EXPECT_TRUE(actor->isAttached());
+
+    manager.removeActor(actor->getId());
+    EXPECT_FALSE(actor->isAttached());
+    EXPECT_EQ(manager.getComponents().activeCount(), 0u);
+
+    // The reused row must not alias the departed actor
+    auto next = manager.createActor<Actor>("Arriving");
+    next->takeDamage(1);
+    EXPECT_EQ(actor->getRuntimeStats().currentHp, hp);
+    EXPECT_FLOAT_EQ(actor->getPosition().y, 4.0f);
+    actor->heal(5);
+    EXPECT_EQ(actor->getRuntimeStats().currentHp, hp + 5);
+}
+
+TEST_F(ActorTest, ManagedActorsStartOnTheSharedStore) {
+    auto held = manager.createActor<Actor>("Held");
+    ActorId dropped = manager.createActor<Actor>("Dropped")->getId();
+    EXPECT_TRUE(held->isAttached());
+    EXPECT_EQ(manager.getComponents().activeCount(), 2u);
+
+    // Nobody else holds it, so its row is just freed
+    manager.removeActor(dropped);
+    EXPECT_EQ(manager.getComponents().activeCount(), 1u);
+    EXPECT_FALSE(manager.getComponents().isActive(ActorManager::rowOf(dropped)));
+
+    // Actors built outside the manager keep their own store
+    Actor loner(held->getId(), "Loner");
+    EXPECT_FALSE(loner.isAttached());
+    EXPECT_EQ(manager.getComponents().activeCount(), 1u);
+}
+
+TEST_F(ActorTest, CollectDirtyReportsChangedRows) {
+    auto a = manager.createActor<Actor>("A");
+    auto b = manager.createActor<Actor>("B");
+    auto c = manager.createActor<Actor>("C");
+
+    std::vector<ActorComponents::Row> rows;
+    manager.collectDirty(rows);
+    EXPECT_TRUE(rows.empty());  // Spawning alone is not a change
+
+    a->takeDamage(1);
+    c->setPosition({1.0f, 1.0f});
+    b->heal(10);  // Already at max: no change
+    manager.collectDirty(rows);
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_EQ(manager.getComponents().id(rows[0]), a->getId());
+    EXPECT_EQ(manager.getComponents().id(rows[1]), c->getId());
+
+    rows.clear();
+    manager.collectDirty(rows);
+    EXPECT_TRUE(rows.empty());
+}
+
+TEST_F(ActorTest, CollectDirtyFollowsRegenAndRemoval) {
+    auto regen = manager.createActor<Actor>("Regen");
+    auto leaving = manager.createActor<Actor>("Leaving");
+    regen->takeDamage(10);
+    regen->setRegen(1, 0);
+    leaving->takeDamage(10);
+    manager.removeActor(leaving->getId());
+
+    std::vector<ActorComponents::Row> rows;
+    manager.collectDirty(rows);
+    ASSERT_EQ(rows.size(), 1u);  // The removed actor's change is dropped
+    EXPECT_EQ(manager.getComponents().id(rows[0]), regen->getId());
+
+    // Regen changes are listed too, once per collect
+    rows.clear();
+    manager.updateAll(1);
+    manager.updateAll(2);
+    manager.collectDirty(rows);
+    ASSERT_EQ(rows.size(), 1u);
+    EXPECT_EQ(manager.getComponents().id(rows[0]), regen->getId());
+}
+
+TEST_F(ActorTest, DISABLED_RegenSystemBenchmark) {
+    constexpr size_t ACTORS = 50000;
+    constexpr int TICKS = 20;
+    using Clock = std::chrono::steady_clock;
+
+    ActorManager actors;
+    for (size_t i = 0; i < ACTORS; i++) {
+        auto actor = actors.createActor<Actor>("npc");
+        actor->setRegen(1, 1);
+    }
+    auto drain = [&] {
+        for (const auto& actor : actors.getAllActors()) {
+            actor->takeDamage(TICKS);
+            actor->useMana(TICKS);
+        }
+    };
+
+    // Per-object regen: a virtual call and a pointer chase per actor
+    drain();
+    auto all = actors.getAllActors();
+    auto start = Clock::now();
+    for (int tick = 0; tick < TICKS; tick++) {
+        for (const auto& actor : all) {
+            actor->update(tick);
+            actor->heal(actor->getHpRegen());
+            actor->restoreMana(actor->getMpRegen());
+        }
+    }
+    auto perObject = Clock::now() - start;
+
+    // The regen system over the component columns
+    drain();
+    start = Clock::now();
+    for (int tick = 0; tick < TICKS; tick++) {
+        actors.updateAll(tick);
+    }
+    auto system = Clock::now() - start;
+
+    for (const auto& actor : all) {
+        ASSERT_EQ(actor->getHpPercent(), 1.0f);
+    }
+
+    using std::chrono::nanoseconds;
+    auto perActor = [&](Clock::duration elapsed) {
+        return std::chrono::duration_cast<nanoseconds>(elapsed).count() / static_cast<long long>(ACTORS * TICKS);
+    };
+    std::cout << "Regen at " << ACTORS << " actors, per actor-tick: " << perActor(perObject)
+              << " ns per-object vs " << perActor(system) << " ns updateAll"
+              << std::endl;
+}
+
+TEST_F(ActorTest, StatChangesRecalculateOncePerTick) {
+    auto actor = manager.createActor<Actor>("Buffed");
+    int32_t maxHp = actor->getDerivedStats().maxHp;
+    actor->takeDamage(maxHp / 2);
+
+    // Three changes queue one row; nothing is derived until the tick
+    actor->setPrimaryStat(PrimaryStat::Vitality, 20);
+    actor->setPrimaryStat(PrimaryStat::Strength, 30);
+    actor->modifyPrimaryStat(PrimaryStat::Vitality, 10);
+    EXPECT_TRUE(manager.getComponents().isStatsDirty(ActorManager::rowOf(actor->getId())));
+    EXPECT_EQ(manager.getComponents().pendingStatsCount(), 1u);
+
+    manager.updateAll(1);
+    EXPECT_FALSE(manager.getComponents().isStatsDirty(ActorManager::rowOf(actor->getId())));
+    EXPECT_EQ(manager.getComponents().pendingStatsCount(), 0u);
+
+    PrimaryStats expectedPrimary;
+    expectedPrimary.vitality = 30;
+    expectedPrimary.strength = 30;
+    auto expected = StatCalculator::calculate(expectedPrimary, 1);
+    EXPECT_EQ(actor->getDerivedStats().maxHp, expected.maxHp);
+    EXPECT_EQ(actor->getDerivedStats().physicalAttack, expected.physicalAttack);
+    // Still at half health, against the new maximum
+    EXPECT_NEAR(actor->getHpPercent(), 0.5f, 0.01f);
+}
+
+TEST_F(ActorTest, ReadingStatsResolvesPendingChange) {
+    auto actor = manager.createActor<Actor>("Eager");
+    actor->setPrimaryStat(PrimaryStat::Vitality, 50);
+
+    // Readers never see stale values, even before the tick
+    EXPECT_EQ(actor->getDerivedStats().maxHp, 100 + 50 * 10 + 5);
+    EXPECT_EQ(actor->getRuntimeStats().currentHp, actor->getDerivedStats().maxHp);
+    EXPECT_FALSE(manager.getComponents().isStatsDirty(ActorManager::rowOf(actor->getId())));
+
+    manager.updateAll(1);
+    EXPECT_EQ(actor->getDerivedStats().maxHp, 100 + 50 * 10 + 5);
+}
+
+TEST_F(ActorTest, TimedModifierExpires) {
+    auto actor = manager.createActor<Actor>("Buffed");
+    int32_t baseAttack = actor->getDerivedStats().physicalAttack;
+
+    actor->addStatModifier({PrimaryStat::Strength, 20, 0.0f, 7, 3});
+    EXPECT_EQ(actor->getEffectivePrimaryStats().strength, 30);
+    EXPECT_EQ(actor->getPrimaryStats().strength, 10);  // Base is untouched
+    EXPECT_EQ(actor->getDerivedStats().physicalAttack, baseAttack + 40);
+
+    manager.updateAll(2);
+    EXPECT_EQ(actor->getStatModifiers().size(), 1u);
+    manager.updateAll(3);
+    EXPECT_TRUE(actor->getStatModifiers().empty());
+    EXPECT_EQ(actor->getDerivedStats().physicalAttack, baseAttack);
+}
+
+TEST_F(ActorTest, RemoveModifiersBySource) {
+    auto actor = manager.createActor<Actor>("Cleansed");
+    int32_t baseHp = actor->getDerivedStats().maxHp;
+    auto kept = actor->addStatModifier({PrimaryStat::Vitality, 5, 0.0f, 1, 0});
+    actor->addStatModifier({PrimaryStat::Vitality, -8, 0.0f, 2, 0});
+    actor->addStatModifier({PrimaryStat::Agility, -4, -0.1f, 2, 0});
+    EXPECT_EQ(actor->getDerivedStats().maxHp, baseHp - 30);
+
+    EXPECT_TRUE(actor->removeStatModifiersFrom(2));
+    EXPECT_FALSE(actor->removeStatModifiersFrom(2));
+    EXPECT_EQ(actor->getDerivedStats().maxHp, baseHp + 50);
+    EXPECT_FLOAT_EQ(actor->getDerivedStats().attackSpeed, StatCalculator::calculate(PrimaryStats{}, 1).attackSpeed);
+
+    EXPECT_TRUE(actor->removeStatModifier(kept));
+    EXPECT_EQ(actor->getDerivedStats().maxHp, baseHp);
+}
+
+TEST_F(ActorTest, ModifiersSurviveRemoval) {
+    auto actor = manager.createActor<Actor>("Leaving");
+    actor->addStatModifier({PrimaryStat::Luck, 10, 0.0f, 1, 50});
+    manager.removeActor(actor->getId());
+
+    // The detached copy keeps its modifiers; the vacated row has none
+    EXPECT_EQ(actor->getEffectivePrimaryStats().luck, 20);
+    auto next = manager.createActor<Actor>("Arriving");
+    manager.updateAll(50);
+    EXPECT_TRUE(next->getStatModifiers().empty());
+    EXPECT_EQ(actor->getEffectivePrimaryStats().luck, 20);
+}
+
+TEST_F(ActorTest, ShieldAbsorbsItsKindUntilExpiry) {
+    auto actor = manager.createActor<Actor>("Warded");
+    int32_t maxHp = actor->getDerivedStats().maxHp;
+    actor->setShield({30, false, true, 10});
+
+    EXPECT_EQ(actor->takeDamage(20, true), 20);  // Physical goes through
+    EXPECT_EQ(actor->takeDamage(20, false), 0);
+    EXPECT_EQ(actor->getShield(), 10);
+    EXPECT_EQ(actor->takeDamage(25, false), 15);
+    EXPECT_EQ(actor->getShield(), 0);
+    EXPECT_EQ(actor->getRuntimeStats().currentHp, maxHp - 35);
+
+    // Expiry is on the manager's clock, and the rest travels with the actor
+    actor->setShield({50, true, true, 10});
+    manager.updateAll(6);
+    manager.removeActor(actor->getId());
+    EXPECT_EQ(actor->getShield(), 50);
+    auto next = manager.createActor<Actor>("Unwarded");
+    EXPECT_EQ(next->getShield(), 0);
+
+    auto kept = manager.createActor<Actor>("Expiring");
+    kept->setShield({50, true, true, 10});
+    manager.updateAll(10);
+    EXPECT_EQ(kept->getShield(), 0);
+    EXPECT_EQ(kept->takeDamage(5, true), 5);
+}
+
+TEST_F(ActorTest, DISABLED_RaidBuffChurnBenchmark) {
+    constexpr size_t ACTORS = 40;         // One raid, buffed many times a tick
+    constexpr int TICKS = 100;
+    constexpr int BUFFS_PER_TICK = 500;   // Applied each tick, lasting DURATION ticks
+    constexpr Tick DURATION = 10;
+    const char* statNames[] = {"strength", "agility", "intelligence", "vitality", "wisdom", "luck"};
+    using Clock = std::chrono::steady_clock;
+
+    // The previous path: string dispatch and a full recalculation on
+    // every apply and every expiry
+    struct Timed { size_t actor; const char* stat; int32_t amount; Tick expires; };
+    std::vector<PrimaryStats> primary(ACTORS);
+    std::vector<DerivedStats> derived(ACTORS);
+    auto modify = [&](size_t actor, const std::string& stat, int32_t delta) {
+        PrimaryStats& p = primary[actor];
+        if (stat == "strength") p.strength += delta;
+        else if (stat == "agility") p.agility += delta;
+        else if (stat == "intelligence") p.intelligence += delta;
+        else if (stat == "vitality") p.vitality += delta;
+        else if (stat == "wisdom") p.wisdom += delta;
+        else if (stat == "luck") p.luck += delta;
+        derived[actor] = StatCalculator::calculate(p, 10);
+    };
+    std::vector<Timed> active;
+    std::mt19937 rng(3);
+    auto start = Clock::now();
+    for (Tick tick = 1; tick <= TICKS; tick++) {
+        for (int b = 0; b < BUFFS_PER_TICK; b++) {
+            size_t actor = rng() % ACTORS;
+            const char* stat = statNames[rng() % 6];
+            modify(actor, stat, 5);
+            active.push_back({actor, stat, 5, tick + DURATION});
+        }
+        for (size_t i = 0; i < active.size();) {
+            if (active[i].expires <= tick) {
+                modify(active[i].actor, active[i].stat, -active[i].amount);
+                active[i] = active.back();
+                active.pop_back();
+            } else {
+                i++;
+            }
+        }
+    }
+    auto stringPath = Clock::now() - start;
+
+    ActorManager raid;
+    std::vector<ActorPtr> actors;
+    for (size_t i = 0; i < ACTORS; i++) {
+        actors.push_back(raid.createActor<Actor>("raider"));
+    }
+    rng.seed(3);
+    start = Clock::now();
+    for (Tick tick = 1; tick <= TICKS; tick++) {
+        for (int b = 0; b < BUFFS_PER_TICK; b++) {
+            size_t actor = rng() % ACTORS;
+            auto stat = static_cast<PrimaryStat>(rng() % 6);
+            actors[actor]->addStatModifier({stat, 5, 0.0f, 1, tick + DURATION});
+        }
+        raid.updateAll(tick);
+    }
+    auto modifierPath = Clock::now() - start;
+
+    using std::chrono::microseconds;
+    std::cout << "Raid of " << ACTORS << " with " << BUFFS_PER_TICK << " buffs/tick, per tick: "
+              << std::chrono::duration_cast<microseconds>(stringPath).count() / TICKS << " us string+full recalc vs "
+              << std::chrono::duration_cast<microseconds>(modifierPath).count() / TICKS
+              << " us modifier stacks (incl. updateAll)" << std::endl;
+}
+
+namespace {
+
+class Counting : public Actor {
+public:
+    Counting(ActorId id, std::string name) : Actor(id, std::move(name)) {}
+    void update(Tick currentTick) override {
+        updates++;
+        lastTick = currentTick;
+    }
+    int updates = 0;
+    Tick lastTick = 0;
+};
+
+// Touches everything an update may: its own HP, modifiers, effects,
+// update registration, wakeups and events
+class Brawler : public Actor {
+public:
+    Brawler(ActorId id, std::string name) : Actor(id, std::move(name)) {}
+    void update(Tick currentTick) override {
+        int32_t phase = static_cast<int32_t>((getId() + currentTick) % 4);
+        int32_t dealt = takeDamage(1 + phase);
+        queueEvent(DamageEvent{getId(), getId(), dealt, false, true});
+        switch (phase) {
+            case 0: addStatModifier({PrimaryStat::Vitality, 2, 0.0f, 1, currentTick + 3}); break;
+            case 1: addPeriodicEffect({-1, 2, 1}); break;
+            case 2: setUpdating(false); wakeAt(currentTick + 2); break;
+            default: setUpdating(true); break;
+        }
+    }
+};
+
+} // namespace
+
+TEST_F(ActorTest, OnlyTheUpdateSetIsUpdated) {
+    auto idle = manager.createActor<Counting>("Idle");
+    auto busy = manager.createActor<Counting>("Busy");
+    auto sleeper = manager.createActor<Counting>("Sleeper");
+    busy->setUpdating(true);
+    sleeper->wakeAt(3);
+
+    for (Tick tick = 1; tick <= 5; tick++) {
+        manager.updateAll(tick);
+    }
+    EXPECT_EQ(idle->updates, 0);
+    EXPECT_EQ(busy->updates, 5);
+    EXPECT_EQ(sleeper->updates, 1);
+    EXPECT_EQ(sleeper->lastTick, 3u);
+    EXPECT_EQ(manager.getComponents().updateRows().size(), 1u);
+
+    busy->setUpdating(false);
+    manager.updateAll(6);
+    EXPECT_EQ(busy->updates, 5);
+    EXPECT_TRUE(manager.getComponents().updateRows().empty());
+}
+
+TEST_F(ActorTest, RegenOnlyVisitsActorsBelowMax) {
+    auto actor = manager.createActor<Actor>("Resting");
+    ActorComponents::Row row = ActorManager::rowOf(actor->getId());
+    actor->setRegen(5, 0);
+    EXPECT_FALSE(manager.getComponents().isRegenerating(row));  // Already full
+
+    actor->takeDamage(8);
+    EXPECT_TRUE(manager.getComponents().isRegenerating(row));
+    manager.updateAll(1);
+    manager.updateAll(2);
+    EXPECT_EQ(actor->getHpPercent(), 1.0f);
+    EXPECT_EQ(manager.getComponents().regeneratingCount(), 0u);
+
+    // The dead don't regenerate
+    actor->takeDamage(5);
+    EXPECT_TRUE(manager.getComponents().isRegenerating(row));
+    actor->takeDamage(actor->getDerivedStats().maxHp);
+    manager.updateAll(3);
+    EXPECT_FALSE(manager.getComponents().isRegenerating(row));
+}
+
+TEST_F(ActorTest, DISABLED_IdlePopulationBenchmark) {
+    constexpr size_t ACTORS = 100000;
+    constexpr size_t ACTIVE = 100;
+    constexpr int TICKS = 50;
+    using Clock = std::chrono::steady_clock;
+
+    ActorManager world;
+    std::vector<std::shared_ptr<Counting>> actors;
+    for (size_t i = 0; i < ACTORS; i++) {
+        actors.push_back(world.createActor<Counting>("npc"));
+        actors.back()->setRegen(1, 1);
+    }
+
+    // A few busy actors among an idle crowd
+    for (size_t i = 0; i < ACTIVE; i++) {
+        actors[i * (ACTORS / ACTIVE)]->setUpdating(true);
+        actors[i * (ACTORS / ACTIVE)]->takeDamage(TICKS);
+    }
+    Tick tick = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < TICKS; i++) {
+        world.updateAll(++tick);
+    }
+    auto sparse = Clock::now() - start;
+    EXPECT_EQ(actors[0]->updates, TICKS);
+    EXPECT_EQ(actors[1]->updates, 0);
+
+    // Everyone registered: the old every-actor cost
+    for (auto& actor : actors) {
+        actor->setUpdating(true);
+    }
+    start = Clock::now();
+    for (int i = 0; i < TICKS; i++) {
+        world.updateAll(++tick);
+    }
+    auto dense = Clock::now() - start;
+
+    using std::chrono::microseconds;
+    std::cout << "updateAll with " << ACTORS << " actors, per tick: "
+              << std::chrono::duration_cast<microseconds>(sparse).count() / TICKS << " us with "
+              << ACTIVE << " active vs " << std::chrono::duration_cast<microseconds>(dense).count() / TICKS
+              << " us with all active" << std::endl;
+}
+
+TEST_F(ActorTest, ParallelUpdateMatchesSerial) {
+    constexpr size_t ACTORS = 3000;
+    constexpr Tick TICKS = 40;
+
+    struct World {
+        std::unique_ptr<JobSystem> jobs;
+        ActorManager manager;
+        std::shared_ptr<EventBus> bus = std::make_shared<EventBus>();
+        std::vector<std::shared_ptr<Brawler>> actors;
+        std::vector<GameEvent> events;
+    };
+    auto run = [&](World& world) {
+        world.manager.setJobSystem(world.jobs.get());
+        world.manager.setEventBus(world.bus);
+        world.bus->subscribe([&world](const GameEvent& event) { world.events.push_back(event); });
+        for (size_t i = 0; i < ACTORS; i++) {
+            world.actors.push_back(world.manager.createActor<Brawler>("brawler"));
+            world.actors.back()->setRegen(2, 1);
+            world.actors.back()->setUpdating(true);
+        }
+        for (Tick tick = 1; tick <= TICKS; tick++) {
+            world.manager.updateAll(tick);
+            world.bus->processQueue();
+        }
+    };
+
+    World serial;
+    World parallel;
+    parallel.jobs = std::make_unique<JobSystem>(3);
+    run(serial);
+    run(parallel);
+
+    for (size_t i = 0; i < ACTORS; i++) {
+        const Brawler& a = *serial.actors[i];
+        const Brawler& b = *parallel.actors[i];
+        ASSERT_EQ(a.getRuntimeStats().currentHp, b.getRuntimeStats().currentHp) << "actor " << i;
+        ASSERT_EQ(a.getRuntimeStats().currentMp, b.getRuntimeStats().currentMp) << "actor " << i;
+        ASSERT_EQ(a.getDerivedStats().maxHp, b.getDerivedStats().maxHp) << "actor " << i;
+        ASSERT_EQ(a.getStatModifiers().size(), b.getStatModifiers().size()) << "actor " << i;
+        ASSERT_EQ(a.isUpdating(), b.isUpdating()) << "actor " << i;
+    }
+    EXPECT_EQ(serial.manager.getComponents().updateRows(), parallel.manager.getComponents().updateRows());
+    EXPECT_EQ(serial.manager.getComponents().effectCount(), parallel.manager.getComponents().effectCount());
+    EXPECT_EQ(serial.manager.getTimers().size(), parallel.manager.getTimers().size());
+
+    // Same events in the same order
+    ASSERT_EQ(serial.events.size(), parallel.events.size());
+    EXPECT_GT(serial.events.size(), ACTORS);
+    for (size_t i = 0; i < serial.events.size(); i++) {
+        ASSERT_EQ(serial.events[i].index(), parallel.events[i].index()) << "event " << i;
+        if (auto* damage = std::get_if<DamageEvent>(&serial.events[i])) {
+            const auto& other = std::get<DamageEvent>(parallel.events[i]);
+            ASSERT_EQ(damage->target, other.target) << "event " << i;
+            ASSERT_EQ(damage->damage, other.damage) << "event " << i;
+        }
+    }
+}
+
+TEST_F(ActorTest, UnmanagedActorsQueueEventsDirectly) {
+    auto bus = std::make_shared<EventBus>();
+    Actor actor(1, "Loner");
+    actor.setEventBus(bus);
+    actor.queueEvent(HealEvent{1, 1, 5});
+    EXPECT_EQ(bus->getQueueSize(), 1u);
+
+    // Managed: held until the end of updateAll
+    manager.setEventBus(bus);
+    auto managed = manager.createActor<Actor>("Member");
+    managed->queueEvent(HealEvent{managed->getId(), managed->getId(), 5});
+    EXPECT_EQ(bus->getQueueSize(), 1u);
+    manager.updateAll(1);
+    EXPECT_EQ(bus->getQueueSize(), 2u);
+}
+
+TEST_F(ActorTest, DISABLED_ParallelUpdateBenchmark) {
+    constexpr size_t ACTORS = 20000;
+    constexpr int TICKS = 20;
+    using Clock = std::chrono::steady_clock;
+
+    auto perTick = [&](JobSystem* jobs) {
+        ActorManager world;
+        world.setJobSystem(jobs);
+        std::vector<std::shared_ptr<Brawler>> actors;
+        for (size_t i = 0; i < ACTORS; i++) {
+            actors.push_back(world.createActor<Brawler>("brawler"));
+            actors.back()->setRegen(2, 1);
+            actors.back()->setUpdating(true);
+        }
+        auto start = Clock::now();
+        for (Tick tick = 1; tick <= static_cast<Tick>(TICKS); tick++) {
+            world.updateAll(tick);
+        }
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / TICKS;
+    };
+
+    size_t workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    JobSystem jobs(workers);
+    double serial = perTick(nullptr);
+    double parallel = perTick(&jobs);
+    std::cout << "updateAll with " << ACTORS << " busy actors, per tick: " << serial << " us on one thread vs "
+              << parallel << " us on " << jobs.getThreadCount() << " threads" << std::endl;
+}
@@ -3,6 +3,9 @@
 #include "combat/DamageCalculator.hpp"
 #include "actors/ActorManager.hpp"
 #include "core/EventBus.hpp"
+#include "skills/SkillDatabase.hpp"
+#include <chrono>
+#include <iostream>
 
 using namespace mmorpg;
 
@@ -24,7 +27,7 @@ TEST_F(CombatTest, BasicAttackDealsDamage) {
     auto attacker = actorManager->createActor<Actor>("Attacker");
     auto defender = actorManager->createActor<Actor>("Defender");
 
-    attacker->setPrimaryStat("strength", 30);
+    attacker->setPrimaryStat(PrimaryStat::Strength, 30);
     int32_t defenderHpBefore = defender->getRuntimeStats().currentHp;
 
     BasicAttack attack{attacker->getId(), defender->getId(), true};
@@ -65,9 +68,9 @@ TEST_F(CombatTest, DamageEventPublished) {
     auto defender = actorManager->createActor<Actor>("Defender");
 
     // Set high strength to ensure damage is dealt
-    attacker->setPrimaryStat("strength", 50);
+    attacker->setPrimaryStat(PrimaryStat::Strength, 50);
     // Set low agility to minimize dodge chance
-    defender->setPrimaryStat("agility", 0);
+    defender->setPrimaryStat(PrimaryStat::Agility, 0);
 
     bool eventReceived = false;
     int attempts = 0;
@@ -96,7 +99,7 @@ TEST_F(CombatTest, DeathEventOnKill) {
     auto defender = actorManager->createActor<Actor>("Defender");
 
     // Make attacker very strong
-    attacker->setPrimaryStat("strength", 100);
+    attacker->setPrimaryStat(PrimaryStat::Strength, 100);
 
     // Weaken defender
     defender->takeDamage(defender->getDerivedStats().maxHp - 1);
@@ -119,8 +122,8 @@ TEST_F(CombatTest, DamageCalculatorMinimumDamage) {
     auto defender = actorManager->createActor<Actor>("Defender");
 
     // Weak attacker, strong defender
-    attacker->setPrimaryStat("strength", 1);
-    defender->setPrimaryStat("vitality", 100);
+    attacker->setPrimaryStat(PrimaryStat::Strength, 1);
+    defender->setPrimaryStat(PrimaryStat::Vitality, 100);
 
     DamageCalculator calc;
     auto result = calc.calculateBasicAttack(*attacker, *defender, true);
@@ -135,8 +138,8 @@ TEST_F(CombatTest, PhysicalVsMagicalDamage) {
     auto attacker = actorManager->createActor<Actor>("Attacker");
     auto defender = actorManager->createActor<Actor>("Defender");
 
-    attacker->setPrimaryStat("strength", 30);
-    attacker->setPrimaryStat("intelligence", 30);
+    attacker->setPrimaryStat(PrimaryStat::Strength, 30);
+    attacker->setPrimaryStat(PrimaryStat::Intelligence, 30);
 
     DamageCalculator calc;
     auto physResult = calc.calculateBasicAttack(*attacker, *defender, true);
@@ -171,3 +174,382 @@ TEST_F(CombatTest, InvalidTargetReturnsEmpty) {
 
     EXPECT_FALSE(canAttack);
 }
+
+// Attack + bonus, with no defense, crits or dodges
+class FlatFormula : public DamageFormula {
+public:
+    DamageResult calculate(const Actor& attacker, const Actor&, bool isPhysical, int32_t bonusDamage) override {
+        const DerivedStats& stats = attacker.getDerivedStats();
+        DamageResult result;
+        result.rawDamage = (isPhysical ? stats.physicalAttack : stats.magicalAttack) + bonusDamage;
+        result.finalDamage = result.rawDamage;
+        result.isPhysical = isPhysical;
+        return result;
+    }
+};
+
+class SkillEffectTest : public CombatTest {
+protected:
+    void SetUp() override {
+        CombatTest::SetUp();
+        SkillDatabase::instance().loadDefaultSkills();
+        combatSystem->getSkillExecutor().setEffects(CompiledSkillEffects::compile(SkillDatabase::instance()));
+        combatSystem->getDamageCalculator().setFormula(std::make_unique<FlatFormula>());
+    }
+
+    void TearDown() override {
+        SkillDatabase::instance().loadDefaultSkills();
+    }
+
+    const CompiledSkillEffects& effects() { return *combatSystem->getSkillExecutor().getEffects(); }
+};
+
+TEST_F(SkillEffectTest, CompiledEffectsBakeInLevels) {
+    const SkillDatabase& db = SkillDatabase::instance();
+
+    auto fireball = effects().getOps(2, 3);
+    ASSERT_EQ(fireball.size(), 1u);
+    EXPECT_EQ(fireball.begin->code, EffectOp::Code::Damage);
+    EXPECT_EQ(fireball.begin->amount, db.getLevelStats(2, 3)->damage);
+    EXPECT_EQ(fireball.begin->flags & EFFECT_PHYSICAL, 0);
+    EXPECT_FLOAT_EQ(fireball.begin->scaling, 1.2f);
+    EXPECT_EQ(effects().getOps(2, 99).begin, effects().getOps(2, 5).begin);  // Clamped
+    EXPECT_TRUE(effects().getOps(2, 0).empty());
+    EXPECT_TRUE(effects().getOps(999, 1).empty());
+
+    // Regeneration: 20 HP a second for 10 seconds
+    const EffectOp& hot = *effects().getOps(6, 1).begin;
+    EXPECT_EQ(hot.code, EffectOp::Code::Periodic);
+    EXPECT_EQ(hot.amount, 20);
+    EXPECT_EQ(hot.duration, 10u);
+    EXPECT_EQ(hot.interval, TimingWheel::toTicks(1.0f, db.getTickRate()));
+
+    // Berserk at level 2 (scale 1.25)
+    const EffectOp& buff = *effects().getOps(7, 2).begin;
+    EXPECT_EQ(buff.code, EffectOp::Code::Modifier);
+    EXPECT_EQ(buff.stat, PrimaryStat::Strength);
+    EXPECT_EQ(buff.amount, 25);
+    EXPECT_FLOAT_EQ(buff.scaling, 0.625f);
+    EXPECT_EQ(buff.duration, TimingWheel::toTicks(15.0f, db.getTickRate()));
+
+    const EffectOp& shield = *effects().getOps(9, 1).begin;
+    EXPECT_EQ(shield.code, EffectOp::Code::Shield);
+    EXPECT_EQ(shield.amount, 200);
+    EXPECT_EQ(shield.flags, EFFECT_ABSORBS_PHYSICAL | EFFECT_ABSORBS_MAGICAL);
+}
+
+TEST_F(SkillEffectTest, SkillAttackDealsTheSkillsDamage) {
+    auto caster = actorManager->createActor<Actor>("Caster");
+    auto target = actorManager->createActor<Actor>("Target");
+    target->setPrimaryStat(PrimaryStat::Vitality, 50);
+    int32_t hpBefore = target->getRuntimeStats().currentHp;
+
+    std::vector<DamageEvent> hits;
+    eventBus->subscribe([&](const GameEvent& event) {
+        if (auto* damage = std::get_if<DamageEvent>(&event)) hits.push_back(*damage);
+    });
+
+    // Slash: 30 base (37 at level 2) + 1.0 x physical attack
+    CastResult result = combatSystem->handleSkillAttack({caster->getId(), target->getId(), 1, 2});
+    int32_t expected = 37 + caster->getDerivedStats().physicalAttack;
+    EXPECT_TRUE(result.resolved);
+    EXPECT_EQ(result.targets, 1u);
+    EXPECT_EQ(result.damage, expected);
+    EXPECT_EQ(target->getRuntimeStats().currentHp, hpBefore - expected);
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0].damage, expected);
+    EXPECT_TRUE(hits[0].isPhysical);
+
+    // Fireball scales magical attack by 1.2
+    result = combatSystem->handleSkillAttack({caster->getId(), target->getId(), 2, 1});
+    EXPECT_EQ(result.damage, 50 + static_cast<int32_t>(0.2f * caster->getDerivedStats().magicalAttack) +
+                                 caster->getDerivedStats().magicalAttack);
+}
+
+TEST_F(SkillEffectTest, ShieldedHitsReportOnlyWhatGetsThrough) {
+    auto caster = actorManager->createActor<Actor>("Caster");
+    auto target = actorManager->createActor<Actor>("Target");
+    target->setPrimaryStat(PrimaryStat::Vitality, 50);
+    int32_t hpBefore = target->getRuntimeStats().currentHp;
+    int32_t slash = 30 + caster->getDerivedStats().physicalAttack;
+
+    std::vector<DamageEvent> hits;
+    eventBus->subscribe([&](const GameEvent& event) {
+        if (auto* damage = std::get_if<DamageEvent>(&event)) hits.push_back(*damage);
+    });
+
+    // Fully absorbed: nothing dealt, nothing published
+    target->setShield({slash + 10, true, true, 0});
+    CastResult result = combatSystem->handleSkillAttack({caster->getId(), target->getId(), 1, 1});
+    EXPECT_EQ(result.damage, 0);
+    EXPECT_TRUE(hits.empty());
+    EXPECT_EQ(target->getRuntimeStats().currentHp, hpBefore);
+
+    // The last 10 points of shield soak part of the next hit
+    result = combatSystem->handleSkillAttack({caster->getId(), target->getId(), 1, 1});
+    EXPECT_EQ(result.damage, slash - 10);
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0].damage, slash - 10);
+    EXPECT_EQ(target->getRuntimeStats().currentHp, hpBefore - (slash - 10));
+
+    // Basic attacks report the same way
+    target->setShield({1000, true, true, 0});
+    DamageResult basic = combatSystem->handleBasicAttack({caster->getId(), target->getId(), true});
+    EXPECT_EQ(basic.finalDamage, 0);
+    EXPECT_EQ(hits.size(), 1u);
+}
+
+TEST_F(SkillEffectTest, SelfSkillsBuffAndShield) {
+    auto caster = actorManager->createActor<Actor>("Caster");
+    int32_t maxHp = caster->getDerivedStats().maxHp;
+
+    // Berserk: (10 + 20) * 1.5; casting again refreshes instead of stacking
+    combatSystem->handleSelfSkill({caster->getId(), 7, 1});
+    combatSystem->handleSelfSkill({caster->getId(), 7, 1});
+    EXPECT_EQ(caster->getStatModifiers().size(), 1u);
+    EXPECT_EQ(caster->getEffectivePrimaryStats().strength, 45);
+
+    combatSystem->handleSelfSkill({caster->getId(), 9, 1});
+    EXPECT_EQ(caster->getShield(), 200);
+    EXPECT_EQ(caster->takeDamage(150, false), 0);
+    EXPECT_EQ(caster->takeDamage(100, true), 50);
+    EXPECT_EQ(caster->getRuntimeStats().currentHp, maxHp - 50);
+
+    // A self skill aimed at someone else still lands on the caster
+    auto other = actorManager->createActor<Actor>("Other");
+    combatSystem->handleSkillAttack({caster->getId(), other->getId(), 9, 1});
+    EXPECT_EQ(other->getShield(), 0);
+    EXPECT_EQ(caster->getShield(), 200);
+}
+
+TEST_F(SkillEffectTest, HealsRestoreHpAtOnceAndOverTime) {
+    auto healer = actorManager->createActor<Actor>("Healer");
+    auto ally = actorManager->createActor<Actor>("Ally");
+    ally->setPrimaryStat(PrimaryStat::Vitality, 100);
+    ally->takeDamage(500);
+    int32_t hp = ally->getRuntimeStats().currentHp;
+
+    CastResult result = combatSystem->handleSkillAttack({healer->getId(), ally->getId(), 3, 1});
+    int32_t expected = 60 + static_cast<int32_t>(0.8f * healer->getDerivedStats().magicalAttack);
+    EXPECT_EQ(result.healing, expected);
+    EXPECT_EQ(ally->getRuntimeStats().currentHp, hp + expected);
+
+    // Regeneration: 20 HP every second
+    hp = ally->getRuntimeStats().currentHp;
+    combatSystem->handleSkillAttack({healer->getId(), ally->getId(), 6, 1});
+    EXPECT_EQ(actorManager->getComponents().effectCount(), 1u);
+    Tick second = TimingWheel::toTicks(1.0f, SkillDatabase::instance().getTickRate());
+    actorManager->updateAll(2 * second);
+    EXPECT_EQ(ally->getRuntimeStats().currentHp, hp + 40);
+
+    // A single-ally skill with no target heals the caster
+    healer->takeDamage(50);
+    result = combatSystem->handleSkillAttack({healer->getId(), INVALID_ACTOR_ID, 3, 1});
+    EXPECT_EQ(result.healing, 50);
+}
+
+TEST_F(SkillEffectTest, AreaSkillHitsActorsInRange) {
+    auto caster = actorManager->createActor<Actor>("Caster");
+    auto near = actorManager->createActor<Actor>("Near");
+    auto edge = actorManager->createActor<Actor>("Edge");
+    auto far = actorManager->createActor<Actor>("Far");
+    auto dead = actorManager->createActor<Actor>("Dead");
+    near->setPosition({3.0f, 0.0f});
+    edge->setPosition({-5.0f, 5.0f});
+    far->setPosition({20.0f, 0.0f});
+    dead->takeDamage(9999);
+    int32_t fullHp = far->getRuntimeStats().currentHp;
+
+    // Flame Wave reaches its range (8) from the center
+    CastResult result = combatSystem->handleAreaSkill({caster->getId(), 0.0f, 0.0f, 0.0f, 5, 1});
+    EXPECT_EQ(result.targets, 2u);
+    EXPECT_LT(near->getRuntimeStats().currentHp, fullHp);
+    EXPECT_LT(edge->getRuntimeStats().currentHp, fullHp);
+    EXPECT_EQ(far->getRuntimeStats().currentHp, fullHp);
+    EXPECT_EQ(caster->getRuntimeStats().currentHp, fullHp);  // Enemies only
+
+    // An explicit radius overrides the range
+    result = combatSystem->handleAreaSkill({caster->getId(), 20.0f, 0.0f, 1.0f, 5, 1});
+    EXPECT_EQ(result.targets, 1u);
+    EXPECT_LT(far->getRuntimeStats().currentHp, fullHp);
+}
+
+TEST_F(SkillEffectTest, QueuedCastsResolveAsOneBatch) {
+    auto first = actorManager->createActor<Actor>("First");
+    auto second = actorManager->createActor<Actor>("Second");
+    auto victim = actorManager->createActor<Actor>("Victim");
+    victim->takeDamage(victim->getDerivedStats().maxHp - 1);
+
+    // Subscribers run after the batch, so removing the dead is safe
+    std::vector<std::string> seen;
+    eventBus->subscribe([&](const GameEvent& event) {
+        seen.push_back(getEventTypeName(event));
+        if (auto* death = std::get_if<DeathEvent>(&event)) {
+            actorManager->removeActor(death->actor);
+        }
+    });
+
+    SkillExecutor& executor = combatSystem->getSkillExecutor();
+    SkillCast cast;
+    cast.caster = first->getId();
+    cast.skill = 1;
+    cast.target = victim->getId();
+    EXPECT_EQ(executor.queue(cast), 0u);
+    cast.caster = second->getId();
+    EXPECT_EQ(executor.queue(cast), 1u);
+    cast.skill = 999;
+    EXPECT_EQ(executor.queue(cast), 2u);
+    EXPECT_TRUE(seen.empty());
+
+    const std::vector<CastResult>& results = executor.execute();
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_GT(results[0].damage, 0);
+    EXPECT_TRUE(results[1].resolved);
+    EXPECT_EQ(results[1].damage, 0);  // Its target died earlier in the batch
+    EXPECT_FALSE(results[2].resolved);
+    EXPECT_EQ(executor.pendingCount(), 0u);
+    EXPECT_EQ(seen, (std::vector<std::string>{"SkillUsedEvent", "DamageEvent", "DeathEvent", "SkillUsedEvent"}));
+    EXPECT_FALSE(actorManager->hasActor(victim->getId()));
+}
+
+TEST_F(SkillEffectTest, DirectCastsLeaveTheQueueAlone) {
+    auto caster = actorManager->createActor<Actor>("Caster");
+    auto queuedTarget = actorManager->createActor<Actor>("QueuedTarget");
+    auto victim = actorManager->createActor<Actor>("Victim");
+    victim->takeDamage(victim->getDerivedStats().maxHp - 1);
+    int32_t fullHp = queuedTarget->getRuntimeStats().currentHp;
+
+    // Events go out as the direct cast lands; removing the dead is still safe
+    std::vector<std::string> seen;
+    eventBus->subscribe([&](const GameEvent& event) {
+        seen.push_back(getEventTypeName(event));
+        if (auto* death = std::get_if<DeathEvent>(&event)) {
+            actorManager->removeActor(death->actor);
+        }
+    });
+
+    SkillExecutor& executor = combatSystem->getSkillExecutor();
+    SkillCast queued;
+    queued.caster = caster->getId();
+    queued.skill = 1;
+    queued.target = queuedTarget->getId();
+    EXPECT_EQ(executor.queue(queued), 0u);
+
+    CastResult direct = combatSystem->handleSkillAttack({caster->getId(), victim->getId(), 1, 1});
+    EXPECT_TRUE(direct.resolved);
+    EXPECT_EQ(direct.damage, 1);
+    EXPECT_FALSE(actorManager->hasActor(victim->getId()));
+    EXPECT_EQ(seen, (std::vector<std::string>{"SkillUsedEvent", "DamageEvent", "DeathEvent"}));
+
+    // The queued cast is untouched until its own execute()
+    EXPECT_EQ(executor.pendingCount(), 1u);
+    EXPECT_EQ(queuedTarget->getRuntimeStats().currentHp, fullHp);
+    const std::vector<CastResult>& results = executor.execute();
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_GT(results[0].damage, 0);
+    EXPECT_EQ(queuedTarget->getRuntimeStats().currentHp, fullHp - results[0].damage);
+}
+
+// A three-effect area skill over a crowd: the compiled batch against
+// visiting each Skill's effect variants per target, found by predicate,
+// and against resolving each cast on its own
+TEST_F(SkillEffectTest, DISABLED_SkillEffectBenchmark) {
+    using Clock = std::chrono::steady_clock;
+    constexpr int ACTORS = 2000;
+    constexpr int CASTS = 50;
+    constexpr SkillId NOVA = 60;
+
+    SkillDatabase& db = SkillDatabase::instance();
+    db.registerSkill(Skill(NOVA, "Nova")
+                         .withTargetType(TargetType::AreaAll)
+                         .withRange(1000.0f)
+                         .withEffect(DamageEffect{20, 1.0f, false})
+                         .withEffect(HealEffect{10, 0.5f})
+                         .withEffect(ManaRestoreEffect{5, 0.1f}));
+    combatSystem->getSkillExecutor().setEffects(CompiledSkillEffects::compile(db));
+
+    std::vector<ActorPtr> crowd;
+    for (int i = 0; i < ACTORS; i++) {
+        auto actor = actorManager->createActor<Actor>("Actor" + std::to_string(i));
+        actor->setPrimaryStat(PrimaryStat::Vitality, 200);
+        actor->setPosition({static_cast<float>(i % 50), static_cast<float>(i / 50)});
+        crowd.push_back(actor);
+    }
+    Actor& caster = *crowd[0];
+    DamageCalculator& damage = combatSystem->getDamageCalculator();
+
+    int64_t visitDamage = 0;
+    auto start = Clock::now();
+    for (int cast = 0; cast < CASTS; cast++) {
+        const Skill* skill = db.getSkill(NOVA);
+        float scale = 1.0f + (1 + cast % 5 - 1) * 0.25f;
+        auto targets = actorManager->getActorsWhere([](const Actor& actor) {
+            Position position = actor.getPosition();
+            return actor.isAlive() && position.x * position.x + position.y * position.y <= 1000.0f * 1000.0f;
+        });
+        for (const ActorPtr& target : targets) {
+            for (const SkillEffect& effect : skill->getEffects()) {
+                std::visit([&](auto&& e) {
+                    using T = std::decay_t<decltype(e)>;
+                    const DerivedStats stats = caster.getDerivedStats();
+                    if constexpr (std::is_same_v<T, DamageEffect>) {
+                        int32_t attack = e.isPhysical ? stats.physicalAttack : stats.magicalAttack;
+                        int32_t bonus = static_cast<int32_t>(e.baseDamage * scale) +
+                                        static_cast<int32_t>((e.statScaling - 1.0f) * attack);
+                        DamageResult hit = damage.calculateSkillDamage(caster, *target, bonus, e.isPhysical);
+                        target->takeDamage(hit.finalDamage, e.isPhysical);
+                        visitDamage += hit.finalDamage;
+                        eventBus->publish(DamageEvent{caster.getId(), target->getId(), hit.finalDamage,
+                                                      hit.isCritical, hit.isPhysical});
+                    } else if constexpr (std::is_same_v<T, HealEffect>) {
+                        int32_t healed = target->heal(static_cast<int32_t>(e.baseHeal * scale) +
+                                                      static_cast<int32_t>(e.statScaling * stats.magicalAttack));
+                        eventBus->publish(HealEvent{caster.getId(), target->getId(), healed});
+                    } else if constexpr (std::is_same_v<T, ManaRestoreEffect>) {
+                        target->restoreMana(static_cast<int32_t>(e.amount * scale) +
+                                            static_cast<int32_t>(e.statScaling * caster.getEffectivePrimaryStats().wisdom));
+                    }
+                }, effect);
+            }
+        }
+    }
+    auto visitTime = Clock::now() - start;
+
+    for (const ActorPtr& actor : crowd) actor->heal(1000000);
+
+    int64_t compiledDamage = 0;
+    SkillExecutor& executor = combatSystem->getSkillExecutor();
+    start = Clock::now();
+    for (int cast = 0; cast < CASTS; cast++) {
+        SkillCast skillCast;
+        skillCast.caster = caster.getId();
+        skillCast.skill = NOVA;
+        skillCast.level = 1 + cast % 5;
+        executor.queue(skillCast);
+        compiledDamage += executor.execute()[0].damage;
+    }
+    auto compiledTime = Clock::now() - start;
+    EXPECT_EQ(compiledDamage, visitDamage);
+
+    // The same casts resolved directly, publishing as they go
+    for (const ActorPtr& actor : crowd) actor->heal(1000000);
+
+    int64_t resolvedDamage = 0;
+    start = Clock::now();
+    for (int cast = 0; cast < CASTS; cast++) {
+        SkillCast skillCast;
+        skillCast.caster = caster.getId();
+        skillCast.skill = NOVA;
+        skillCast.level = 1 + cast % 5;
+        resolvedDamage += executor.resolve(skillCast).damage;
+    }
+    auto resolvedTime = Clock::now() - start;
+    EXPECT_EQ(resolvedDamage, visitDamage);
+
+    auto perTarget = [](Clock::duration elapsed) {
+        return std::chrono::duration<double, std::nano>(elapsed).count() / (CASTS * ACTORS);
+    };
+    std::cout << "Skill effects per target (3 effects): visit " << perTarget(visitTime) << " ns, compiled batch "
+              << perTarget(compiledTime) << " ns, compiled resolve " << perTarget(resolvedTime) << " ns"
+              << std::endl;
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "core/EventBus.hpp"
 #include "core/Event.hpp"
+#include <chrono>
+#include <iostream>
 
 using namespace mmorpg;
 
@@ -139,3 +141,120 @@ TEST_F(EventBusTest, GetEventTypeName) {
     EXPECT_STREQ(getEventTypeName(heal), "HealEvent");
     EXPECT_STREQ(getEventTypeName(lvl), "LevelUpEvent");
 }
+
+TEST_F(EventBusTest, TypedSubscribersSeeOnlyTheirType) {
+    std::vector<int32_t> damage;
+    int deaths = 0;
+    int all = 0;
+
+    auto damageId = bus.subscribe<DamageEvent>([&damage](const DamageEvent& event) { damage.push_back(event.damage); });
+    bus.subscribe<DeathEvent>([&deaths](const DeathEvent&) { deaths++; });
+    bus.subscribe([&all](const GameEvent&) { all++; });
+    EXPECT_EQ(bus.getSubscriberCount(), 3);
+    EXPECT_EQ(bus.getSubscriberCount<DamageEvent>(), 1);
+    EXPECT_EQ(bus.getSubscriberCount<HealEvent>(), 0);
+
+    bus.publish(DamageEvent{1, 2, 100, false, true});
+    bus.publish(HealEvent{1, 2, 50});
+    bus.queue(DeathEvent{2, 1});
+    bus.queue(DamageEvent{1, 3, 7, true, false});
+    bus.processQueue();
+
+    EXPECT_EQ(damage, (std::vector<int32_t>{100, 7}));
+    EXPECT_EQ(deaths, 1);
+    EXPECT_EQ(all, 4);
+
+    bus.unsubscribe(damageId);
+    EXPECT_EQ(bus.getSubscriberCount<DamageEvent>(), 0);
+    bus.publish(DamageEvent{1, 2, 1, false, true});
+    EXPECT_EQ(damage.size(), 2u);
+}
+
+TEST_F(EventBusTest, TypedHandlersRunBeforeCatchAll) {
+    std::vector<std::string> order;
+    bus.subscribe([&order](const GameEvent&) { order.push_back("all"); });
+    bus.subscribe<DamageEvent>([&order](const DamageEvent&) { order.push_back("damage 1"); });
+    bus.subscribe<DamageEvent>([&order](const DamageEvent&) { order.push_back("damage 2"); });
+
+    bus.publish(DamageEvent{1, 2, 100, false, true});
+    EXPECT_EQ(order, (std::vector<std::string>{"damage 1", "damage 2", "all"}));
+}
+
+TEST_F(EventBusTest, UnsubscribeWhilePublishing) {
+    int first = 0;
+    int second = 0;
+    EventBus::HandlerId secondId = 0;
+
+    // A handler that publishes and then drops another handler
+    bus.subscribe<DeathEvent>([&](const DeathEvent&) {
+        first++;
+        bus.publish(HealEvent{1, 2, 5});
+        bus.unsubscribe(secondId);
+    });
+    secondId = bus.subscribe<DeathEvent>([&second](const DeathEvent&) { second++; });
+
+    bus.publish(DeathEvent{2, 1});
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(second, 0);
+    EXPECT_EQ(bus.getSubscriberCount<DeathEvent>(), 1);
+}
+
+// Many systems each listening for one event type: catch-all handlers
+// filtering with get_if against typed subscriptions
+TEST_F(EventBusTest, DISABLED_TypedDispatchBenchmark) {
+    using Clock = std::chrono::steady_clock;
+    constexpr int EVENTS = 200000;
+    constexpr int PER_TYPE = 8;
+    constexpr size_t TYPES = std::variant_size_v<GameEvent>;
+
+    int64_t filteredDamage = 0;
+    int64_t typedDamage = 0;
+    EventBus filtered;
+    EventBus typed;
+    for (int i = 0; i < PER_TYPE; i++) {
+        filtered.subscribe([&filteredDamage](const GameEvent& event) {
+            if (auto* damage = std::get_if<DamageEvent>(&event)) filteredDamage += damage->damage;
+        });
+        typed.subscribe<DamageEvent>([&typedDamage](const DamageEvent& event) { typedDamage += event.damage; });
+    }
+
+    // The same handlers with every other event type's listeners added
+    auto run = [](EventBus& bus) {
+        auto start = Clock::now();
+        for (int i = 0; i < EVENTS; i++) {
+            bus.publish(DamageEvent{1, 2, i & 15, false, true});
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / EVENTS;
+    };
+    double filteredAlone = run(filtered);
+    double typedAlone = run(typed);
+
+    int64_t others = 0;
+    auto addListeners = [&](auto* type) {
+        using Event = std::remove_pointer_t<decltype(type)>;
+        for (int i = 0; i < PER_TYPE; i++) {
+            filtered.subscribe([&others](const GameEvent& event) {
+                if (std::get_if<Event>(&event)) others++;
+            });
+            typed.subscribe<Event>([&others](const Event&) { others++; });
+        }
+    };
+    addListeners(static_cast<DeathEvent*>(nullptr));
+    addListeners(static_cast<HealEvent*>(nullptr));
+    addListeners(static_cast<SkillUsedEvent*>(nullptr));
+    addListeners(static_cast<LevelUpEvent*>(nullptr));
+    addListeners(static_cast<ManaUsedEvent*>(nullptr));
+    addListeners(static_cast<BuffAppliedEvent*>(nullptr));
+    addListeners(static_cast<BuffRemovedEvent*>(nullptr));
+    ASSERT_EQ(filtered.getSubscriberCount(), TYPES * PER_TYPE);
+    ASSERT_EQ(typed.getSubscriberCount(), TYPES * PER_TYPE);
+
+    double filteredCrowded = run(filtered);
+    double typedCrowded = run(typed);
+    EXPECT_EQ(typedDamage, filteredDamage);
+    EXPECT_EQ(others, 0);
+
+    std::cout << "Publish with " << PER_TYPE << " damage handlers: filtered " << filteredAlone << " ns, typed "
+              << typedAlone << " ns; with " << TYPES * PER_TYPE << " handlers in all: filtered "
+              << filteredCrowded << " ns, typed " << typedCrowded << " ns" << std::endl;
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "core/JobSystem.hpp"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace mmorpg;
+
+TEST(JobSystemTest, CoversTheRangeOnce) {
+    for (size_t workers : {0u, 1u, 3u}) {
+        JobSystem jobs(workers);
+        EXPECT_EQ(jobs.getThreadCount(), workers + 1);
+        for (size_t grain : {1u, 7u, 64u, 5000u}) {
+            std::vector<std::atomic<int>> hits(1000);
+            jobs.parallelFor(0, hits.size(), grain, [&](size_t begin, size_t end) {
+                if (workers > 0) {
+                    EXPECT_LE(end - begin, grain);
+                }
+                for (size_t i = begin; i < end; i++) hits[i]++;
+            });
+            for (size_t i = 0; i < hits.size(); i++) {
+                EXPECT_EQ(hits[i].load(), 1) << "workers " << workers << " grain " << grain << " index " << i;
+            }
+        }
+    }
+}
+
+TEST(JobSystemTest, EmptyAndOffsetRanges) {
+    JobSystem jobs(2);
+    int calls = 0;
+    jobs.parallelFor(5, 5, 1, [&](size_t, size_t) { calls++; });
+    EXPECT_EQ(calls, 0);
+
+    std::atomic<size_t> sum{0};
+    jobs.parallelFor(100, 200, 3, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) sum += i;
+    });
+    EXPECT_EQ(sum.load(), (100u + 199u) * 100u / 2);
+}
+
+TEST(JobSystemTest, ThreadNumbers) {
+    JobSystem jobs(3);
+    EXPECT_EQ(jobs.currentThread(), 0u);  // Not a worker
+
+    std::vector<std::atomic<int>> seen(jobs.getThreadCount());
+    jobs.parallelFor(0, 256, 1, [&](size_t, size_t) {
+        size_t thread = jobs.currentThread();
+        ASSERT_LT(thread, seen.size());
+        seen[thread]++;
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    });
+    int total = 0;
+    for (auto& count : seen) total += count;
+    EXPECT_EQ(total, 256);
+    EXPECT_GT(seen[0].load(), 0);  // The caller takes part
+
+    // Another pool's workers are thread 0 here
+    JobSystem other(0);
+    jobs.parallelFor(0, 64, 1, [&](size_t, size_t) { EXPECT_EQ(other.currentThread(), 0u); });
+}
+
+TEST(JobSystemTest, NestedRanges) {
+    JobSystem jobs(2);
+    std::vector<std::atomic<int>> hits(64 * 64);
+    jobs.parallelFor(0, 64, 4, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; row++) {
+            jobs.parallelFor(0, 64, 8, [&](size_t first, size_t last) {
+                for (size_t column = first; column < last; column++) hits[row * 64 + column]++;
+            });
+        }
+    });
+    for (auto& hit : hits) EXPECT_EQ(hit.load(), 1);
+}
+
+TEST(JobSystemTest, RepeatedPasses) {
+    // The tick loop: many short passes on one pool
+    JobSystem jobs(3);
+    std::vector<uint32_t> values(4096, 0);
+    for (int pass = 0; pass < 500; pass++) {
+        jobs.parallelFor(0, values.size(), 128, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) values[i]++;
+        });
+    }
+    for (uint32_t value : values) EXPECT_EQ(value, 500u);
+}
+
+// Uneven per-item cost, the way actor updates are; serial against the pool
+TEST(JobSystemBenchmark, DISABLED_UnevenWork) {
+    using Clock = std::chrono::steady_clock;
+    constexpr size_t ITEMS = 20000;
+    constexpr int PASSES = 10;
+
+    auto work = [](size_t i) {
+        double x = static_cast<double>(i);
+        size_t iterations = (i % 16 == 0) ? 2000 : 100;
+        for (size_t k = 0; k < iterations; k++) x = std::sqrt(x + k);
+        return x;
+    };
+
+    std::vector<double> serial(ITEMS);
+    auto start = Clock::now();
+    for (int pass = 0; pass < PASSES; pass++) {
+        for (size_t i = 0; i < ITEMS; i++) serial[i] = work(i);
+    }
+    auto serialTime = Clock::now() - start;
+
+    size_t workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    JobSystem jobs(workers);
+    std::vector<double> parallel(ITEMS);
+    start = Clock::now();
+    for (int pass = 0; pass < PASSES; pass++) {
+        jobs.parallelFor(0, ITEMS, 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) parallel[i] = work(i);
+        });
+    }
+    auto parallelTime = Clock::now() - start;
+
+    EXPECT_EQ(parallel, serial);
+
+    auto perPass = [](Clock::duration elapsed) {
+        return std::chrono::duration<double, std::micro>(elapsed).count() / PASSES;
+    };
+    std::cout << "Uneven work (" << ITEMS << " items): serial " << perPass(serialTime) << " us/pass, "
+              << jobs.getThreadCount() << " threads " << perPass(parallelTime) << " us/pass, "
+              << jobs.getStealCount() << " steals" << std::endl;
+}
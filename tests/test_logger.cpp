@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include "core/Logger.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace mmorpg;
+
+namespace {
+
+enum class Color : uint8_t { Red = 3 };
+
+int evaluations = 0;
+
+int countEvaluation() {
+    return ++evaluations;
+}
+
+} // namespace
+
+class LoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::FILE* file = std::tmpfile();
+        ASSERT_NE(file, nullptr);
+        capture = file;
+        Logger::instance().setOutput(fileno(capture));
+        Logger::instance().setLevel(LogLevel::Trace);
+    }
+
+    void TearDown() override {
+        Logger::instance().setOutput(-1);
+        Logger::instance().setLevel(LogLevel::Info);
+        std::fclose(capture);
+    }
+
+    // Everything written so far, one entry per line with the
+    // timestamp stripped ("LEVEL message")
+    std::vector<std::string> lines() {
+        Logger::instance().flush();
+        std::vector<std::string> result;
+        std::rewind(capture);
+        char buffer[512];
+        while (std::fgets(buffer, sizeof(buffer), capture)) {
+            std::string line(buffer);
+            if (!line.empty() && line.back() == '\n') line.pop_back();
+            // "YYYY-MM-DD HH:MM:SS.mmm " is 24 characters
+            result.push_back(line.size() > 24 ? line.substr(24) : line);
+        }
+        return result;
+    }
+
+    std::FILE* capture = nullptr;
+};
+
+TEST_F(LoggerTest, FormatsArguments) {
+    LOG_INFO("int " << -42 << " uint " << 7u << " big " << 18446744073709551615ull
+             << " enum " << Color::Red << " bool " << true << " char " << 'x'
+             << " float " << 2.5 << " str " << std::string("s"));
+
+    auto output = lines();
+    ASSERT_EQ(output.size(), 1u);
+    EXPECT_EQ(output[0], "INFO  int -42 uint 7 big 18446744073709551615 enum 3 bool true char x float 2.5 str s");
+}
+
+TEST_F(LoggerTest, TruncatesLongMessages) {
+    std::string longText(1000, 'a');
+    LOG_WARN(longText << "tail");
+
+    auto output = lines();
+    ASSERT_EQ(output.size(), 1u);
+    EXPECT_EQ(output[0], "WARN  " + std::string(LogRecord::MAX_MESSAGE, 'a'));
+}
+
+TEST_F(LoggerTest, RuntimeLevelFiltersWithoutEvaluating) {
+    Logger::instance().setLevel(LogLevel::Warn);
+    evaluations = 0;
+    LOG_INFO("hidden " << countEvaluation());
+    LOG_ERROR("shown " << countEvaluation());
+
+    auto output = lines();
+    ASSERT_EQ(output.size(), 1u);
+    EXPECT_EQ(output[0], "ERROR shown 1");
+    EXPECT_EQ(evaluations, 1);
+}
+
+TEST_F(LoggerTest, CompileTimeLevelRemovesTrace) {
+    // MMORPG_LOG_LEVEL defaults to DEBUG, so TRACE is compiled out even
+    // though the runtime level would allow it
+    evaluations = 0;
+    LOG_TRACE("trace " << countEvaluation());
+    LOG_DEBUG("debug " << countEvaluation());
+
+    auto output = lines();
+#if MMORPG_LOG_LEVEL <= 0
+    EXPECT_EQ(output.size(), 2u);
+#else
+    ASSERT_EQ(output.size(), 1u);
+    EXPECT_EQ(output[0], "DEBUG debug 1");
+    EXPECT_EQ(evaluations, 1);
+#endif
+}
+
+TEST_F(LoggerTest, KeepsPerThreadOrder) {
+    constexpr int THREADS = 4;
+    constexpr int RECORDS = 200;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < RECORDS; i++) {
+                LOG_INFO("t" << t << " " << i);
+                if (i % 50 == 0) std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    std::vector<int> next(THREADS, 0);
+    int total = 0;
+    for (const auto& line : lines()) {
+        int t = 0, i = 0;
+        ASSERT_EQ(std::sscanf(line.c_str(), "INFO  t%d %d", &t, &i), 2) << line;
+        EXPECT_EQ(i, next[t]++);
+        total++;
+    }
+    EXPECT_EQ(total, THREADS * RECORDS);
+    EXPECT_EQ(Logger::instance().getDroppedCount(), 0u);
+}
+
+TEST_F(LoggerTest, CountsAndReportsDrops) {
+    uint64_t before = Logger::instance().getDroppedCount();
+    // Far more than one ring holds; the writer can't keep up with this
+    for (size_t i = 0; i < 100 * Logger::RING_CAPACITY; i++) {
+        LOG_DEBUG("flood " << i);
+    }
+    uint64_t dropped = Logger::instance().getDroppedCount() - before;
+    EXPECT_GT(dropped, 0u);
+
+    auto output = lines();
+    size_t floods = 0;
+    uint64_t reported = 0;
+    for (const auto& line : output) {
+        uint64_t n = 0;
+        if (line.rfind("DEBUG flood ", 0) == 0) {
+            floods++;
+        } else if (std::sscanf(line.c_str(), "WARN  Logger dropped %lu records", &n) == 1) {
+            reported += n;
+        }
+    }
+    EXPECT_EQ(floods + dropped, 100 * Logger::RING_CAPACITY);
+    EXPECT_EQ(reported, dropped);
+}
+
+TEST_F(LoggerTest, ParseLevel) {
+    LogLevel level = LogLevel::Info;
+    EXPECT_TRUE(Logger::parseLevel("warn", level));
+    EXPECT_EQ(level, LogLevel::Warn);
+    EXPECT_TRUE(Logger::parseLevel("DEBUG", level));
+    EXPECT_EQ(level, LogLevel::Debug);
+    EXPECT_FALSE(Logger::parseLevel("verbose", level));
+    EXPECT_EQ(level, LogLevel::Debug);
+}
+
+TEST_F(LoggerTest, DISABLED_CallerCostBenchmark) {
+    constexpr int RECORDS = 512;  // Stays inside one ring: nothing dropped
+    std::string name = "player42";
+
+    Logger::instance().flush();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < RECORDS; i++) {
+        LOG_INFO(name << " learned Fireball! (" << i << ")");
+    }
+    auto logged = std::chrono::steady_clock::now() - start;
+
+    // The synchronous path this replaced, into the same file
+    std::ofstream sync("/dev/null");
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < RECORDS; i++) {
+        sync << name << " learned Fireball! (" << i << ")" << std::endl;
+    }
+    auto flushed = std::chrono::steady_clock::now() - start;
+
+    using std::chrono::nanoseconds;
+    std::cout << "Caller cost per record: "
+              << std::chrono::duration_cast<nanoseconds>(logged).count() / RECORDS << " ns async, "
+              << std::chrono::duration_cast<nanoseconds>(flushed).count() / RECORDS << " ns endl"
+              << std::endl;
+    EXPECT_EQ(lines().size(), static_cast<size_t>(RECORDS));
+}
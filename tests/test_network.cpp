@@ -1,8 +1,15 @@
 #include <gtest/gtest.h>
 #include "network/Socket.hpp"
 #include "network/Connection.hpp"
+#include "network/TcpServer.hpp"
+#include "network/Frame.hpp"
+#include "network/RecvBuffer.hpp"
 #include "proto/messages.pb.h"
 #include <boost/asio.hpp>
+#include <boost/endian/conversion.hpp>
+#include <chrono>
+#include <cstring>
+#include <thread>
 
 using namespace mmorpg;
 using namespace mmorpg::net;
@@ -11,8 +18,41 @@ namespace asio = boost::asio;
 class NetworkTest : public ::testing::Test {
 protected:
     asio::io_context io;
+
+    // Loopback pair: server-side socket wrapped in a Connection, raw client socket
+    std::pair<ConnectionPtr, tcp::socket> makeConnectedPair() {
+        tcp::acceptor acceptor(io, tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+        tcp::socket client(io);
+        client.connect(acceptor.local_endpoint());
+        tcp::socket accepted(io);
+        acceptor.accept(accepted);
+        return {std::make_shared<Connection>(Socket(std::move(accepted)), 1), std::move(client)};
+    }
 };
 
+// Length-prefixed Packet frame as sent by TestBot
+static std::string makeFrame(proto::MessageType type, const google::protobuf::Message& message) {
+    proto::Packet packet;
+    packet.set_type(static_cast<uint32_t>(type));
+    packet.set_payload(message.SerializeAsString());
+
+    std::string body = packet.SerializeAsString();
+    uint32_t len = boost::endian::native_to_big(static_cast<uint32_t>(body.size()));
+    std::string frame(reinterpret_cast<const char*>(&len), 4);
+    return frame + body;
+}
+
+// Poll the server until the predicate holds or the timeout expires
+template<typename Pred>
+static bool pollUntil(TcpServer& server, Pred pred, int timeoutMs = 2000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        server.poll(1);
+    }
+    return true;
+}
+
 TEST_F(NetworkTest, SocketCreation) {
     Socket socket(io);
     // Socket is created but not connected yet
@@ -108,3 +148,479 @@ TEST_F(NetworkTest, UUIDGeneration) {
     EXPECT_NE(uuid1, mmorpg::nilUUID());
     EXPECT_NE(uuid2, mmorpg::nilUUID());
 }
+
+TEST_F(NetworkTest, AsyncModeDispatchesOnArrival) {
+    TcpServer server(17801, IoMode::Async);
+    ASSERT_TRUE(server.start());
+    EXPECT_EQ(server.getIoMode(), IoMode::Async);
+
+    std::vector<uint64_t> timestamps;
+    server.onPacket([&](ConnectionPtr, const PacketView& packet) {
+        proto::Ping ping;
+        ASSERT_TRUE(ping.ParseFromArray(packet.data, static_cast<int>(packet.size)));
+        timestamps.push_back(ping.timestamp());
+    });
+
+    Socket client(io);
+    ASSERT_TRUE(client.connect("127.0.0.1", 17801));
+    ASSERT_TRUE(pollUntil(server, [&] { return server.getConnectionCount() == 1; }));
+
+    // Two frames in one write, the second split across two writes
+    proto::Ping ping;
+    ping.set_timestamp(1);
+    std::string burst = makeFrame(proto::MSG_PING, ping);
+    ping.set_timestamp(2);
+    std::string second = makeFrame(proto::MSG_PING, ping);
+    burst += second.substr(0, 3);
+    client.send(reinterpret_cast<const uint8_t*>(burst.data()), burst.size());
+
+    ASSERT_TRUE(pollUntil(server, [&] { return timestamps.size() == 1; }));
+    client.send(reinterpret_cast<const uint8_t*>(second.data() + 3), second.size() - 3);
+    ASSERT_TRUE(pollUntil(server, [&] { return timestamps.size() == 2; }));
+    EXPECT_EQ(timestamps[0], 1u);
+    EXPECT_EQ(timestamps[1], 2u);
+
+    // Peer close is noticed without polling the socket
+    bool disconnected = false;
+    server.onDisconnect([&](ConnectionPtr) { disconnected = true; });
+    client.close();
+    ASSERT_TRUE(pollUntil(server, [&] { return disconnected; }));
+    EXPECT_EQ(server.getConnectionCount(), 0);
+
+    server.stop();
+}
+
+TEST_F(NetworkTest, QueuedSendsAreGatheredInOrder) {
+    auto [conn, client] = makeConnectedPair();
+
+    proto::Pong pong;
+    for (uint64_t i = 1; i <= 3; i++) {
+        pong.set_timestamp(i);
+        EXPECT_TRUE(conn->sendPacket(proto::MSG_PONG, pong));
+    }
+    EXPECT_GT(conn->getQueuedBytes(), 0u);
+
+    // Sending only queued; completions drain on the io_context
+    io.run();
+    EXPECT_EQ(conn->getQueuedBytes(), 0u);
+    EXPECT_EQ(conn->getQueuedFrames(), 0u);
+
+    for (uint64_t i = 1; i <= 3; i++) {
+        uint32_t len;
+        asio::read(client, asio::buffer(&len, 4));
+        std::string body(boost::endian::big_to_native(len), '\0');
+        asio::read(client, asio::buffer(body));
+
+        proto::Packet packet;
+        ASSERT_TRUE(packet.ParseFromString(body));
+        ASSERT_TRUE(pong.ParseFromString(packet.payload()));
+        EXPECT_EQ(pong.timestamp(), i);
+    }
+}
+
+TEST_F(NetworkTest, SendQueueHighWaterMarkDisconnects) {
+    auto [conn, client] = makeConnectedPair();
+    conn->setSendHighWaterMark(256);
+
+    proto::Chat chat;
+    chat.set_message(std::string(100, 'x'));
+
+    // The io_context never runs, so frames pile up behind the first write
+    int accepted = 0;
+    while (conn->sendPacket(proto::MSG_CHAT, chat)) {
+        accepted++;
+        ASSERT_LT(accepted, 10);
+    }
+
+    EXPECT_GE(accepted, 1);
+    EXPECT_FALSE(conn->isConnected());
+    EXPECT_LE(conn->getQueuedBytes(), 256u);
+}
+
+TEST_F(NetworkTest, SendQueueOverflowCancelsPendingRead) {
+    auto [conn, client] = makeConnectedPair();
+    conn->setSendHighWaterMark(256);
+
+    // The read a single-threaded server waits on for this client
+    bool readDone = false;
+    boost::system::error_code readError;
+    conn->asyncRead([&](const boost::system::error_code& ec) {
+        readDone = true;
+        readError = ec;
+    });
+
+    proto::Chat chat;
+    chat.set_message(std::string(100, 'x'));
+    while (conn->sendPacket(proto::MSG_CHAT, chat)) {}
+
+    // Nothing else would ever complete it, so the overflow must
+    io.run_for(std::chrono::seconds(2));
+    EXPECT_TRUE(readDone);
+    EXPECT_EQ(readError, asio::error::operation_aborted);
+}
+
+TEST_F(NetworkTest, FrameEncodingMatchesEnvelope) {
+    proto::AttackResult result;
+    result.set_attacker_id(7);
+    result.set_target_id(9);
+    result.set_damage(123);
+    result.set_is_critical(true);
+
+    auto frame = Frame::encode(proto::MSG_ATTACK_RESULT, result);
+    std::string expected = makeFrame(proto::MSG_ATTACK_RESULT, result);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(frame->data()), frame->size()), expected);
+
+    // Empty message and raw Packet paths
+    proto::Logout empty;
+    auto emptyFrame = Frame::encode(proto::MSG_LOGOUT, empty);
+    expected = makeFrame(proto::MSG_LOGOUT, empty);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(emptyFrame->data()), emptyFrame->size()), expected);
+
+    proto::Packet packet;
+    packet.set_type(proto::MSG_ATTACK_RESULT);
+    packet.set_payload(result.SerializeAsString());
+    auto rawFrame = Frame::encode(packet);
+    EXPECT_EQ(rawFrame->size(), frame->size());
+    EXPECT_EQ(memcmp(rawFrame->data(), frame->data(), frame->size()), 0);
+}
+
+TEST_F(NetworkTest, SharedFrameQueuedWithoutCopy) {
+    auto [conn1, client1] = makeConnectedPair();
+    auto [conn2, client2] = makeConnectedPair();
+
+    proto::Chat chat;
+    chat.set_message("hello everyone");
+    auto frame = Frame::encode(proto::MSG_CHAT, chat);
+
+    EXPECT_TRUE(conn1->sendFrame(frame));
+    EXPECT_TRUE(conn2->sendFrame(frame));
+    EXPECT_EQ(frame.use_count(), 3);  // Both queues reference the same buffer
+    EXPECT_EQ(conn1->getQueuedBytes(), frame->size());
+
+    io.run();
+    EXPECT_EQ(frame.use_count(), 1);
+
+    for (auto* client : {&client1, &client2}) {
+        std::string received(frame->size(), '\0');
+        asio::read(*client, asio::buffer(received));
+        EXPECT_EQ(memcmp(received.data(), frame->data(), frame->size()), 0);
+    }
+}
+
+TEST_F(NetworkTest, RecvBufferCompactsOnlyPartialFrame) {
+    RecvBuffer buffer(16);
+
+    memcpy(buffer.writePtr(), "abcdefghijkl", 12);
+    buffer.commit(12);
+    buffer.consume(10);
+    EXPECT_EQ(buffer.readable(), 2u);
+    EXPECT_EQ(buffer.writable(), 4u);
+
+    // Not enough room at the tail: the 2 unread bytes move to the front
+    buffer.prepare(8);
+    EXPECT_EQ(buffer.capacity(), 16u);
+    EXPECT_EQ(buffer.writable(), 14u);
+    EXPECT_EQ(memcmp(buffer.readPtr(), "kl", 2), 0);
+
+    // A frame larger than the capacity grows the buffer
+    buffer.prepare(32);
+    EXPECT_GE(buffer.writable(), 32u);
+    EXPECT_EQ(memcmp(buffer.readPtr(), "kl", 2), 0);
+
+    buffer.consume(2);
+    EXPECT_EQ(buffer.readable(), 0u);
+}
+
+TEST_F(NetworkTest, BurstFramesParsedInPlace) {
+    auto [conn, client] = makeConnectedPair();
+
+    // 2000 pings back to back, far more than one receive buffer
+    constexpr uint64_t count = 2000;
+    std::string burst;
+    proto::Ping ping;
+    for (uint64_t i = 1; i <= count; i++) {
+        ping.set_timestamp(i);
+        burst += makeFrame(proto::MSG_PING, ping);
+    }
+
+    std::thread writer([&client, &burst] {
+        asio::write(client, asio::buffer(burst));
+    });
+
+    uint64_t expected = 1;
+    while (expected <= count) {
+        ASSERT_TRUE(conn->readFromSocket());
+        conn->consumeFrames([&](const PacketView& packet) {
+            EXPECT_EQ(packet.type, static_cast<uint32_t>(proto::MSG_PING));
+            ASSERT_TRUE(ping.ParseFromArray(packet.data, static_cast<int>(packet.size)));
+            EXPECT_EQ(ping.timestamp(), expected);
+            expected++;
+        });
+    }
+    writer.join();
+    EXPECT_TRUE(conn->isConnected());
+}
+
+TEST_F(NetworkTest, OversizedFrameDisconnects) {
+    auto [conn, client] = makeConnectedPair();
+
+    uint32_t len = boost::endian::native_to_big(uint32_t{64 * 1024 * 1024});
+    asio::write(client, asio::buffer(&len, 4));
+
+    ASSERT_TRUE(conn->readFromSocket());
+    size_t frames = conn->consumeFrames([](const PacketView&) {});
+    EXPECT_EQ(frames, 0u);
+    EXPECT_FALSE(conn->isConnected());
+}
+
+TEST_F(NetworkTest, TypedFrameRoundTrip) {
+    proto::SkillRequest req;
+    req.set_skill_id(4);
+    req.set_target_id(12);
+
+    auto frame = Frame::encode(proto::MSG_SKILL_REQUEST, req, FrameFormat::Typed);
+    ASSERT_EQ(frame->size(), Frame::HEADER_SIZE + Frame::TYPE_SIZE + req.ByteSizeLong());
+
+    uint32_t word;
+    memcpy(&word, frame->data(), 4);
+    word = boost::endian::big_to_native(word);
+    EXPECT_TRUE(word & Frame::TYPED_FRAME_FLAG);
+    EXPECT_EQ(word & ~Frame::TYPED_FRAME_FLAG, frame->size() - Frame::HEADER_SIZE);
+
+    PacketView view;
+    FrameView body{frame->data() + Frame::HEADER_SIZE, frame->size() - Frame::HEADER_SIZE};
+    ASSERT_TRUE(Frame::decode(FrameFormat::Typed, body, view));
+    EXPECT_EQ(view.type, static_cast<uint32_t>(proto::MSG_SKILL_REQUEST));
+
+    proto::SkillRequest parsed;
+    ASSERT_TRUE(parsed.ParseFromArray(view.data, static_cast<int>(view.size)));
+    EXPECT_EQ(parsed.skill_id(), 4u);
+    EXPECT_EQ(parsed.target_id(), 12u);
+}
+
+TEST_F(NetworkTest, EnvelopeDecodedWithoutCopy) {
+    proto::Chat chat;
+    chat.set_message("in place");
+    auto frame = Frame::encode(proto::MSG_CHAT, chat);
+
+    PacketView view;
+    FrameView body{frame->data() + Frame::HEADER_SIZE, frame->size() - Frame::HEADER_SIZE};
+    ASSERT_TRUE(Frame::decode(FrameFormat::Envelope, body, view));
+    EXPECT_EQ(view.type, static_cast<uint32_t>(proto::MSG_CHAT));
+
+    // Payload points into the frame itself
+    EXPECT_GE(view.data, body.data);
+    EXPECT_LE(view.data + view.size, body.data + body.size);
+
+    proto::Chat parsed;
+    ASSERT_TRUE(parsed.ParseFromArray(view.data, static_cast<int>(view.size)));
+    EXPECT_EQ(parsed.message(), "in place");
+
+    // Truncated envelope is rejected
+    body.size -= 2;
+    EXPECT_FALSE(Frame::decode(FrameFormat::Envelope, body, view));
+}
+
+TEST_F(NetworkTest, ServerRepliesInClientFrameFormat) {
+    TcpServer server(17802, IoMode::Async);
+    ASSERT_TRUE(server.start());
+
+    server.onPacket([](ConnectionPtr conn, const PacketView& packet) {
+        proto::Ping ping;
+        ASSERT_TRUE(ping.ParseFromArray(packet.data, static_cast<int>(packet.size)));
+        proto::Pong pong;
+        pong.set_timestamp(ping.timestamp());
+        conn->sendPacket(proto::MSG_PONG, pong);
+    });
+
+    Socket legacy(io);
+    Socket typed(io);
+    ASSERT_TRUE(legacy.connect("127.0.0.1", 17802));
+    ASSERT_TRUE(typed.connect("127.0.0.1", 17802));
+
+    proto::Ping ping;
+    ping.set_timestamp(10);
+    auto envelopeFrame = Frame::encode(proto::MSG_PING, ping, FrameFormat::Envelope);
+    legacy.send(envelopeFrame->data(), envelopeFrame->size());
+    ping.set_timestamp(20);
+    auto typedFrame = Frame::encode(proto::MSG_PING, ping, FrameFormat::Typed);
+    typed.send(typedFrame->data(), typedFrame->size());
+
+    auto readReply = [&](Socket& client, FrameFormat expectedFormat) -> uint64_t {
+        uint32_t word = 0;
+        while (!word) {
+            server.poll(1);
+            boost::system::error_code ec;
+            client.getAsioSocket().non_blocking(true);
+            size_t n = client.getAsioSocket().read_some(asio::buffer(&word, 4), ec);
+            if (ec || n == 0) word = 0;
+            EXPECT_TRUE(n == 0 || n == 4);
+        }
+        word = boost::endian::big_to_native(word);
+        bool isTyped = (word & Frame::TYPED_FRAME_FLAG) != 0;
+        EXPECT_EQ(isTyped, expectedFormat == FrameFormat::Typed);
+
+        std::string body(word & ~Frame::TYPED_FRAME_FLAG, '\0');
+        client.getAsioSocket().non_blocking(false);
+        asio::read(client.getAsioSocket(), asio::buffer(body));
+
+        PacketView view;
+        FrameView bodyView{reinterpret_cast<const uint8_t*>(body.data()), body.size()};
+        EXPECT_TRUE(Frame::decode(expectedFormat, bodyView, view));
+        EXPECT_EQ(view.type, static_cast<uint32_t>(proto::MSG_PONG));
+        proto::Pong pong;
+        EXPECT_TRUE(pong.ParseFromArray(view.data, static_cast<int>(view.size)));
+        return pong.timestamp();
+    };
+
+    EXPECT_EQ(readReply(legacy, FrameFormat::Envelope), 10u);
+    EXPECT_EQ(readReply(typed, FrameFormat::Typed), 20u);
+
+    server.stop();
+}
+
+TEST_F(NetworkTest, IoThreadsDecodeOffTheHandlerThread) {
+    TcpServer server(17803, IoMode::Async, 2);
+    ASSERT_TRUE(server.start());
+    EXPECT_EQ(server.getIoThreadCount(), 2u);
+
+    // Handlers run on the thread that polls, never on an I/O thread
+    auto simThread = std::this_thread::get_id();
+    bool wrongThread = false;
+    std::vector<Connection::ConnectionId> connected;
+    server.onConnect([&](ConnectionPtr conn) {
+        wrongThread |= std::this_thread::get_id() != simThread;
+        connected.push_back(conn->getId());
+    });
+    server.onPacket([&](ConnectionPtr conn, const PacketView& packet) {
+        wrongThread |= std::this_thread::get_id() != simThread;
+        proto::Ping ping;
+        ASSERT_TRUE(ping.ParseFromArray(packet.data, static_cast<int>(packet.size)));
+        proto::Pong pong;
+        pong.set_timestamp(ping.timestamp());
+        conn->sendPacket(proto::MSG_PONG, pong);
+    });
+
+    constexpr uint64_t CLIENTS = 8;
+    std::vector<std::unique_ptr<Socket>> clients;
+    for (uint64_t i = 0; i < CLIENTS; i++) {
+        clients.push_back(std::make_unique<Socket>(io));
+        ASSERT_TRUE(clients.back()->connect("127.0.0.1", 17803));
+    }
+    ASSERT_TRUE(pollUntil(server, [&] { return connected.size() == CLIENTS; }));
+    EXPECT_EQ(server.getConnectionCount(), CLIENTS);
+
+    for (uint64_t i = 0; i < CLIENTS; i++) {
+        proto::Ping ping;
+        ping.set_timestamp(100 + i);
+        auto frame = Frame::encode(proto::MSG_PING, ping);
+        clients[i]->send(frame->data(), frame->size());
+    }
+
+    // Each client gets its own Pong back, written by its I/O thread
+    for (uint64_t i = 0; i < CLIENTS; i++) {
+        auto& socket = clients[i]->getAsioSocket();
+        socket.non_blocking(true);
+        uint32_t len = 0;
+        boost::system::error_code ec;
+        ASSERT_TRUE(pollUntil(server, [&] {
+            return asio::read(socket, asio::buffer(&len, 4), ec) == 4;
+        }));
+        socket.non_blocking(false);
+
+        std::string body(boost::endian::big_to_native(len), '\0');
+        asio::read(socket, asio::buffer(body));
+        proto::Packet packet;
+        ASSERT_TRUE(packet.ParseFromString(body));
+        EXPECT_EQ(packet.type(), static_cast<uint32_t>(proto::MSG_PONG));
+        proto::Pong pong;
+        ASSERT_TRUE(pong.ParseFromString(packet.payload()));
+        EXPECT_EQ(pong.timestamp(), 100 + i);
+    }
+
+    // Disconnects are reported through the same queue
+    std::vector<Connection::ConnectionId> disconnected;
+    server.onDisconnect([&](ConnectionPtr conn) { disconnected.push_back(conn->getId()); });
+    clients[0]->close();
+    ASSERT_TRUE(pollUntil(server, [&] { return disconnected.size() == 1; }));
+    EXPECT_EQ(server.getConnectionCount(), CLIENTS - 1);
+
+    // Server-initiated disconnect goes through the owning I/O thread
+    auto target = connected[0] != disconnected[0] ? connected[0] : connected[1];
+    server.disconnect(target);
+    ASSERT_TRUE(pollUntil(server, [&] { return disconnected.size() == 2; }));
+    EXPECT_EQ(disconnected[1], target);
+
+    EXPECT_FALSE(wrongThread);
+    server.stop();
+}
+
+TEST_F(NetworkTest, IoThreadsCarryInlineAndLargePayloads) {
+    TcpServer server(17809, IoMode::Async, 1);
+    ASSERT_TRUE(server.start());
+
+    std::vector<std::string> received;
+    server.onPacket([&](ConnectionPtr, const PacketView& packet) {
+        proto::Chat chat;
+        ASSERT_TRUE(chat.ParseFromArray(packet.data, static_cast<int>(packet.size)));
+        received.push_back(chat.message());
+    });
+
+    Socket client(io);
+    ASSERT_TRUE(client.connect("127.0.0.1", 17809));
+
+    // Either side of the inline payload size
+    const std::vector<std::string> messages = {"hi", std::string(NetEvent::INLINE_PAYLOAD * 8, 'x')};
+    for (const std::string& message : messages) {
+        proto::Chat chat;
+        chat.set_message(message);
+        auto frame = Frame::encode(proto::MSG_CHAT, chat);
+        client.send(frame->data(), frame->size());
+    }
+    ASSERT_TRUE(pollUntil(server, [&] { return received.size() == messages.size(); }));
+    EXPECT_EQ(received, messages);
+    server.stop();
+}
+
+TEST_F(NetworkTest, CoalescingHoldsFramesUntilFlush) {
+    auto [conn, client] = makeConnectedPair();
+    conn->setCoalescing(true);
+
+    proto::Pong pong;
+    for (uint64_t i = 1; i <= 3; i++) {
+        pong.set_timestamp(i);
+        EXPECT_TRUE(conn->sendPacket(proto::MSG_PONG, pong));
+    }
+    io.poll();
+    EXPECT_EQ(conn->getWriteCount(), 0u);
+    EXPECT_EQ(conn->getQueuedFrames(), 3u);
+    EXPECT_EQ(client.available(), 0u);
+
+    // Urgent goes now and takes everything queued ahead of it, in order
+    pong.set_timestamp(4);
+    EXPECT_TRUE(conn->sendPacket(proto::MSG_PONG, pong, SendLane::Urgent));
+    pong.set_timestamp(5);
+    EXPECT_TRUE(conn->sendPacket(proto::MSG_PONG, pong));
+    io.restart();
+    io.run_one();
+    EXPECT_EQ(conn->getWriteCount(), 1u);
+    EXPECT_EQ(conn->getQueuedFrames(), 1u);
+
+    conn->flush();
+    io.restart();
+    io.run();
+    EXPECT_EQ(conn->getWriteCount(), 2u);
+    EXPECT_EQ(conn->getQueuedFrames(), 0u);
+
+    for (uint64_t i = 1; i <= 5; i++) {
+        uint32_t len;
+        asio::read(client, asio::buffer(&len, 4));
+        std::string body(boost::endian::big_to_native(len), '\0');
+        asio::read(client, asio::buffer(body));
+        proto::Packet packet;
+        ASSERT_TRUE(packet.ParseFromString(body));
+        proto::Pong received;
+        ASSERT_TRUE(received.ParseFromString(packet.payload()));
+        EXPECT_EQ(received.timestamp(), i);
+    }
+}
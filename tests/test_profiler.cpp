@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "core/Profiler.hpp"
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+
+using namespace mmorpg;
+namespace pt = boost::property_tree;
+
+class ProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Profiler::instance().clear();
+        Profiler::instance().setEnabled(true);
+        tracePath = std::filesystem::temp_directory_path() / "test_profiler_trace.json";
+    }
+
+    void TearDown() override {
+        Profiler::instance().setEnabled(true);
+        std::filesystem::remove(tracePath);
+    }
+
+    // Zones per name, read back from the written trace
+    std::map<std::string, int> readTrace(pt::ptree& tree) {
+        EXPECT_TRUE(Profiler::instance().writeChromeTrace(tracePath.string()));
+        pt::read_json(tracePath.string(), tree);
+        std::map<std::string, int> counts;
+        for (const auto& [key, event] : tree.get_child("traceEvents")) {
+            if (event.get<std::string>("ph") == "X") {
+                counts[event.get<std::string>("name")]++;
+            }
+        }
+        return counts;
+    }
+
+    std::filesystem::path tracePath;
+};
+
+#if MMORPG_PROFILER
+
+TEST_F(ProfilerTest, NestedZonesInTrace) {
+    {
+        PROFILE_ZONE("outer");
+        for (int i = 0; i < 3; i++) {
+            PROFILE_ZONE("inner");
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    pt::ptree tree;
+    auto counts = readTrace(tree);
+    EXPECT_EQ(counts["outer"], 1);
+    EXPECT_EQ(counts["inner"], 3);
+
+    // The outer zone spans every inner one
+    double outerStart = 0, outerDur = 0;
+    for (const auto& [key, event] : tree.get_child("traceEvents")) {
+        if (event.get<std::string>("name") == "outer") {
+            outerStart = event.get<double>("ts");
+            outerDur = event.get<double>("dur");
+        }
+    }
+    EXPECT_GE(outerDur, 300.0);
+    for (const auto& [key, event] : tree.get_child("traceEvents")) {
+        if (event.get<std::string>("name") == "inner") {
+            EXPECT_GE(event.get<double>("ts"), outerStart);
+            EXPECT_LE(event.get<double>("ts") + event.get<double>("dur"), outerStart + outerDur);
+        }
+    }
+}
+
+TEST_F(ProfilerTest, ThreadsGetTheirOwnTracks) {
+    std::thread worker([] {
+        Profiler::instance().setThreadName("worker \"1\"");
+        PROFILE_ZONE("work");
+    });
+    worker.join();
+    {
+        PROFILE_ZONE("main");
+    }
+
+    pt::ptree tree;
+    auto counts = readTrace(tree);
+    EXPECT_EQ(counts["work"], 1);
+    EXPECT_EQ(counts["main"], 1);
+
+    int workTid = -1, mainTid = -1, namedTid = -1;
+    for (const auto& [key, event] : tree.get_child("traceEvents")) {
+        auto name = event.get<std::string>("name");
+        if (name == "work") workTid = event.get<int>("tid");
+        if (name == "main") mainTid = event.get<int>("tid");
+        if (name == "thread_name" && event.get<std::string>("args.name") == "worker \"1\"") {
+            namedTid = event.get<int>("tid");
+        }
+    }
+    EXPECT_NE(workTid, mainTid);
+    EXPECT_EQ(namedTid, workTid);
+}
+
+TEST_F(ProfilerTest, RingKeepsNewestZones) {
+    for (size_t i = 0; i < Profiler::RING_CAPACITY + 100; i++) {
+        PROFILE_ZONE("spin");
+    }
+    EXPECT_EQ(Profiler::instance().getZoneCount(), Profiler::RING_CAPACITY);
+
+    // The dump also drops the oldest slot, which a recording thread
+    // could be overwriting while it is read
+    pt::ptree tree;
+    EXPECT_EQ(readTrace(tree)["spin"], static_cast<int>(Profiler::RING_CAPACITY) - 1);
+}
+
+TEST_F(ProfilerTest, DisabledRecordsNothing) {
+    Profiler::instance().setEnabled(false);
+    {
+        PROFILE_ZONE("hidden");
+    }
+    EXPECT_EQ(Profiler::instance().getZoneCount(), 0u);
+}
+
+TEST_F(ProfilerTest, DISABLED_ZoneOverheadBenchmark) {
+    constexpr int ZONES = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ZONES; i++) {
+        PROFILE_ZONE("overhead");
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Profiler zone cost: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / ZONES
+              << " ns" << std::endl;
+}
+
+#endif
+
+TEST_F(ProfilerTest, DumpRequestIsConsumedOnce) {
+    EXPECT_FALSE(Profiler::instance().takeDumpRequest());
+    Profiler::instance().requestDump();
+    EXPECT_TRUE(Profiler::instance().takeDumpRequest());
+    EXPECT_FALSE(Profiler::instance().takeDumpRequest());
+}
+
+TEST_F(ProfilerTest, UnwritablePathFails) {
+    EXPECT_FALSE(Profiler::instance().writeChromeTrace("/nonexistent/dir/trace.json"));
+}
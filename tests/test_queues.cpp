@@ -0,0 +1,282 @@
+#include <gtest/gtest.h>
+#include "core/SpscQueue.hpp"
+#include "core/MpscQueue.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace mmorpg;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Pin the calling thread so the latency benchmark really crosses cores
+void pinToCore(unsigned core) {
+#ifdef __linux__
+    unsigned cores = std::thread::hardware_concurrency();
+    if (cores < 2) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % cores, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)core;
+#endif
+}
+
+double nsPerOp(Clock::duration elapsed, size_t ops) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() /
+           static_cast<double>(ops);
+}
+
+// Roughly the size of a decoded command
+struct Payload {
+    uint32_t connection = 0;
+    uint32_t type = 0;
+    uint64_t arrival = 0;
+    uint64_t data[2] = {};
+};
+
+} // namespace
+
+TEST(SpscQueueTest, FifoOrder) {
+    SpscQueue<int> queue(8);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_EQ(queue.size(), 5u);
+
+    int value = -1;
+    for (int i = 0; i < 5; i++) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, BoundedCapacity) {
+    SpscQueue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);  // Rounded up to a power of two
+
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(8));
+
+    int value;
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_TRUE(queue.tryPush(8));  // Slot reused after wrap-around
+}
+
+TEST(SpscQueueTest, PopReleasesValue) {
+    SpscQueue<std::shared_ptr<int>> queue(4);
+    auto item = std::make_shared<int>(7);
+    queue.tryPush(item);
+    EXPECT_EQ(item.use_count(), 2);
+
+    std::shared_ptr<int> out;
+    ASSERT_TRUE(queue.tryPop(out));
+    out.reset();
+    EXPECT_EQ(item.use_count(), 1);
+}
+
+TEST(SpscQueueTest, CrossThreadTransfer) {
+    constexpr int COUNT = 200000;
+    SpscQueue<int> queue(1024);
+
+    std::thread producer([&] {
+        for (int i = 0; i < COUNT; i++) {
+            while (!queue.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    int value;
+    while (expected < COUNT) {
+        if (queue.tryPop(value)) {
+            ASSERT_EQ(value, expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+TEST(MpscQueueTest, FifoOrderAndFull) {
+    MpscQueue<int> queue(4);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int value;
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(MpscQueueTest, ManyProducersKeepPerProducerOrder) {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 50000;
+    MpscQueue<std::pair<int, int>> queue(1024);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < PER_PRODUCER; i++) {
+                while (!queue.tryPush({p, i})) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> next(PRODUCERS, 0);
+    int received = 0;
+    std::pair<int, int> item;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        if (queue.tryPop(item)) {
+            ASSERT_EQ(item.second, next[item.first]);
+            next[item.first]++;
+            received++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto& t : producers) {
+        t.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(QueueBenchmark, DISABLED_SpscThroughput) {
+    constexpr size_t COUNT = 2000000;
+    SpscQueue<Payload> queue(4096);
+
+    auto start = Clock::now();
+    std::thread producer([&] {
+        pinToCore(0);
+        Payload item;
+        for (size_t i = 0; i < COUNT; i++) {
+            item.arrival = i;
+            while (!queue.tryPush(item)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    pinToCore(1);
+    Payload item;
+    size_t received = 0;
+    uint64_t sum = 0;
+    while (received < COUNT) {
+        if (queue.tryPop(item)) {
+            sum += item.arrival;
+            received++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    auto elapsed = Clock::now() - start;
+
+    EXPECT_EQ(sum, COUNT * (COUNT - 1) / 2);
+    std::cout << "SPSC: " << nsPerOp(elapsed, COUNT) << " ns/item, "
+              << COUNT / std::chrono::duration<double>(elapsed).count() / 1e6
+              << " M items/s" << std::endl;
+}
+
+TEST(QueueBenchmark, DISABLED_MpscThroughput) {
+    constexpr size_t PRODUCERS = 4;
+    constexpr size_t PER_PRODUCER = 500000;
+    MpscQueue<Payload> queue(4096);
+
+    auto start = Clock::now();
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&queue, p] {
+            pinToCore(static_cast<unsigned>(p + 1));
+            Payload item;
+            item.connection = static_cast<uint32_t>(p);
+            for (size_t i = 0; i < PER_PRODUCER; i++) {
+                while (!queue.tryPush(item)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    pinToCore(0);
+    Payload item;
+    size_t received = 0;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        if (queue.tryPop(item)) {
+            received++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    auto elapsed = Clock::now() - start;
+
+    std::cout << "MPSC (" << PRODUCERS << " producers): "
+              << nsPerOp(elapsed, received) << " ns/item, "
+              << received / std::chrono::duration<double>(elapsed).count() / 1e6
+              << " M items/s" << std::endl;
+}
+
+// One-way handoff latency: ping-pong through two SPSC queues, half the
+// round trip
+TEST(QueueBenchmark, DISABLED_CrossCoreLatency) {
+    constexpr size_t ROUND_TRIPS = 100000;
+    SpscQueue<uint64_t> ping(64);
+    SpscQueue<uint64_t> pong(64);
+
+    std::thread echo([&] {
+        pinToCore(1);
+        uint64_t value;
+        for (size_t i = 0; i < ROUND_TRIPS; i++) {
+            while (!ping.tryPop(value)) {
+                std::this_thread::yield();
+            }
+            while (!pong.tryPush(value)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    pinToCore(0);
+    uint64_t value = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < ROUND_TRIPS; i++) {
+        while (!ping.tryPush(i)) {
+            std::this_thread::yield();
+        }
+        while (!pong.tryPop(value)) {
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(value, i);
+    }
+    auto elapsed = Clock::now() - start;
+    echo.join();
+
+    std::cout << "Cross-core one-way latency: " << nsPerOp(elapsed, ROUND_TRIPS) / 2
+              << " ns" << std::endl;
+}
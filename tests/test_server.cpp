@@ -1,9 +1,49 @@
 #include <gtest/gtest.h>
 #include "server/GameServer.hpp"
+#include <algorithm>
 #include <fstream>
 #include <filesystem>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
 
 using namespace mmorpg;
+using tcp = boost::asio::ip::tcp;
+
+// Global allocation counter for the packet allocation benchmark. Every
+// plain and array form of new/delete is replaced, so memory from any of
+// them is always released by the matching free().
+namespace {
+std::atomic<bool> countAllocations{false};
+std::atomic<size_t> allocationCount{0};
+
+void* countedAlloc(size_t size) noexcept {
+    if (countAllocations.load(std::memory_order_relaxed)) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return std::malloc(size ? size : 1);
+}
+}
+
+void* operator new(size_t size) {
+    if (void* p = countedAlloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
 
 class ServerTest : public ::testing::Test {
 protected:
@@ -43,11 +83,17 @@ TEST_F(ServerTest, DefaultConfig) {
 
     EXPECT_EQ(config.port, 7777);
     EXPECT_EQ(config.tickRate, 20);
+    EXPECT_EQ(config.overrunPolicy, OverrunPolicy::CatchUp);
+    EXPECT_EQ(config.maxCatchUpTicks, 5u);
+    EXPECT_EQ(config.commandQueueCapacity, 65536u);
     EXPECT_EQ(config.maxConnections, 100);
     EXPECT_EQ(config.timeoutMs, 30000);
+    EXPECT_TRUE(config.asyncIo);
+    EXPECT_EQ(config.packetArenaBytes, 256u * 1024u);
     EXPECT_EQ(config.startingLevel, 1);
     EXPECT_EQ(config.startingSkillPoints, 3);
     EXPECT_FLOAT_EQ(config.expMultiplier, 1.0f);
+    EXPECT_FLOAT_EQ(config.respawnSeconds, 10.0f);
 }
 
 TEST_F(ServerTest, LoadConfigFromFile) {
@@ -92,6 +138,118 @@ TEST_F(ServerTest, LoadConfigWithPartialData) {
     std::filesystem::remove(partialConfigPath);
 }
 
+TEST_F(ServerTest, LoadOverrunPolicy) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "overrun_config.json";
+    std::ofstream configFile(path);
+    configFile << R"({
+        "server": {
+            "overrun_policy": "skip",
+            "max_catch_up_ticks": 2
+        }
+    })";
+    configFile.close();
+
+    auto config = GameServer::Config::loadFromFile(path.string());
+    EXPECT_EQ(config.overrunPolicy, OverrunPolicy::Skip);
+    EXPECT_EQ(config.maxCatchUpTicks, 2u);
+
+    std::filesystem::remove(path);
+}
+
+TEST_F(ServerTest, TickDeadlinesDoNotDrift) {
+    using namespace std::chrono;
+    TickScheduler scheduler(3);
+    auto start = TickScheduler::Clock::time_point{};
+    scheduler.start(start);
+
+    // 1000 / 3 would lose 1 ms per tick; deadlines stay anchored to start
+    auto now = start;
+    for (int i = 0; i < 300; i++) {
+        now = scheduler.getDeadline();
+        scheduler.beginTick(now);
+        scheduler.endTick(now + milliseconds(10));
+    }
+    EXPECT_EQ(now - start, seconds(100));
+    EXPECT_EQ(scheduler.getStats().ticks, 300u);
+    EXPECT_EQ(scheduler.getStats().overruns, 0u);
+    EXPECT_EQ(scheduler.getStats().maxDuration, milliseconds(10));
+}
+
+TEST_F(ServerTest, TickOverrunCatchUp) {
+    using namespace std::chrono;
+    TickScheduler scheduler(20, OverrunPolicy::CatchUp, 5);
+    auto start = TickScheduler::Clock::time_point{};
+    scheduler.start(start);
+
+    // Tick 1 (due at 50 ms) takes 170 ms: deadlines 100, 150, 200 were missed
+    scheduler.beginTick(start + milliseconds(50));
+    scheduler.endTick(start + milliseconds(220));
+    EXPECT_EQ(scheduler.getStats().overruns, 1u);
+    EXPECT_EQ(scheduler.getStats().skippedTicks, 0u);
+    EXPECT_EQ(scheduler.getDeadline(), start + milliseconds(100));
+
+    // Missed ticks run back to back, lateness shrinking as they catch up
+    scheduler.beginTick(start + milliseconds(220));
+    EXPECT_EQ(scheduler.getStats().lastLateness, milliseconds(120));
+    scheduler.endTick(start + milliseconds(221));
+    scheduler.beginTick(start + milliseconds(221));
+    scheduler.endTick(start + milliseconds(222));
+    scheduler.beginTick(start + milliseconds(222));
+    scheduler.endTick(start + milliseconds(223));
+    EXPECT_EQ(scheduler.getDeadline(), start + milliseconds(250));
+    EXPECT_EQ(scheduler.getStats().maxLateness, milliseconds(120));
+
+    // A stall longer than the catch-up budget drops the excess
+    scheduler.beginTick(start + milliseconds(250));
+    scheduler.endTick(start + milliseconds(1000));
+    EXPECT_EQ(scheduler.getStats().skippedTicks, 10u);
+    EXPECT_EQ(scheduler.getDeadline(), start + milliseconds(800));
+}
+
+TEST_F(ServerTest, TickOverrunSkip) {
+    using namespace std::chrono;
+    TickScheduler scheduler(20, OverrunPolicy::Skip);
+    auto start = TickScheduler::Clock::time_point{};
+    scheduler.start(start);
+
+    scheduler.beginTick(start + milliseconds(50));
+    scheduler.endTick(start + milliseconds(220));
+    EXPECT_EQ(scheduler.getStats().overruns, 1u);
+    EXPECT_EQ(scheduler.getStats().skippedTicks, 3u);
+    EXPECT_EQ(scheduler.getDeadline(), start + milliseconds(250));
+
+    // Landing exactly on a deadline counts it as missed
+    scheduler.beginTick(start + milliseconds(250));
+    scheduler.endTick(start + milliseconds(300));
+    EXPECT_EQ(scheduler.getStats().overruns, 2u);
+    EXPECT_EQ(scheduler.getDeadline(), start + milliseconds(350));
+}
+
+TEST_F(ServerTest, TickRateHoldsThroughJitterAndStalls) {
+    using namespace std::chrono;
+    TickScheduler scheduler(20);
+    auto start = TickScheduler::Clock::time_point{};
+    scheduler.start(start);
+
+    // One simulated second: wakeups land 0-3 ms late and ticks take 5 ms,
+    // except tick 10, which stalls for 60 ms and is caught up after
+    auto now = start;
+    for (int i = 1; scheduler.getDeadline() <= start + seconds(1); i++) {
+        now = std::max(now, scheduler.getDeadline() + milliseconds(i % 4));
+        scheduler.beginTick(now);
+        now += milliseconds(i == 10 ? 60 : 5);
+        scheduler.endTick(now);
+    }
+
+    const auto& stats = scheduler.getStats();
+    EXPECT_EQ(stats.ticks, 20u);
+    EXPECT_EQ(stats.overruns, 1u);
+    EXPECT_EQ(stats.skippedTicks, 0u);
+    EXPECT_EQ(stats.maxDuration, milliseconds(60));
+    EXPECT_EQ(stats.maxLateness, milliseconds(12));  // Tick 11: due at 550 ms, run at 562
+    EXPECT_LT(now, start + seconds(1) + milliseconds(10));
+}
+
 TEST_F(ServerTest, ServerInitialization) {
     GameServer::Config config;
     config.port = 17777;  // Use non-standard port to avoid conflicts
@@ -131,3 +289,492 @@ TEST_F(ServerTest, EventBusAccess) {
 
     server.shutdown();
 }
+
+// Heap allocations and time per handled packet over loopback: read,
+// request parse, response build, frame encode and the gathered write.
+// Messages come from the per-tick arena, so what remains is mostly the
+// outgoing frames.
+struct PacketCost {
+    const char* name;
+    proto::MessageType type;
+    double allocations;
+    double ns;
+};
+
+static std::vector<PacketCost> packetCosts(uint16_t port, int ticks) {
+    GameServer::Config config;
+    config.port = port;
+
+    GameServer server(config);
+    EXPECT_TRUE(server.initialize());
+    auto& network = server.getNetwork();
+
+    asio::io_context io;
+    tcp::socket client(io);
+    client.connect(tcp::endpoint(asio::ip::address_v4::loopback(), config.port));
+
+    std::vector<char> sink(256 * 1024);
+    auto send = [&](const std::string& bytes) {
+        asio::write(client, asio::buffer(bytes));
+    };
+    // Poll until the server has dispatched `packets` packets, then drain replies
+    auto pump = [&](int packets) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (packets > 0 && std::chrono::steady_clock::now() < deadline) {
+            packets -= network.poll(0);
+        }
+        network.poll(0);
+        while (client.available() > 0) {
+            client.read_some(asio::buffer(sink));
+        }
+    };
+    auto frameBytes = [](proto::MessageType type, const google::protobuf::Message& message) {
+        auto frame = net::Frame::encode(type, message);
+        return std::string(reinterpret_cast<const char*>(frame->data()), frame->size());
+    };
+
+    proto::LoginRequest login;
+    login.set_username("bench");
+    send(frameBytes(proto::MSG_LOGIN_REQUEST, login));
+    pump(1);
+    server.tick();  // Commands execute at the start of a tick
+    EXPECT_EQ(server.getActorManager().getActorCount(), 1u);
+    if (server.getActorManager().getActorCount() != 1) return {};
+    ActorId self = server.getActorManager().getAllActors().front()->getId();
+
+    proto::LearnSkill learn;
+    learn.set_skill_id(1);
+    send(frameBytes(proto::MSG_LEARN_SKILL, learn));
+    pump(1);
+    server.tick();
+
+    proto::Ping ping;
+    ping.set_timestamp(123456789);
+    proto::AttackRequest attack;
+    attack.set_target_id(self);
+    proto::Chat chat;
+    chat.set_message("hi");
+    proto::SkillRequest skill;
+    skill.set_skill_id(1);
+
+    struct Case {
+        const char* name;
+        proto::MessageType type;
+        const google::protobuf::Message& message;
+    };
+    const Case cases[] = {
+        {"Ping", proto::MSG_PING, ping},
+        {"Attack", proto::MSG_ATTACK_REQUEST, attack},
+        {"Chat", proto::MSG_CHAT, chat},
+        {"SkillRequest", proto::MSG_SKILL_REQUEST, skill},
+    };
+
+    constexpr int PACKETS_PER_TICK = 50;
+    const int packets = ticks * PACKETS_PER_TICK;
+    std::vector<PacketCost> costs;
+
+    for (const auto& c : cases) {
+        // One tick's worth of frames, sent as a single write
+        std::string batch;
+        for (int i = 0; i < PACKETS_PER_TICK; i++) {
+            batch += frameBytes(c.type, c.message);
+        }
+
+        // Warm up arena blocks, queues and asio's handler memory
+        send(batch);
+        pump(PACKETS_PER_TICK);
+        server.tick();
+        pump(0);
+
+        allocationCount = 0;
+        countAllocations = true;
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < ticks; t++) {
+            send(batch);
+            pump(PACKETS_PER_TICK);
+            server.tick();
+            pump(0);  // Flush replies
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        countAllocations = false;
+
+        costs.push_back({c.name, c.type, static_cast<double>(allocationCount) / packets,
+                         std::chrono::duration<double, std::nano>(elapsed).count() / packets});
+    }
+
+    EXPECT_EQ(network.getConnectionCount(), 1u);
+    server.shutdown();
+    return costs;
+}
+
+TEST_F(ServerTest, PingAllocatesOnlyItsReply) {
+    std::vector<PacketCost> costs = packetCosts(17780, 5);
+    ASSERT_FALSE(costs.empty());
+    ASSERT_EQ(costs.front().type, proto::MSG_PING);
+
+    // A Ping round trip only allocates its Pong frame
+    EXPECT_LE(costs.front().allocations, 1.5);
+}
+
+TEST_F(ServerTest, DISABLED_PacketAllocationBenchmark) {
+    for (const PacketCost& cost : packetCosts(17780, 40)) {
+        std::cout << cost.name << ": " << cost.allocations << " allocations/packet, "
+                  << cost.ns << " ns/packet" << std::endl;
+    }
+}
+
+TEST_F(ServerTest, DecodeCommand) {
+    proto::SkillRequest skill;
+    skill.set_skill_id(4);
+    skill.set_target_id(9);
+    std::string payload = skill.SerializeAsString();
+
+    net::PacketView packet;
+    packet.type = proto::MSG_SKILL_REQUEST;
+    packet.data = reinterpret_cast<const uint8_t*>(payload.data());
+    packet.size = payload.size();
+
+    Intent intent;
+    ASSERT_TRUE(decodeCommand(packet, intent));
+    auto* cmd = std::get_if<SkillCommand>(&intent);
+    ASSERT_NE(cmd, nullptr);
+    EXPECT_EQ(cmd->skillId, 4u);
+    EXPECT_EQ(cmd->targetId, 9u);
+
+    packet.type = proto::MSG_LOGOUT;
+    ASSERT_TRUE(decodeCommand(packet, intent));
+    EXPECT_TRUE(std::holds_alternative<LogoutCommand>(intent));
+
+    // Unknown type and garbage payload
+    packet.type = 9999;
+    EXPECT_FALSE(decodeCommand(packet, intent));
+    const uint8_t garbage[] = {0xFF, 0xFF, 0xFF};
+    packet.type = proto::MSG_PING;
+    packet.data = garbage;
+    packet.size = sizeof(garbage);
+    EXPECT_FALSE(decodeCommand(packet, intent));
+}
+
+// Packets only queue commands; nothing runs until the next tick
+static void expectCommandsRunAtTick(uint16_t port, uint32_t ioThreads) {
+    GameServer::Config config;
+    config.port = port;
+    config.ioThreads = ioThreads;
+
+    GameServer server(config);
+    ASSERT_TRUE(server.initialize());
+    auto& network = server.getNetwork();
+
+    asio::io_context io;
+    tcp::socket client(io);
+    client.connect(tcp::endpoint(asio::ip::address_v4::loopback(), port));
+
+    proto::LoginRequest login;
+    login.set_username("queued");
+    proto::Ping ping;
+    ping.set_timestamp(42);
+    auto loginFrame = net::Frame::encode(proto::MSG_LOGIN_REQUEST, login);
+    auto pingFrame = net::Frame::encode(proto::MSG_PING, ping);
+    asio::write(client, asio::buffer(loginFrame->data(), loginFrame->size()));
+    asio::write(client, asio::buffer(pingFrame->data(), pingFrame->size()));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (server.getPendingCommands() < 2 && std::chrono::steady_clock::now() < deadline) {
+        network.poll(0);
+    }
+    ASSERT_EQ(server.getPendingCommands(), 2u);
+    EXPECT_EQ(server.getActorManager().getActorCount(), 0u);
+    EXPECT_EQ(client.available(), 0u);
+
+    server.tick();
+    EXPECT_EQ(server.getPendingCommands(), 0u);
+    EXPECT_EQ(server.getActorManager().getActorCount(), 1u);
+
+    // Replies arrive in command order; the Pong comes last
+    proto::Packet packet;
+    uint64_t pongTimestamp = 0;
+    while (pongTimestamp == 0 && std::chrono::steady_clock::now() < deadline) {
+        network.poll(0);
+        if (client.available() < 4) continue;
+
+        uint32_t len;
+        asio::read(client, asio::buffer(&len, 4));
+        std::string body(boost::endian::big_to_native(len), '\0');
+        asio::read(client, asio::buffer(body));
+        ASSERT_TRUE(packet.ParseFromString(body));
+        if (packet.type() == proto::MSG_PONG) {
+            proto::Pong pong;
+            ASSERT_TRUE(pong.ParseFromString(packet.payload()));
+            pongTimestamp = pong.timestamp();
+        }
+    }
+    EXPECT_EQ(pongTimestamp, 42u);
+
+    server.shutdown();
+}
+
+TEST_F(ServerTest, CommandsRunAtTickStart) {
+    expectCommandsRunAtTick(17781, 0);
+}
+
+TEST_F(ServerTest, CommandsRunAtTickStartWithIoThreads) {
+    expectCommandsRunAtTick(17782, 2);
+}
+
+// Enqueue/dequeue throughput of full Command values (variant plus
+// connection handle), single producer then drained like a tick
+TEST_F(ServerTest, DISABLED_CommandQueueThroughputBenchmark) {
+    constexpr size_t COMMANDS = 1 << 16;
+    CommandQueue queue(COMMANDS);
+
+    Command command;
+    command.intent = AttackCommand{7};
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < COMMANDS; i++) {
+        command.arrival = Command::Clock::now();
+        ASSERT_TRUE(queue.tryPush(command));
+    }
+    auto enqueued = std::chrono::steady_clock::now();
+
+    size_t drained = 0;
+    Command out;
+    while (queue.tryPop(out)) {
+        drained += std::holds_alternative<AttackCommand>(out.intent) ? 1 : 0;
+    }
+    auto end = std::chrono::steady_clock::now();
+    EXPECT_EQ(drained, COMMANDS);
+
+    auto ns = [](auto d) { return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count(); };
+    std::cout << "Command enqueue: " << ns(enqueued - start) / static_cast<double>(COMMANDS)
+              << " ns/op, dequeue: " << ns(end - enqueued) / static_cast<double>(COMMANDS)
+              << " ns/op" << std::endl;
+}
+
+// Gathered writes per client per tick with several busy players: each one
+// attacks, casts and chats every tick, and every client sees all of it
+static double writesPerClientTick(uint16_t port, uint32_t ioThreads, bool coalesce) {
+    constexpr int CLIENTS = 8;
+    constexpr int TICKS = 20;
+
+    GameServer::Config config;
+    config.port = port;
+    config.ioThreads = ioThreads;
+    config.coalesceWrites = coalesce;
+    GameServer server(config);
+    EXPECT_TRUE(server.initialize());
+    auto& network = server.getNetwork();
+
+    asio::io_context io;
+    std::vector<tcp::socket> clients;
+    std::vector<char> sink(256 * 1024);
+    auto pump = [&] {
+        network.poll(0);
+        for (auto& client : clients) {
+            while (client.available() > 0) {
+                client.read_some(asio::buffer(sink));
+            }
+        }
+    };
+    // Let I/O threads finish writing what the last tick produced
+    auto settle = [&] {
+        for (int i = 0; i < 20; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            pump();
+        }
+    };
+    auto send = [&](tcp::socket& client, proto::MessageType type,
+                    const google::protobuf::Message& message) {
+        auto frame = net::Frame::encode(type, message);
+        asio::write(client, asio::buffer(frame->data(), frame->size()));
+    };
+
+    for (int i = 0; i < CLIENTS; i++) {
+        clients.emplace_back(io);
+        clients.back().connect(tcp::endpoint(asio::ip::address_v4::loopback(), port));
+        proto::LoginRequest login;
+        login.set_username("player" + std::to_string(i));
+        send(clients.back(), proto::MSG_LOGIN_REQUEST, login);
+        proto::LearnSkill learn;
+        learn.set_skill_id(1);
+        send(clients.back(), proto::MSG_LEARN_SKILL, learn);
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (server.getPendingCommands() < 2 * CLIENTS && std::chrono::steady_clock::now() < deadline) {
+        network.poll(0);
+    }
+    server.tick();
+    settle();
+
+    auto totalWrites = [&] {
+        uint64_t writes = 0;
+        for (net::Connection::ConnectionId id = 1; id <= CLIENTS; id++) {
+            if (auto conn = network.getConnection(id)) {
+                writes += conn->getWriteCount();
+            }
+        }
+        return writes;
+    };
+    uint64_t before = totalWrites();
+
+    proto::AttackRequest attack;
+    attack.set_target_id(1);
+    proto::SkillRequest skill;
+    skill.set_skill_id(1);
+    proto::Chat chat;
+    chat.set_message("go");
+    for (int t = 0; t < TICKS; t++) {
+        for (auto& client : clients) {
+            send(client, proto::MSG_ATTACK_REQUEST, attack);
+            send(client, proto::MSG_SKILL_REQUEST, skill);
+            send(client, proto::MSG_CHAT, chat);
+        }
+        while (server.getPendingCommands() < 3 * CLIENTS && std::chrono::steady_clock::now() < deadline + std::chrono::seconds(5)) {
+            network.poll(0);
+        }
+        server.tick();
+        pump();
+    }
+
+    settle();
+    double perClientTick = static_cast<double>(totalWrites() - before) / (CLIENTS * TICKS);
+    server.shutdown();
+    return perClientTick;
+}
+
+TEST_F(ServerTest, CoalescingSendsOneWritePerClientTick) {
+    for (uint32_t ioThreads : {0u, 2u}) {
+        uint16_t port = static_cast<uint16_t>(17783 + 2 * ioThreads);
+        double uncoalesced = writesPerClientTick(port, ioThreads, false);
+        double coalesced = writesPerClientTick(port + 1, ioThreads, true);
+        EXPECT_LE(coalesced, 1.0);
+        EXPECT_GT(uncoalesced, coalesced);
+    }
+}
+
+TEST_F(ServerTest, ReplicatesChangedActors) {
+    GameServer::Config config;
+    config.port = 17787;
+
+    GameServer server(config);
+    ASSERT_TRUE(server.initialize());
+    auto& network = server.getNetwork();
+
+    asio::io_context io;
+    tcp::socket client(io);
+    client.connect(tcp::endpoint(asio::ip::address_v4::loopback(), config.port));
+
+    proto::LoginRequest login;
+    login.set_username("replicated");
+    auto loginFrame = net::Frame::encode(proto::MSG_LOGIN_REQUEST, login);
+    asio::write(client, asio::buffer(loginFrame->data(), loginFrame->size()));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (server.getPendingCommands() < 1 && std::chrono::steady_clock::now() < deadline) {
+        network.poll(0);
+    }
+    server.tick();
+    ASSERT_EQ(server.getActorManager().getActorCount(), 1u);
+
+    // Every ActorUpdate the client receives within the window
+    auto readUpdates = [&](std::chrono::milliseconds window) {
+        proto::Packet packet;
+        std::vector<proto::ActorUpdate> updates;
+        auto quiet = std::chrono::steady_clock::now() + window;
+        while (std::chrono::steady_clock::now() < quiet) {
+            network.poll(0);
+            if (client.available() < 4) continue;
+
+            uint32_t len;
+            asio::read(client, asio::buffer(&len, 4));
+            std::string body(boost::endian::big_to_native(len), '\0');
+            asio::read(client, asio::buffer(body));
+            if (packet.ParseFromString(body) && packet.type() == proto::MSG_ACTOR_UPDATE) {
+                updates.emplace_back().ParseFromString(packet.payload());
+            }
+        }
+        return updates;
+    };
+    readUpdates(std::chrono::milliseconds(100));  // Login replies
+
+    auto actor = server.getActorManager().getAllActors().front();
+    actor->takeDamage(7);
+    actor->setPosition({2.0f, 5.0f});
+    server.tick();
+    server.tick();  // Nothing changed: no second update
+
+    auto updates = readUpdates(std::chrono::milliseconds(200));
+
+    ASSERT_EQ(updates.size(), 1u);
+    EXPECT_EQ(updates[0].actor_id(), actor->getId());
+    EXPECT_EQ(updates[0].current_hp(), actor->getRuntimeStats().currentHp);
+    EXPECT_FLOAT_EQ(updates[0].pos_y(), 5.0f);
+
+    server.shutdown();
+}
+
+TEST_F(ServerTest, IdleConnectionsTimeOut) {
+    GameServer::Config config;
+    config.port = 17788;
+    config.timeoutMs = 150;  // Three ticks at 20 Hz
+
+    GameServer server(config);
+    ASSERT_TRUE(server.initialize());
+    auto& network = server.getNetwork();
+
+    asio::io_context io;
+    tcp::socket client(io);
+    client.connect(tcp::endpoint(asio::ip::address_v4::loopback(), config.port));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (network.getConnectionCount() < 1 && std::chrono::steady_clock::now() < deadline) {
+        network.poll(0);
+    }
+    ASSERT_EQ(network.getConnectionCount(), 1u);
+
+    // A ping pushes the deadline (tick 3) out by a tick
+    server.tick();
+    proto::Ping ping;
+    auto pingFrame = net::Frame::encode(proto::MSG_PING, ping);
+    asio::write(client, asio::buffer(pingFrame->data(), pingFrame->size()));
+    while (server.getPendingCommands() < 1 && std::chrono::steady_clock::now() < deadline) {
+        network.poll(0);
+    }
+    server.tick();
+    server.tick();
+    network.poll(0);
+    EXPECT_EQ(network.getConnectionCount(), 1u);
+
+    // Then silence
+    server.tick();
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (network.getConnectionCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+        network.poll(0);
+    }
+    EXPECT_EQ(network.getConnectionCount(), 0u);
+
+    server.shutdown();
+}
+
+TEST_F(ServerTest, DeadActorsRespawn) {
+    GameServer::Config config;
+    config.port = 17789;
+    config.respawnSeconds = 0.25f;  // Five ticks at 20 Hz
+
+    GameServer server(config);
+    ASSERT_TRUE(server.initialize());
+
+    auto actor = server.getActorManager().createActor<Actor>("Fallen");
+    actor->takeDamage(actor->getDerivedStats().maxHp);
+    server.getEventBus().publish(DeathEvent{actor->getId(), INVALID_ACTOR_ID});
+
+    for (int i = 0; i < 4; i++) {
+        server.tick();
+    }
+    EXPECT_FALSE(actor->isAlive());
+    server.tick();
+    EXPECT_TRUE(actor->isAlive());
+    EXPECT_EQ(actor->getRuntimeStats().currentHp, actor->getDerivedStats().maxHp);
+
+    server.shutdown();
+}
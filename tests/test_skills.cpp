@@ -1,8 +1,16 @@
 #include <gtest/gtest.h>
 #include "skills/Skill.hpp"
-#include "skills/SkillTree.hpp"
+#include "skills/CompiledSkillTree.hpp"
 #include "actors/Character.hpp"
 #include "actors/ActorManager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
 
 using namespace mmorpg;
 
@@ -87,6 +95,319 @@ TEST_F(SkillTest, SkillDatabaseGetCopy) {
     EXPECT_EQ(copy.getLevel(), 3);
 }
 
+TEST_F(SkillTest, LevelStatsMatchTheScaledSkill) {
+    const SkillDatabase& db = SkillDatabase::instance();
+    for (SkillId id : db.getAllSkillIds()) {
+        Skill skill = db.getSkillCopy(id);
+        for (int32_t level = 1; level <= skill.getMaxLevel(); level++) {
+            skill.setLevel(level);
+            const SkillLevelStats* stats = db.getLevelStats(id, level);
+            ASSERT_NE(stats, nullptr) << "skill " << id << " level " << level;
+            EXPECT_EQ(stats->manaCost, skill.getScaledManaCost());
+            EXPECT_FLOAT_EQ(stats->cooldown, skill.getScaledCooldown());
+            EXPECT_EQ(stats->cooldownTicks, TimingWheel::toTicks(skill.getScaledCooldown(), db.getTickRate()));
+            EXPECT_EQ(stats->damage, skill.getScaledDamage());
+            EXPECT_FLOAT_EQ(stats->effectScale, skill.getEffectScale());
+        }
+        // Levels past the max read the max level's row
+        EXPECT_EQ(db.getLevelStats(id, skill.getMaxLevel() + 3), db.getLevelStats(id, skill.getMaxLevel()));
+        EXPECT_EQ(db.getLevelStats(id, 0), nullptr);
+    }
+    EXPECT_EQ(db.getLevelStats(999, 1), nullptr);
+}
+
+TEST_F(SkillTest, TickRateRecomputesCooldownTicks) {
+    SkillDatabase& db = SkillDatabase::instance();
+    uint32_t rate = db.getTickRate();
+    db.setTickRate(10);
+    EXPECT_EQ(db.getLevelStats(1, 1)->cooldownTicks, 20u);  // Slash: 2 s
+    db.setTickRate(rate);
+    EXPECT_EQ(db.getLevelStats(1, 1)->cooldownTicks, TimingWheel::toTicks(2.0f, rate));
+}
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return ::testing::TempDir() + name;
+}
+
+void expectSameEffect(const EffectRecord& a, const EffectRecord& b) {
+    EXPECT_EQ(a.kind, b.kind);
+    EXPECT_EQ(a.stat, b.stat);
+    EXPECT_EQ(a.flags, b.flags);
+    EXPECT_EQ(a.amount, b.amount);
+    EXPECT_FLOAT_EQ(a.scaling, b.scaling);
+    EXPECT_FLOAT_EQ(a.duration, b.duration);
+    EXPECT_FLOAT_EQ(a.interval, b.interval);
+}
+
+// Everything the database hands out, as plain values
+struct Contents {
+    std::vector<Skill> skills;
+    std::vector<SkillLevelStats> levels;
+    std::vector<SkillNode> nodes;
+
+    static Contents of(const SkillDatabase& db) {
+        Contents contents;
+        for (SkillId id : db.getAllSkillIds()) {
+            contents.skills.push_back(db.getSkillCopy(id));
+            for (int32_t level = 1; level <= db.getRecord(id)->maxLevel; level++) {
+                contents.levels.push_back(*db.getLevelStats(id, level));
+            }
+        }
+        SkillTree tree = db.buildTree();
+        for (SkillId id : tree.getAllSkillIds()) contents.nodes.push_back(*tree.getNode(id));
+        std::sort(contents.nodes.begin(), contents.nodes.end(),
+                  [](const SkillNode& a, const SkillNode& b) { return a.skillId < b.skillId; });
+        return contents;
+    }
+};
+
+void expectSameContents(const Contents& a, const Contents& b) {
+    ASSERT_EQ(a.skills.size(), b.skills.size());
+    for (size_t i = 0; i < a.skills.size(); i++) {
+        const Skill& x = a.skills[i];
+        const Skill& y = b.skills[i];
+        EXPECT_EQ(x.getId(), y.getId());
+        EXPECT_EQ(x.getName(), y.getName());
+        EXPECT_EQ(x.getDescription(), y.getDescription());
+        EXPECT_EQ(x.getType(), y.getType());
+        EXPECT_EQ(x.getTargetType(), y.getTargetType());
+        EXPECT_EQ(x.getManaCost(), y.getManaCost());
+        EXPECT_FLOAT_EQ(x.getCooldown(), y.getCooldown());
+        EXPECT_FLOAT_EQ(x.getRange(), y.getRange());
+        EXPECT_EQ(x.getMaxLevel(), y.getMaxLevel());
+        EXPECT_EQ(x.getRequirement().prerequisiteSkill, y.getRequirement().prerequisiteSkill);
+        EXPECT_EQ(x.getRequirement().prerequisiteLevel, y.getRequirement().prerequisiteLevel);
+        EXPECT_EQ(x.getRequirement().requiredCharLevel, y.getRequirement().requiredCharLevel);
+        ASSERT_EQ(x.getEffects().size(), y.getEffects().size()) << "skill " << x.getId();
+        for (size_t e = 0; e < x.getEffects().size(); e++) {
+            expectSameEffect(toEffectRecord(x.getEffects()[e]), toEffectRecord(y.getEffects()[e]));
+        }
+    }
+    ASSERT_EQ(a.levels.size(), b.levels.size());
+    for (size_t i = 0; i < a.levels.size(); i++) {
+        EXPECT_EQ(a.levels[i].manaCost, b.levels[i].manaCost);
+        EXPECT_FLOAT_EQ(a.levels[i].cooldown, b.levels[i].cooldown);
+        EXPECT_EQ(a.levels[i].cooldownTicks, b.levels[i].cooldownTicks);
+        EXPECT_EQ(a.levels[i].damage, b.levels[i].damage);
+        EXPECT_FLOAT_EQ(a.levels[i].effectScale, b.levels[i].effectScale);
+    }
+    ASSERT_EQ(a.nodes.size(), b.nodes.size());
+    for (size_t i = 0; i < a.nodes.size(); i++) {
+        EXPECT_EQ(a.nodes[i].skillId, b.nodes[i].skillId);
+        EXPECT_EQ(a.nodes[i].tier, b.nodes[i].tier);
+        EXPECT_EQ(a.nodes[i].prerequisites, b.nodes[i].prerequisites);
+        EXPECT_EQ(a.nodes[i].unlocks, b.nodes[i].unlocks);
+        EXPECT_FLOAT_EQ(a.nodes[i].uiX, b.nodes[i].uiX);
+        EXPECT_FLOAT_EQ(a.nodes[i].uiY, b.nodes[i].uiY);
+    }
+}
+
+} // namespace
+
+TEST_F(SkillTest, DataFileMatchesDefaults) {
+    SkillDatabase& db = SkillDatabase::instance();
+    Contents defaults = Contents::of(db);
+    ASSERT_EQ(defaults.skills.size(), 9u);
+    ASSERT_EQ(defaults.nodes.size(), 9u);
+
+    ASSERT_TRUE(db.loadDefinitions(MMORPG_DATA_DIR "/skills.json"));
+    expectSameContents(Contents::of(db), defaults);
+}
+
+TEST_F(SkillTest, InvalidDataFileKeepsContents) {
+    SkillDatabase& db = SkillDatabase::instance();
+    std::string path = tempPath("bad_skills.json");
+    {
+        std::ofstream out(path);
+        out << R"({"skills": [{"id": 40, "name": "Zap", "effects": [{"type": "lightning"}]}]})";
+    }
+    EXPECT_FALSE(db.loadDefinitions(path));
+    EXPECT_FALSE(db.loadDefinitions(tempPath("missing_skills.json")));
+
+    // Learned levels are stored in a byte
+    for (int maxLevel : {0, SkillDatabase::MAX_SKILL_LEVEL + 1}) {
+        std::ofstream out(path, std::ios::trunc);
+        out << R"({"skills": [{"id": 40, "name": "Zap", "max_level": )" << maxLevel << "}]}";
+        out.close();
+        EXPECT_FALSE(db.loadDefinitions(path));
+    }
+    EXPECT_EQ(db.getSkillCount(), 9u);
+    EXPECT_FALSE(db.hasSkill(40));
+    std::remove(path.c_str());
+}
+
+TEST_F(SkillTest, SnapshotRoundTrip) {
+    SkillDatabase& db = SkillDatabase::instance();
+    Contents defaults = Contents::of(db);
+    std::string path = tempPath("skills_round_trip.bin");
+    ASSERT_TRUE(db.saveSnapshot(path));
+
+    db.clear();
+    ASSERT_TRUE(db.loadSnapshot(path));
+    EXPECT_TRUE(db.isMapped());
+    EXPECT_EQ(db.getName(2), "Fireball");
+    EXPECT_EQ(db.getRecord(2)->effectCount, 1u);
+    expectSameContents(Contents::of(db), defaults);
+    std::remove(path.c_str());
+}
+
+TEST_F(SkillTest, SnapshotRejectsDamagedFiles) {
+    SkillDatabase& db = SkillDatabase::instance();
+    std::string path = tempPath("skills_damaged.bin");
+    ASSERT_TRUE(db.saveSnapshot(path));
+    std::string image;
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::ostringstream bytes;
+        bytes << in.rdbuf();
+        image = bytes.str();
+    }
+
+    auto write = [&](const std::string& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << bytes;
+    };
+
+    write(image.substr(0, image.size() / 2));
+    EXPECT_FALSE(db.loadSnapshot(path));
+
+    std::string otherVersion = image;
+    uint32_t version = SkillSnapshotHeader::VERSION + 1;
+    std::memcpy(&otherVersion[offsetof(SkillSnapshotHeader, version)], &version, sizeof(version));
+    write(otherVersion);
+    EXPECT_FALSE(db.loadSnapshot(path));
+
+    write("{\"skills\": []}");
+    EXPECT_FALSE(db.loadSnapshot(path));
+
+    SkillSnapshotHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    std::string tooManyLevels = image;
+    int32_t maxLevel = SkillDatabase::MAX_SKILL_LEVEL + 1;
+    std::memcpy(&tooManyLevels[header.recordsOffset + sizeof(SkillRecord) + offsetof(SkillRecord, maxLevel)],
+                &maxLevel, sizeof(maxLevel));  // Skill 1
+    write(tooManyLevels);
+    EXPECT_FALSE(db.loadSnapshot(path));
+
+    // Enum fields out of range, in skill 1 and its first effect
+    auto corrupt = [&](uint64_t offset, uint8_t value) {
+        std::string bytes = image;
+        bytes[offset] = static_cast<char>(value);
+        write(bytes);
+        return db.loadSnapshot(path);
+    };
+    uint64_t skill1 = header.recordsOffset + sizeof(SkillRecord);
+    SkillRecord record;
+    std::memcpy(&record, &image[skill1], sizeof(record));
+    uint64_t effect = header.effectsOffset + record.firstEffect * sizeof(EffectRecord);
+    EXPECT_FALSE(corrupt(skill1 + offsetof(SkillRecord, type), 3));
+    EXPECT_FALSE(corrupt(skill1 + offsetof(SkillRecord, targetType), 6));
+    EXPECT_FALSE(corrupt(effect + offsetof(EffectRecord, stat), static_cast<uint8_t>(PRIMARY_STAT_COUNT)));
+    EXPECT_FALSE(corrupt(effect + offsetof(EffectRecord, flags), 0x80));
+
+    // Left as it was
+    EXPECT_FALSE(db.isMapped());
+    EXPECT_EQ(db.getSkillCount(), 9u);
+
+    write(image);
+    EXPECT_TRUE(db.loadSnapshot(path));
+    std::remove(path.c_str());
+}
+
+TEST_F(SkillTest, SnapshotChangesCopyTheTables) {
+    SkillDatabase& db = SkillDatabase::instance();
+    uint32_t rate = db.getTickRate();
+    std::string path = tempPath("skills_detach.bin");
+    ASSERT_TRUE(db.saveSnapshot(path));
+
+    // Written at another tick rate: cooldown ticks are recomputed
+    db.setTickRate(10);
+    ASSERT_TRUE(db.loadSnapshot(path));
+    EXPECT_FALSE(db.isMapped());
+    EXPECT_EQ(db.getLevelStats(1, 1)->cooldownTicks, 20u);  // Slash: 2 s
+    db.setTickRate(rate);
+
+    ASSERT_TRUE(db.loadSnapshot(path));
+    EXPECT_TRUE(db.isMapped());
+    db.registerSkill(Skill(50, "Kick").withEffect(DamageEffect{5, 0.5f, true}));
+    EXPECT_FALSE(db.isMapped());
+    EXPECT_EQ(db.getName(50), "Kick");
+    EXPECT_EQ(db.getName(9), "Divine Shield");
+    EXPECT_EQ(db.getSkillCount(), 10u);
+    std::remove(path.c_str());
+}
+
+// Startup cost for a large skill set: parsing JSON vs mapping a snapshot
+TEST_F(SkillTest, DISABLED_SkillDataLoadBenchmark) {
+    using Clock = std::chrono::steady_clock;
+    constexpr int SKILLS = 2000;
+    SkillDatabase& db = SkillDatabase::instance();
+
+    std::string json = tempPath("skills_bench.json");
+    std::string bin = tempPath("skills_bench.bin");
+    {
+        std::ofstream out(json);
+        out << "{\"skills\": [";
+        for (int id = 1; id <= SKILLS; id++) {
+            out << (id > 1 ? "," : "") << "{\"id\": " << id << ", \"name\": \"Skill " << id
+                << "\", \"description\": \"Generated skill\", \"mana_cost\": " << id % 50
+                << ", \"cooldown\": " << 1 + id % 10 << ", \"effects\": [{\"type\": \"damage\", \"base_damage\": "
+                << id % 200 << "}, {\"type\": \"dot\", \"damage_per_tick\": 5}]}";
+        }
+        out << "]}";
+    }
+
+    auto start = Clock::now();
+    ASSERT_TRUE(db.loadDefinitions(json));
+    auto jsonTime = Clock::now() - start;
+    ASSERT_TRUE(db.saveSnapshot(bin));
+
+    start = Clock::now();
+    ASSERT_TRUE(db.loadSnapshot(bin));
+    auto snapshotTime = Clock::now() - start;
+    EXPECT_EQ(db.getSkillCount(), static_cast<size_t>(SKILLS));
+    EXPECT_EQ(db.getLevelStats(SKILLS, 1)->damage, SKILLS % 200);
+
+    auto ms = [](Clock::duration elapsed) { return std::chrono::duration<double, std::milli>(elapsed).count(); };
+    std::cout << "Loading " << SKILLS << " skills: JSON " << ms(jsonTime) << " ms, snapshot "
+              << ms(snapshotTime) << " ms" << std::endl;
+    std::remove(json.c_str());
+    std::remove(bin.c_str());
+}
+
+// A spammed cast: reading the level row vs scaling a Skill copy
+TEST_F(SkillTest, DISABLED_LevelStatsBenchmark) {
+    using Clock = std::chrono::steady_clock;
+    constexpr int CASTS = 200000;
+    const SkillDatabase& db = SkillDatabase::instance();
+
+    int64_t copySum = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < CASTS; i++) {
+        Skill skill = db.getSkillCopy(2);
+        skill.setLevel(1 + i % 5);
+        copySum += skill.getScaledManaCost() + TimingWheel::toTicks(skill.getScaledCooldown(), 20);
+    }
+    auto copyTime = Clock::now() - start;
+
+    int64_t tableSum = 0;
+    start = Clock::now();
+    for (int i = 0; i < CASTS; i++) {
+        const SkillLevelStats* stats = db.getLevelStats(2, 1 + i % 5);
+        tableSum += stats->manaCost + stats->cooldownTicks;
+    }
+    auto tableTime = Clock::now() - start;
+    EXPECT_EQ(tableSum, copySum);
+
+    auto perCast = [](Clock::duration elapsed) {
+        return std::chrono::duration<double, std::nano>(elapsed).count() / CASTS;
+    };
+    std::cout << "Skill cast costs: Skill copy " << perCast(copyTime) << " ns, level table "
+              << perCast(tableTime) << " ns" << std::endl;
+}
+
 class SkillTreeTest : public ::testing::Test {
 protected:
     SkillTree tree;
@@ -173,7 +494,7 @@ protected:
 
 TEST_F(CharacterSkillTest, CharacterLearnSkill) {
     auto character = manager.createActor<Character>("Hero");
-    character->setSkillTree(tree);
+    character->setSkillTree(CompiledSkillTree::compile(tree));
 
     bool learned = character->learnSkill(1);
 
@@ -184,7 +505,7 @@ TEST_F(CharacterSkillTest, CharacterLearnSkill) {
 
 TEST_F(CharacterSkillTest, CharacterUpgradeSkill) {
     auto character = manager.createActor<Character>("Hero");
-    character->setSkillTree(tree);
+    character->setSkillTree(CompiledSkillTree::compile(tree));
     character->learnSkill(1);
 
     bool upgraded = character->upgradeSkill(1);
@@ -195,7 +516,7 @@ TEST_F(CharacterSkillTest, CharacterUpgradeSkill) {
 
 TEST_F(CharacterSkillTest, CannotLearnWithoutSkillPoints) {
     auto character = manager.createActor<Character>("Hero");
-    character->setSkillTree(tree);
+    character->setSkillTree(CompiledSkillTree::compile(tree));
 
     // Use all skill points
     character->learnSkill(1);
@@ -217,3 +538,216 @@ TEST_F(CharacterSkillTest, LevelUpGrantsSkillPoints) {
 
     EXPECT_GT(character->getSkillPoints(), initialPoints);
 }
+
+TEST_F(CharacterSkillTest, CooldownEndsOnTheManagerClock) {
+    auto character = manager.createActor<Character>("Hero");
+    character->setSkillTree(CompiledSkillTree::compile(tree));
+    character->learnSkill(1);
+
+    ASSERT_TRUE(character->useSkill(1));
+    EXPECT_FALSE(character->useSkill(1));
+
+    // Cooldowns are game ticks at the wheel's rate, not milliseconds
+    Tick cooldown = manager.getTimers().toTicks(SkillDatabase::instance().getSkill(1)->getCooldown());
+    EXPECT_FLOAT_EQ(character->getSkillCooldown(1), static_cast<float>(cooldown) / manager.getTimers().getTickRate());
+
+    manager.updateAll(cooldown - 1);
+    EXPECT_FALSE(character->useSkill(1));
+    manager.updateAll(cooldown);
+    EXPECT_FLOAT_EQ(character->getSkillCooldown(1), 0.0f);
+    EXPECT_TRUE(character->useSkill(1));
+}
+
+TEST_F(CharacterSkillTest, CharactersShareOneCompiledTree) {
+    SkillTreePtr compiled = CompiledSkillTree::compile(tree);
+    auto first = manager.createActor<Character>("First");
+    auto second = manager.createActor<Character>("Second");
+    first->setSkillTree(compiled);
+    second->setSkillTree(compiled);
+    EXPECT_EQ(first->getSkillTree().get(), second->getSkillTree().get());
+
+    // Skill state is two masks and a byte per skill, not containers
+    EXPECT_LE(sizeof(CompiledSkillTree::SkillLevels), CompiledSkillTree::MAX_SKILLS / 4 + CompiledSkillTree::MAX_SKILLS + 8);
+
+    first->learnSkill(2);
+    EXPECT_TRUE(first->hasSkill(2));
+    EXPECT_FALSE(second->hasSkill(2));
+    EXPECT_EQ(first->getLearnedSkills(), std::vector<SkillId>{2});
+}
+
+TEST_F(CharacterSkillTest, NewTreeKeepsSkillsItAlsoHas) {
+    auto character = manager.createActor<Character>("Hero");
+    character->setSkillTree(CompiledSkillTree::compile(tree));
+    character->learnSkill(1);
+    character->learnSkill(2);
+    character->upgradeSkill(2);
+
+    // Fireball and Heal only: Fireball moves to another index, Slash is dropped
+    SkillTree other;
+    other.addNode({2, {}, {}, 1});
+    other.addNode({3, {}, {}, 1});
+    character->setSkillTree(CompiledSkillTree::compile(other));
+    EXPECT_FALSE(character->hasSkill(1));
+    EXPECT_EQ(character->getSkillLevel(2), 2);
+    EXPECT_EQ(character->getAvailableSkills(), std::vector<SkillId>{3});
+}
+
+TEST_F(CharacterSkillTest, AvailabilityFollowsSkillsAndLevel) {
+    auto character = manager.createActor<Character>("Hero");
+    character->setSkillTree(CompiledSkillTree::compile(SkillDatabase::instance().buildTree()));
+    character->addSkillPoints(10);
+    EXPECT_EQ(character->getAvailableSkills(), (std::vector<SkillId>{1, 2, 3}));
+
+    // Power Strike needs Slash at level 2 and character level 5
+    ASSERT_TRUE(character->learnSkill(1));
+    EXPECT_EQ(character->getAvailableSkills(), (std::vector<SkillId>{2, 3}));
+    ASSERT_TRUE(character->upgradeSkill(1));
+    EXPECT_FALSE(character->canLearnSkill(4));
+
+    character->gainExperience(StatCalculator::experienceForLevel(5));
+    ASSERT_EQ(character->getLevel(), 5);
+    EXPECT_TRUE(character->canLearnSkill(4));
+    EXPECT_EQ(character->getAvailableSkills(), (std::vector<SkillId>{2, 3, 4}));
+
+    ASSERT_TRUE(character->learnSkill(4));
+    EXPECT_FALSE(character->canLearnSkill(4));
+    EXPECT_FALSE(character->canLearnSkill(7));  // Berserk: character level 10
+}
+
+TEST(CompiledSkillTreeTest, IndicesFollowPrerequisites) {
+    SkillDatabase& db = SkillDatabase::instance();
+    db.clear();
+    for (SkillId id : {5u, 7u, 12u, 40u}) db.registerSkill(Skill(id, "Skill"));
+
+    // 5 needs 40 needs 7; 12 has nothing to wait for
+    SkillTree tree;
+    tree.addNode({40, {7}, {5}, 2});
+    tree.addNode({7, {}, {40}, 1});
+    tree.addNode({12, {}, {}, 1});
+    tree.addNode({5, {40}, {}, 3});
+    SkillTreePtr compiled = CompiledSkillTree::compile(tree);
+    ASSERT_TRUE(compiled);
+    EXPECT_EQ(compiled->size(), 4u);
+    EXPECT_EQ(compiled->indexOf(7), 0);
+    EXPECT_EQ(compiled->indexOf(12), 1);
+    EXPECT_EQ(compiled->indexOf(40), 2);
+    EXPECT_EQ(compiled->indexOf(5), 3);
+    EXPECT_EQ(compiled->indexOf(8), CompiledSkillTree::NO_INDEX);
+    EXPECT_EQ(compiled->indexOf(100000), CompiledSkillTree::NO_INDEX);
+    EXPECT_EQ(compiled->skillId(2), 40u);
+    EXPECT_EQ(compiled->getMaxTier(), 3);
+
+    SkillTree cycle;
+    cycle.addNode({5, {7}, {}, 1});
+    cycle.addNode({7, {5}, {}, 1});
+    EXPECT_FALSE(CompiledSkillTree::compile(cycle));
+
+    SkillTree huge;
+    for (SkillId id = 1; id <= CompiledSkillTree::MAX_SKILLS + 1; id++) {
+        huge.addNode({id, {}, {}, 1});
+    }
+    EXPECT_FALSE(CompiledSkillTree::compile(huge));
+    db.clear();
+}
+
+namespace {
+
+// A wide tree of `count` skills: each past the first 16 needs two earlier
+// ones, one of them at level 2, and a character level that rises with id
+SkillTree buildWideTree(SkillId count) {
+    SkillDatabase& db = SkillDatabase::instance();
+    db.clear();
+    SkillTree tree;
+    for (SkillId id = 1; id <= count; id++) {
+        SkillRequirement requirement;
+        requirement.requiredCharLevel = 1 + static_cast<int32_t>(id / 16);
+        SkillNode node{id, {}, {}, 1 + static_cast<int32_t>(id / 16)};
+        if (id > 16) {
+            node.prerequisites = {id - 16, id - 16 + (id % 7) + 1};
+            requirement.prerequisiteSkill = id - 16;
+            requirement.prerequisiteLevel = 2;
+        }
+        db.registerSkill(Skill(id, "Skill").withMaxLevel(5).withRequirement(requirement));
+        tree.addNode(std::move(node));
+    }
+    return tree;
+}
+
+} // namespace
+
+TEST(CompiledSkillTreeTest, IncrementalAvailabilityMatchesRecompute) {
+    SkillTreePtr compiled = CompiledSkillTree::compile(buildWideTree(200));
+    ASSERT_TRUE(compiled);
+
+    CompiledSkillTree::SkillLevels levels;
+    compiled->refresh(levels, 1);
+    uint32_t seed = 12345;
+    auto next = [&seed] { seed = seed * 1103515245u + 12345u; return seed >> 8; };
+
+    for (int step = 0; step < 2000; step++) {
+        uint32_t roll = next();
+        if (roll % 10 == 0) {
+            compiled->setCharacterLevel(levels, 1 + static_cast<int32_t>(next() % 16));
+        } else {
+            auto index = static_cast<CompiledSkillTree::SkillIndex>(next() % compiled->size());
+            if (compiled->canLearn(index, levels)) {
+                compiled->learn(levels, index);
+            } else if (levels.has(index) && levels.level[index] < 5) {
+                compiled->upgrade(levels, index);
+            }
+        }
+        CompiledSkillTree::SkillLevels full = levels;
+        compiled->refresh(full, levels.characterLevel);
+        ASSERT_EQ(compiled->getAvailableSkills(levels), compiled->getAvailableSkills(full)) << "step " << step;
+    }
+    SkillDatabase::instance().clear();
+}
+
+// Skill UI and validation on a 256-node tree: the SkillTree scans (hash
+// sets, database lookups per node) vs the character's available set
+TEST(CompiledSkillTreeTest, DISABLED_AvailabilityBenchmark) {
+    using Clock = std::chrono::steady_clock;
+    constexpr int QUERIES = 20000;
+    SkillTree tree = buildWideTree(CompiledSkillTree::MAX_SKILLS);
+    ActorManager manager;
+    auto character = manager.createActor<Character>("Hero");
+    character->setSkillTree(CompiledSkillTree::compile(tree));
+    character->addSkillPoints(1000);
+    character->gainExperience(StatCalculator::experienceForLevel(8));
+
+    std::unordered_set<SkillId> learned;
+    std::unordered_map<SkillId, int32_t> skillLevels;
+    for (SkillId id = 1; id <= 96; id++) {
+        if (character->learnSkill(id)) {
+            character->upgradeSkill(id);
+            learned.insert(id);
+            skillLevels[id] = 2;
+        }
+    }
+    ASSERT_FALSE(learned.empty());
+
+    size_t scanCount = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < QUERIES; i++) {
+        scanCount += tree.getAvailableSkills(learned, character->getLevel()).size();
+        SkillId id = 1 + i % CompiledSkillTree::MAX_SKILLS;
+        scanCount += !learned.count(id) && tree.canLearn(id, learned, skillLevels, character->getLevel());
+    }
+    auto scanTime = Clock::now() - start;
+
+    size_t setCount = 0;
+    start = Clock::now();
+    for (int i = 0; i < QUERIES; i++) {
+        setCount += character->getAvailableSkills().size();
+        setCount += character->canLearnSkill(1 + i % CompiledSkillTree::MAX_SKILLS);
+    }
+    auto setTime = Clock::now() - start;
+    EXPECT_EQ(setCount, scanCount);
+
+    auto perQuery = [](Clock::duration elapsed) {
+        return std::chrono::duration<double, std::nano>(elapsed).count() / QUERIES;
+    };
+    std::cout << "Available skills + canLearn (" << CompiledSkillTree::MAX_SKILLS << " nodes): tree scan "
+              << perQuery(scanTime) << " ns, available set " << perQuery(setTime) << " ns" << std::endl;
+    SkillDatabase::instance().clear();
+}
@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 #include "actors/Stats.hpp"
+#include "actors/StatModifiers.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
 
 using namespace mmorpg;
 
@@ -96,3 +102,128 @@ TEST_F(StatsTest, HighLevelStatsScaling) {
     EXPECT_GT(derivedLevel50.maxHp, derivedLevel1.maxHp);
     EXPECT_GT(derivedLevel50.maxMp, derivedLevel1.maxMp);
 }
+
+// Random stats, including negative values (debuffs) so '/ 2' truncation
+// toward zero is exercised, and odd counts so every kernel hits its tail
+static void randomActors(size_t count, std::vector<PrimaryStats>& primary, std::vector<int32_t>& levels) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int32_t> stat(-50, 400);
+    std::uniform_int_distribution<int32_t> level(-3, 200);
+    primary.resize(count);
+    levels.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        primary[i] = {stat(rng), stat(rng), stat(rng), stat(rng), stat(rng), stat(rng)};
+        levels[i] = level(rng);
+    }
+}
+
+TEST_F(StatsTest, BatchKernelsMatchScalarBitForBit) {
+    constexpr size_t COUNT = 1003;
+    std::vector<PrimaryStats> primary;
+    std::vector<int32_t> levels;
+    randomActors(COUNT, primary, levels);
+
+    std::vector<DerivedStats> expected(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        expected[i] = StatCalculator::calculate(primary[i], levels[i]);
+    }
+
+    for (auto kernel : {StatKernel::Scalar, StatKernel::Sse41, StatKernel::Avx2}) {
+        if (!StatCalculator::isKernelSupported(kernel)) continue;
+        std::vector<DerivedStats> batch(COUNT);
+        StatCalculator::calculateBatch(kernel, primary.data(), levels.data(), batch.data(), COUNT);
+        for (size_t i = 0; i < COUNT; i++) {
+            ASSERT_EQ(std::memcmp(&batch[i], &expected[i], sizeof(DerivedStats)), 0)
+                << StatCalculator::kernelName(kernel) << " differs at actor " << i;
+        }
+    }
+}
+
+TEST_F(StatsTest, DISABLED_BatchRecalculationBenchmark) {
+    constexpr size_t ACTORS = 100000;
+    constexpr int ROUNDS = 10;
+    using Clock = std::chrono::steady_clock;
+    std::vector<PrimaryStats> primary;
+    std::vector<int32_t> levels;
+    randomActors(ACTORS, primary, levels);
+    std::vector<DerivedStats> out(ACTORS);
+
+    auto nsPerActor = [&](StatKernel kernel) {
+        auto start = Clock::now();
+        for (int round = 0; round < ROUNDS; round++) {
+            StatCalculator::calculateBatch(kernel, primary.data(), levels.data(), out.data(), ACTORS);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+        return static_cast<double>(elapsed.count()) / (ACTORS * ROUNDS);
+    };
+
+    std::cout << "Derived stats for " << ACTORS << " actors, per actor:";
+    for (auto kernel : {StatKernel::Scalar, StatKernel::Sse41, StatKernel::Avx2}) {
+        if (StatCalculator::isKernelSupported(kernel)) {
+            std::cout << " " << StatCalculator::kernelName(kernel) << " " << nsPerActor(kernel) << " ns";
+        }
+    }
+    std::cout << " (selected: " << StatCalculator::kernelName(StatCalculator::getBatchKernel()) << ")" << std::endl;
+}
+
+TEST_F(StatsTest, PrimaryStatIndexing) {
+    PrimaryStats stats;
+    stats[PrimaryStat::Wisdom] = 42;
+    EXPECT_EQ(stats.wisdom, 42);
+    EXPECT_EQ(stats[PrimaryStat::Luck], 10);
+
+    PrimaryStat stat = PrimaryStat::Strength;
+    EXPECT_TRUE(parsePrimaryStat("intelligence", stat));
+    EXPECT_EQ(stat, PrimaryStat::Intelligence);
+    EXPECT_STREQ(primaryStatName(stat), "intelligence");
+    EXPECT_FALSE(parsePrimaryStat("charisma", stat));
+}
+
+TEST_F(StatsTest, PartialRecalculationMatchesFull) {
+    // Recomputing only the fields a change affects must give the same
+    // result as a full recalculation, for every stat and for level
+    PrimaryStats before;
+    DerivedStats derived = StatCalculator::calculate(before, 5);
+
+    for (size_t s = 0; s < PRIMARY_STAT_COUNT; s++) {
+        auto stat = static_cast<PrimaryStat>(s);
+        PrimaryStats after = before;
+        after[stat] += 37;
+
+        DerivedStats partial = derived;
+        StatCalculator::calculateFields(after, 5, StatCalculator::affectedFields(statBit(stat)), partial);
+        DerivedStats full = StatCalculator::calculate(after, 5);
+        EXPECT_EQ(std::memcmp(&partial, &full, sizeof(DerivedStats)), 0) << primaryStatName(stat);
+    }
+
+    DerivedStats partial = derived;
+    StatCalculator::calculateFields(before, 9, StatCalculator::affectedFields(LEVEL_CHANGED), partial);
+    DerivedStats full = StatCalculator::calculate(before, 9);
+    EXPECT_EQ(std::memcmp(&partial, &full, sizeof(DerivedStats)), 0) << "level";
+}
+
+TEST_F(StatsTest, ModifierStackAggregates) {
+    StatModifierStack stack;
+    auto buff = StatModifierStack::nextId();
+    auto debuff = StatModifierStack::nextId();
+    auto ring = StatModifierStack::nextId();
+    stack.add(buff, {PrimaryStat::Strength, 20, 0.5f, 7});
+    stack.add(debuff, {PrimaryStat::Strength, -5, -0.2f, 8});
+    stack.add(ring, {PrimaryStat::Luck, 3, 0.0f, 9});
+
+    EXPECT_EQ(stack.getFlatTotal(PrimaryStat::Strength), 15);
+    EXPECT_FLOAT_EQ(stack.getPercentTotal(PrimaryStat::Strength), 0.3f);
+    PrimaryStats effective = stack.apply(defaultStats);
+    EXPECT_EQ(effective.strength, static_cast<int32_t>((10 + 15) * 1.3f));
+    EXPECT_EQ(effective.luck, 13);
+    EXPECT_EQ(effective.agility, 10);
+
+    EXPECT_EQ(stack.remove(debuff), statBit(PrimaryStat::Strength));
+    EXPECT_EQ(stack.remove(debuff), 0u);
+    EXPECT_EQ(stack.apply(PrimaryStat::Strength, 10), 45);  // (10 + 20) * 1.5
+
+    EXPECT_EQ(stack.removeBySource(7), statBit(PrimaryStat::Strength));
+    EXPECT_EQ(stack.getFlatTotal(PrimaryStat::Strength), 0);
+    EXPECT_EQ(stack.getPercentTotal(PrimaryStat::Strength), 0.0f);  // Re-summed, no residue
+    EXPECT_EQ(stack.size(), 1u);
+}
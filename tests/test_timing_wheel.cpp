@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include "core/TimingWheel.hpp"
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+using namespace mmorpg;
+
+TEST(TimingWheelTest, FiresOnTheDueTick) {
+    TimingWheel wheel;
+    std::vector<Tick> fired;
+    wheel.schedule(3, [&] { fired.push_back(wheel.getCurrentTick()); });
+    wheel.scheduleAt(5, [&] { fired.push_back(wheel.getCurrentTick()); });
+
+    EXPECT_EQ(wheel.advance(2), 0u);
+    EXPECT_TRUE(fired.empty());
+    EXPECT_EQ(wheel.advance(3), 1u);
+    EXPECT_EQ(wheel.advance(10), 1u);
+    EXPECT_EQ(fired, (std::vector<Tick>{3, 5}));
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheelTest, ZeroDelayAndPastTicksFireNextTick) {
+    TimingWheel wheel;
+    wheel.advance(10);
+    int fired = 0;
+    wheel.schedule(0, [&] { fired++; });
+    wheel.scheduleAt(4, [&] { fired++; });
+    EXPECT_EQ(wheel.getExpiry(wheel.schedule(0, [] {})), 11u);
+
+    wheel.advance(11);
+    EXPECT_EQ(fired, 2);
+}
+
+TEST(TimingWheelTest, CancelIsFinal) {
+    TimingWheel wheel;
+    bool fired = false;
+    TimingWheel::TimerId id = wheel.schedule(5, [&] { fired = true; });
+    EXPECT_TRUE(wheel.isPending(id));
+    EXPECT_EQ(wheel.getExpiry(id), 5u);
+
+    EXPECT_TRUE(wheel.cancel(id));
+    EXPECT_FALSE(wheel.cancel(id));
+    EXPECT_FALSE(wheel.isPending(id));
+    EXPECT_EQ(wheel.size(), 0u);
+
+    // The freed node is reused, but the old id doesn't match it
+    TimingWheel::TimerId reused = wheel.schedule(5, [] {});
+    EXPECT_FALSE(wheel.isPending(id));
+    EXPECT_FALSE(wheel.cancel(id));
+    EXPECT_TRUE(wheel.isPending(reused));
+
+    wheel.advance(10);
+    EXPECT_FALSE(fired);
+    EXPECT_FALSE(wheel.isPending(reused));
+    EXPECT_FALSE(wheel.cancel(TimingWheel::INVALID_TIMER));
+}
+
+TEST(TimingWheelTest, CascadesThroughEveryLevel) {
+    TimingWheel wheel;
+    wheel.advance(200);  // Off the level boundaries
+
+    std::vector<Tick> delays = {1, 255, 256, 300, 65535, 65536, 70000, (Tick{1} << 24) + 5};
+    std::vector<Tick> expected;
+    std::vector<Tick> fired;
+    for (Tick delay : delays) {
+        expected.push_back(200 + delay);
+        wheel.schedule(delay, [&] { fired.push_back(wheel.getCurrentTick()); });
+    }
+
+    wheel.advance(200 + delays.back());
+    EXPECT_EQ(fired, expected);
+}
+
+TEST(TimingWheelTest, MatchesReferenceOrder) {
+    // Random schedules and cancels, checked against the exact expiry tick
+    TimingWheel wheel;
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<Tick> delay(0, 100000);
+
+    constexpr size_t COUNT = 5000;
+    std::vector<Tick> due(COUNT, 0);
+    std::vector<Tick> firedAt(COUNT, 0);
+    std::vector<TimingWheel::TimerId> ids(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        // Spread the scheduling over the run so timers start from every offset
+        if (i % 50 == 0) {
+            wheel.advance(wheel.getCurrentTick() + 37);
+        }
+        Tick d = delay(rng);
+        due[i] = wheel.getCurrentTick() + (d > 0 ? d : 1);
+        ids[i] = wheel.schedule(d, [&, i] { firedAt[i] = wheel.getCurrentTick(); });
+    }
+    for (size_t i = 0; i < COUNT; i += 7) {
+        // Short timers from early on may have fired already
+        if (wheel.cancel(ids[i])) {
+            due[i] = 0;
+        }
+    }
+
+    while (!wheel.empty()) {
+        wheel.advance(wheel.getCurrentTick() + 1);
+    }
+    for (size_t i = 0; i < COUNT; i++) {
+        EXPECT_EQ(firedAt[i], due[i]) << "timer " << i;
+    }
+}
+
+TEST(TimingWheelTest, CallbacksRescheduleAndCancel) {
+    TimingWheel wheel;
+    int repeats = 0;
+    std::function<void()> repeat = [&] {
+        if (++repeats < 4) wheel.schedule(2, repeat);
+    };
+    wheel.schedule(2, repeat);
+
+    // Two timers due together; whichever runs first cancels the other
+    TimingWheel::TimerId first = 0;
+    TimingWheel::TimerId second = 0;
+    int pairFired = 0;
+    first = wheel.schedule(3, [&] { pairFired++; wheel.cancel(second); });
+    second = wheel.schedule(3, [&] { pairFired++; wheel.cancel(first); });
+
+    wheel.advance(20);
+    EXPECT_EQ(repeats, 4);
+    EXPECT_EQ(pairFired, 1);
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheelTest, ClearCancelsEverything) {
+    TimingWheel wheel;
+    int fired = 0;
+    TimingWheel::TimerId id = wheel.schedule(1, [&] { fired++; });
+    wheel.schedule(100000, [&] { fired++; });
+    wheel.clear();
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_FALSE(wheel.isPending(id));
+    wheel.advance(200000);
+    EXPECT_EQ(fired, 0);
+    EXPECT_EQ(wheel.getCurrentTick(), 200000u);
+}
+
+TEST(TimingWheelTest, SecondsToTicks) {
+    TimingWheel wheel(20);
+    EXPECT_EQ(wheel.toTicks(0.0f), 0u);
+    EXPECT_EQ(wheel.toTicks(0.01f), 1u);
+    EXPECT_EQ(wheel.toTicks(1.0f), 20u);
+    EXPECT_EQ(wheel.toTicks(2.5f), 50u);
+    EXPECT_EQ(wheel.toTicks(0.1f), 2u);
+    wheel.setTickRate(0);
+    EXPECT_EQ(wheel.getTickRate(), 1u);
+}
+
+// Cooldown-style churn: most timers are cancelled or replaced before
+// they fire. Compared with a binary heap using lazy cancellation.
+TEST(TimingWheelBenchmark, DISABLED_ScheduleCancelExpire) {
+    using Clock = std::chrono::steady_clock;
+    constexpr size_t PER_TICK = 2000;
+    constexpr Tick TICKS = 500;
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<Tick> delay(1, 600);
+    std::vector<Tick> delays(PER_TICK * TICKS);
+    for (Tick& d : delays) d = delay(rng);
+
+    uint64_t wheelFired = 0;
+    auto start = Clock::now();
+    {
+        TimingWheel wheel;
+        std::vector<TimingWheel::TimerId> live;
+        size_t next = 0;
+        for (Tick tick = 1; tick <= TICKS; tick++) {
+            live.clear();
+            for (size_t i = 0; i < PER_TICK; i++) {
+                live.push_back(wheel.schedule(delays[next++], [&wheelFired] { wheelFired++; }));
+            }
+            for (size_t i = 0; i < live.size(); i += 2) {
+                wheel.cancel(live[i]);
+            }
+            wheel.advance(tick);
+        }
+        wheel.advance(TICKS + 601);
+    }
+    auto wheelTime = Clock::now() - start;
+
+    uint64_t heapFired = 0;
+    start = Clock::now();
+    {
+        struct Entry {
+            Tick when;
+            uint64_t id;
+            std::function<void()> callback;
+            bool operator>(const Entry& other) const { return when > other.when; }
+        };
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+        std::unordered_set<uint64_t> cancelled;
+        std::vector<uint64_t> live;
+        uint64_t nextId = 1;
+        size_t next = 0;
+        auto advance = [&](Tick now) {
+            while (!heap.empty() && heap.top().when <= now) {
+                Entry entry = std::move(const_cast<Entry&>(heap.top()));
+                heap.pop();
+                if (cancelled.erase(entry.id) == 0) entry.callback();
+            }
+        };
+        for (Tick tick = 1; tick <= TICKS; tick++) {
+            live.clear();
+            for (size_t i = 0; i < PER_TICK; i++) {
+                live.push_back(nextId);
+                heap.push({tick - 1 + delays[next++], nextId++, [&heapFired] { heapFired++; }});
+            }
+            for (size_t i = 0; i < live.size(); i += 2) {
+                cancelled.insert(live[i]);
+            }
+            advance(tick);
+        }
+        advance(TICKS + 601);
+    }
+    auto heapTime = Clock::now() - start;
+
+    EXPECT_EQ(wheelFired, PER_TICK * TICKS / 2);
+    EXPECT_EQ(heapFired, wheelFired);
+
+    double ops = static_cast<double>(PER_TICK * TICKS);
+    std::cout << "Timers (" << PER_TICK << "/tick, half cancelled): wheel "
+              << std::chrono::duration<double, std::nano>(wheelTime).count() / ops << " ns/timer, heap "
+              << std::chrono::duration<double, std::nano>(heapTime).count() / ops << " ns/timer" << std::endl;
+}
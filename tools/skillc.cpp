@@ -0,0 +1,57 @@
+// Skill data compiler: turns a JSON skill definition file into the binary
+// snapshot the server maps at startup (game.skill_data = "<file>.bin").
+#include "skills/SkillDatabase.hpp"
+#include "core/Logger.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " <skills.json> <skills.bin> [options]\n"
+              << "Options:\n"
+              << "  -t, --tick-rate <n>  Ticks per second for precomputed cooldowns (default 20)\n"
+              << "  -h, --help           Show this help message\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string input;
+    std::string output;
+    uint32_t tickRate = 20;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--tick-rate") == 0) {
+            if (i + 1 < argc) {
+                tickRate = static_cast<uint32_t>(std::atoi(argv[++i]));
+            }
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (input.empty()) {
+            input = argv[i];
+        } else if (output.empty()) {
+            output = argv[i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (input.empty() || output.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    mmorpg::SkillDatabase& db = mmorpg::SkillDatabase::instance();
+    db.setTickRate(tickRate);
+    if (!db.loadDefinitions(input) || !db.saveSnapshot(output)) {
+        return 1;
+    }
+
+    // Read it back the way the server will
+    if (!db.loadSnapshot(output)) {
+        return 1;
+    }
+    LOG_INFO("Wrote " << output << ": " << db.getSkillCount() << " skills, "
+             << db.getTreeNodeCount() << " tree nodes");
+    return 0;
+}